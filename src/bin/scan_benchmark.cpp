@@ -0,0 +1,141 @@
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "operators/pipeline.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "storage/table.hpp"
+#include "types.hpp"
+
+using namespace opossum;  // NOLINT
+
+// Measures the throughput of TableScan on an int32 column for different selectivities. The scans run on the table
+// itself and, as the second scan of a filter chain, on the reference segments produced by a scan on a second column
+// with a selectivity of 50 %. A chain of three scans is also executed table at a time, as a Pipeline of morsels, and
+// as a Pipeline of vector-at-a-time batches. Usage:
+//   hyriseScanBenchmark [row_count] [chunk_size]
+// Build in Release mode for meaningful numbers.
+
+namespace {
+
+constexpr auto REPETITIONS = 10;
+constexpr auto VALUE_RANGE = int32_t{1'000};
+
+std::shared_ptr<Table> create_table(const size_t row_count, const ChunkOffset chunk_size) {
+  auto table = std::make_shared<Table>(chunk_size);
+  table->add_column("a", "int");
+  table->add_column("b", "int");
+
+  auto generator = std::mt19937{42};
+  auto distribution = std::uniform_int_distribution<int32_t>{0, VALUE_RANGE - 1};
+  for (auto row = size_t{0}; row < row_count; ++row) {
+    table->append({distribution(generator), distribution(generator)});
+  }
+  return table;
+}
+
+void run_scans(const std::string& name, const std::shared_ptr<const AbstractOperator>& input) {
+  const auto row_count = static_cast<double>(input->get_output()->row_count());
+
+  for (const auto selectivity : {0.01, 0.5, 0.99}) {
+    const auto search_value = static_cast<int32_t>(VALUE_RANGE * selectivity);
+    auto best_duration = std::chrono::nanoseconds::max();
+    auto result_row_count = ChunkOffset{0};
+
+    for (auto repetition = 0; repetition < REPETITIONS; ++repetition) {
+      auto table_scan = std::make_shared<TableScan>(input, ColumnID{0}, ScanType::OpLessThan, search_value);
+      const auto begin = std::chrono::steady_clock::now();
+      table_scan->execute();
+      const auto duration = std::chrono::steady_clock::now() - begin;
+      best_duration = std::min(best_duration, std::chrono::duration_cast<std::chrono::nanoseconds>(duration));
+      result_row_count = table_scan->get_output()->row_count();
+    }
+
+    const auto seconds = static_cast<double>(best_duration.count()) / 1e9;
+    std::cout << std::fixed << std::setprecision(2) << std::setw(22) << name << " selectivity " << selectivity << ": "
+              << std::setw(10) << result_row_count << " rows in " << std::setw(8) << std::setprecision(3)
+              << seconds * 1e3 << " ms, " << std::setw(8) << row_count / seconds / 1e6 << " M rows/s, " << std::setw(6)
+              << row_count * sizeof(int32_t) / seconds / 1e9 << " GB/s input" << std::endl;
+  }
+}
+
+void run_scans(const std::string& name, const std::shared_ptr<Table>& table) {
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+  run_scans(name, table_wrapper);
+
+  auto first_scan = std::make_shared<TableScan>(table_wrapper, ColumnID{1}, ScanType::OpLessThan, VALUE_RANGE / 2);
+  first_scan->execute();
+  run_scans(name + " (referenced)", first_scan);
+}
+
+// Executes a chain of three scans with a combined selectivity of about 12.5 % table at a time and pipelined.
+void run_filter_chain(const std::string& name, const std::shared_ptr<Table>& table) {
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+  const auto create_scans = [&]() {
+    const auto scan_a = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, ScanType::OpLessThan, VALUE_RANGE / 2);
+    const auto scan_b = std::make_shared<TableScan>(scan_a, ColumnID{1}, ScanType::OpLessThan, VALUE_RANGE / 2);
+    const auto scan_c =
+        std::make_shared<TableScan>(scan_b, ColumnID{0}, ScanType::OpGreaterThanEquals, VALUE_RANGE / 4);
+    return std::vector<std::shared_ptr<AbstractPipelineOperator>>{scan_a, scan_b, scan_c};
+  };
+
+  const auto modes = std::vector<std::pair<std::string, std::optional<Pipeline::Mode>>>{
+      {" chain, table at a time:", std::nullopt},
+      {" chain, morsels:        ", Pipeline::Mode::Morsels},
+      {" chain, batches:        ", Pipeline::Mode::Batches}};
+  for (const auto& [mode_name, mode] : modes) {
+    auto best_duration = std::chrono::nanoseconds::max();
+    auto result_row_count = ChunkOffset{0};
+    for (auto repetition = 0; repetition < REPETITIONS; ++repetition) {
+      const auto scans = create_scans();
+      const auto begin = std::chrono::steady_clock::now();
+      if (mode) {
+        std::make_shared<Pipeline>(scans, Pipeline::DEFAULT_MORSEL_SIZE, *mode)->execute();
+      } else {
+        for (const auto& scan : scans) {
+          scan->execute();
+        }
+      }
+      const auto duration = std::chrono::steady_clock::now() - begin;
+      best_duration = std::min(best_duration, std::chrono::duration_cast<std::chrono::nanoseconds>(duration));
+      result_row_count = scans.back()->get_output()->row_count();
+    }
+
+    const auto seconds = static_cast<double>(best_duration.count()) / 1e9;
+    std::cout << std::fixed << std::setw(22) << name << mode_name << std::setw(10) << result_row_count << " rows in "
+              << std::setw(8) << std::setprecision(3) << seconds * 1e3 << " ms" << std::endl;
+  }
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  const auto row_count = argc > 1 ? std::stoul(argv[1]) : size_t{10'000'000};
+  const auto chunk_size = argc > 2 ? static_cast<ChunkOffset>(std::stoul(argv[2])) : ChunkOffset{100'000};
+
+  auto table = create_table(row_count, chunk_size);
+  run_scans("value", table);
+  run_filter_chain("value", table);
+
+  const auto begin = std::chrono::steady_clock::now();
+  for (auto chunk_id = ChunkID{0}; chunk_id < table->chunk_count(); ++chunk_id) {
+    table->compress_chunk(chunk_id);
+  }
+  const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+  std::cout << std::fixed << std::setprecision(3) << "dictionary encoding: " << seconds * 1e3 << " ms, "
+            << std::setprecision(2) << row_count / seconds / 1e6 << " M rows/s" << std::endl;
+  run_scans("dictionary", table);
+  run_filter_chain("dictionary", table);
+
+  return 0;
+}
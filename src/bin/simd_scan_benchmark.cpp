@@ -0,0 +1,75 @@
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "operators/simd_scan_kernels.hpp"
+#include "types.hpp"
+
+using namespace opossum;  // NOLINT
+
+// Compares the throughput of the scalar, AVX2, and AVX-512 scan kernels for each supported value width. Usage:
+//   hyriseSimdScanBenchmark [value_count]
+// Build in Release mode for meaningful numbers. Note that with -march=native, the compiler may already vectorize the
+// scalar kernel for the build host.
+
+namespace {
+
+constexpr auto REPETITIONS = 20;
+
+template <typename T>
+void benchmark_type(const std::string& name, const size_t value_count) {
+  // Uniformly distributed values in [0, 100), searched with a selectivity of roughly 50 %.
+  auto generator = std::mt19937{42};
+  auto distribution = std::uniform_int_distribution<int32_t>{0, 99};
+  auto values = std::vector<T>(value_count);
+  for (auto& value : values) {
+    value = static_cast<T>(distribution(generator));
+  }
+
+  auto simd_levels = std::vector<SimdLevel>{SimdLevel::Scalar};
+  if (detected_simd_level() >= SimdLevel::AVX2) simd_levels.push_back(SimdLevel::AVX2);
+  if (detected_simd_level() >= SimdLevel::AVX512) simd_levels.push_back(SimdLevel::AVX512);
+
+  auto bitmask = std::vector<uint64_t>(bitmask_word_count(value_count));
+  auto scalar_seconds = 0.0;
+  for (const auto simd_level : simd_levels) {
+    auto best_duration = std::chrono::nanoseconds::max();
+    for (auto repetition = 0; repetition < REPETITIONS; ++repetition) {
+      const auto begin = std::chrono::steady_clock::now();
+      compare_to_bitmask(values.data(), value_count, ScanType::OpLessThan, static_cast<T>(50), bitmask.data(),
+                         simd_level);
+      const auto duration = std::chrono::steady_clock::now() - begin;
+      best_duration = std::min(best_duration, std::chrono::duration_cast<std::chrono::nanoseconds>(duration));
+    }
+
+    const auto seconds = static_cast<double>(best_duration.count()) / 1e9;
+    if (simd_level == SimdLevel::Scalar) scalar_seconds = seconds;
+
+    const auto level_names = std::vector<std::string>{"scalar", "avx2", "avx512"};
+    std::cout << std::fixed << std::setprecision(2) << std::setw(8) << name << std::setw(8)
+              << level_names[static_cast<size_t>(simd_level)] << ": " << std::setw(9)
+              << static_cast<double>(value_count) / seconds / 1e6 << " M values/s, " << std::setw(6)
+              << static_cast<double>(value_count * sizeof(T)) / seconds / 1e9 << " GB/s, speedup " << std::setw(5)
+              << scalar_seconds / seconds << "x" << std::endl;
+  }
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  const auto value_count = argc > 1 ? std::stoul(argv[1]) : size_t{16'000'000};
+
+  benchmark_type<uint8_t>("uint8", value_count);
+  benchmark_type<uint16_t>("uint16", value_count);
+  benchmark_type<uint32_t>("uint32", value_count);
+  benchmark_type<int32_t>("int32", value_count);
+  benchmark_type<int64_t>("int64", value_count);
+  benchmark_type<float>("float", value_count);
+  benchmark_type<double>("double", value_count);
+
+  return 0;
+}
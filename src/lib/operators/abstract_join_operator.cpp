@@ -0,0 +1,50 @@
+#include "abstract_join_operator.hpp"
+
+#include <memory>
+#include <vector>
+
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+AbstractJoinOperator::AbstractJoinOperator(const std::shared_ptr<const AbstractOperator>& left,
+                                           const std::shared_ptr<const AbstractOperator>& right,
+                                           const ColumnID left_column_id, const ColumnID right_column_id,
+                                           const ScanType scan_type)
+    : AbstractOperator{left, right},
+      _left_column_id{left_column_id},
+      _right_column_id{right_column_id},
+      _scan_type{scan_type} {}
+
+ColumnID AbstractJoinOperator::left_column_id() const { return _left_column_id; }
+
+ColumnID AbstractJoinOperator::right_column_id() const { return _right_column_id; }
+
+ScanType AbstractJoinOperator::scan_type() const { return _scan_type; }
+
+std::shared_ptr<const Table> AbstractJoinOperator::_build_output_table(
+    const std::vector<std::shared_ptr<const PosList>>& left_pos_lists,
+    const std::vector<std::shared_ptr<const PosList>>& right_pos_lists) const {
+  DebugAssert(left_pos_lists.size() == right_pos_lists.size(), "Each output chunk needs positions of both inputs");
+  const auto left_table = _left_input_table();
+  const auto right_table = _right_input_table();
+
+  auto column_definitions = std::make_shared<Table>();
+  for (const auto& table : {left_table, right_table}) {
+    for (auto column_id = ColumnID{0}; column_id < table->column_count(); ++column_id) {
+      column_definitions->add_column_definition(table->column_name(column_id), table->column_type(column_id));
+    }
+  }
+
+  auto output_chunks = std::vector<std::shared_ptr<Chunk>>(left_pos_lists.size());
+  for (auto& output_chunk : output_chunks) {
+    output_chunk = std::make_shared<Chunk>();
+  }
+  _append_reference_segments(left_table, left_pos_lists, output_chunks);
+  _append_reference_segments(right_table, right_pos_lists, output_chunks);
+
+  if (output_chunks.empty()) return std::make_shared<Table>(column_definitions);
+  return std::make_shared<Table>(output_chunks, column_definitions);
+}
+
+}  // namespace opossum
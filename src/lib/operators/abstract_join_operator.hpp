@@ -0,0 +1,41 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "abstract_operator.hpp"
+#include "storage/pos_list.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+// AbstractJoinOperator is the abstract super class of the join operators. An (inner) join combines each row of the
+// left input with each row of the right input whose values in the join columns satisfy the scan type, i.e.,
+// "left value <scan_type> right value". Both join columns must have the same data type.
+//
+// The output has the columns of the left input followed by those of the right input. All its segments are
+// ReferenceSegments. If an input consists of reference segments itself, the output points to the tables that these
+// segments reference, like the output of a TableScan does.
+class AbstractJoinOperator : public AbstractOperator {
+ public:
+  AbstractJoinOperator(const std::shared_ptr<const AbstractOperator>& left,
+                       const std::shared_ptr<const AbstractOperator>& right, const ColumnID left_column_id,
+                       const ColumnID right_column_id, const ScanType scan_type);
+
+  ColumnID left_column_id() const;
+  ColumnID right_column_id() const;
+  ScanType scan_type() const;
+
+ protected:
+  // Creates the output table. The i-th output chunk joins the rows at the positions left_pos_lists[i] of the left
+  // input table with those at right_pos_lists[i] of the right input table.
+  std::shared_ptr<const Table> _build_output_table(
+      const std::vector<std::shared_ptr<const PosList>>& left_pos_lists,
+      const std::vector<std::shared_ptr<const PosList>>& right_pos_lists) const;
+
+  const ColumnID _left_column_id;
+  const ColumnID _right_column_id;
+  const ScanType _scan_type;
+};
+
+}  // namespace opossum
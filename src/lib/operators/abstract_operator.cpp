@@ -1,5 +1,13 @@
 #include "abstract_operator.hpp"
 
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "scheduler/worker_pool.hpp"
+#include "storage/reference_segment.hpp"
+#include "utils/assert.hpp"
+
 namespace opossum {
 
 AbstractOperator::AbstractOperator(const std::shared_ptr<const AbstractOperator> left,
@@ -13,8 +21,68 @@ std::shared_ptr<const Table> AbstractOperator::get_output() const {
   return _output;
 }
 
+std::shared_ptr<const AbstractOperator> AbstractOperator::left_input() const { return _left_input; }
+
+std::shared_ptr<const AbstractOperator> AbstractOperator::right_input() const { return _right_input; }
+
 std::shared_ptr<const Table> AbstractOperator::_left_input_table() const { return _left_input->get_output(); }
 
 std::shared_ptr<const Table> AbstractOperator::_right_input_table() const { return _right_input->get_output(); }
 
+void AbstractOperator::_append_reference_segments(const std::shared_ptr<const Table>& input_table,
+                                                  const std::vector<std::shared_ptr<const PosList>>& pos_lists,
+                                                  std::vector<std::shared_ptr<Chunk>>& output_chunks) {
+  const auto n_chunks = input_table->chunk_count();
+
+  // columns whose reference segments share their position lists in all
+  // input chunks also share the resolved position lists.
+  auto resolved_pos_lists = std::map<std::vector<const PosList*>, std::vector<std::shared_ptr<const PosList>>>{};
+
+  for (auto column_id = ColumnID{0}; column_id < input_table->column_count(); ++column_id) {
+    const auto first_reference_segment =
+        n_chunks == 0 ? nullptr
+                      : std::dynamic_pointer_cast<const ReferenceSegment>(
+                            input_table->get_chunk(ChunkID{0})->get_segment(column_id));
+    if (!first_reference_segment) {
+      for (auto output_chunk_index = size_t{0}; output_chunk_index < output_chunks.size(); ++output_chunk_index) {
+        output_chunks[output_chunk_index]->add_segment(
+            std::make_shared<ReferenceSegment>(input_table, column_id, pos_lists[output_chunk_index]));
+      }
+      continue;
+    }
+
+    // the input positions are replaced by the positions that the input
+    // reference segments hold at these positions.
+    const auto referenced_table = first_reference_segment->referenced_table();
+    const auto referenced_column_id = first_reference_segment->referenced_column_id();
+    auto input_pos_lists = std::vector<const PosList*>(n_chunks);
+    for (auto chunk_id = ChunkID{0}; chunk_id < n_chunks; ++chunk_id) {
+      const auto reference_segment =
+          std::dynamic_pointer_cast<const ReferenceSegment>(input_table->get_chunk(chunk_id)->get_segment(column_id));
+      Assert(reference_segment && reference_segment->referenced_table() == referenced_table,
+             "All segments of a column must reference the same table");
+      input_pos_lists[chunk_id] = reference_segment->pos_list().get();
+    }
+
+    auto& column_pos_lists = resolved_pos_lists[input_pos_lists];
+    if (column_pos_lists.empty()) {
+      column_pos_lists.resize(output_chunks.size());
+      WorkerPool::get().parallel_for(output_chunks.size(), [&](const size_t output_chunk_index) {
+        const auto& pos_list = *pos_lists[output_chunk_index];
+        auto row_ids = std::vector<RowID>(pos_list.size());
+        for (auto index = size_t{0}; index < pos_list.size(); ++index) {
+          const auto row_id = pos_list[index];
+          row_ids[index] = (*input_pos_lists[row_id.chunk_id])[row_id.chunk_offset];
+        }
+        column_pos_lists[output_chunk_index] = std::make_shared<PosList>(std::move(row_ids));
+      });
+    }
+
+    for (auto output_chunk_index = size_t{0}; output_chunk_index < output_chunks.size(); ++output_chunk_index) {
+      output_chunks[output_chunk_index]->add_segment(std::make_shared<ReferenceSegment>(
+          referenced_table, referenced_column_id, column_pos_lists[output_chunk_index]));
+    }
+  }
+}
+
 }  // namespace opossum
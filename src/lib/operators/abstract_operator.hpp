@@ -3,6 +3,7 @@
 #include <memory>
 #include <string>
 #include <vector>
+#include "storage/pos_list.hpp"
 #include "storage/table.hpp"
 #include "types.hpp"
 
@@ -12,8 +13,8 @@ namespace opossum {
 // output table. Their lifecycle has three phases:
 // 1. The operator is constructed. Previous operators are not guaranteed to have already executed, so operators must not
 // call get_output in their execute method
-// 2. The execute method is called from the outside (usually by the scheduler). This is where the heavy lifting is done.
-// By now, the input operators have already executed.
+// 2. The execute method is called from the outside (usually by the scheduler, see OperatorTask). This is where the
+// heavy lifting is done. By now, the input operators have already executed.
 // 3. The consumer (usually another operator) calls get_output. This should be very cheap. It is only guaranteed to
 // succeed if execute was called before. Otherwise, a nullptr or an empty table could be returned.
 //
@@ -40,6 +41,9 @@ class AbstractOperator : private Noncopyable {
   std::shared_ptr<const AbstractOperator> right_input() const;
 
  protected:
+  // A Pipeline executes several operators at once and sets the output of the last one.
+  friend class Pipeline;
+
   // Abstract method to actually execute the operator execute and get_output are split into two methods to allow for
   // easier asynchronous execution.
   virtual std::shared_ptr<const Table> _on_execute() = 0;
@@ -47,6 +51,13 @@ class AbstractOperator : private Noncopyable {
   std::shared_ptr<const Table> _left_input_table() const;
   std::shared_ptr<const Table> _right_input_table() const;
 
+  // Appends one ReferenceSegment per column of input_table to each output chunk. The segments of the i-th chunk point
+  // to the rows at pos_lists[i] of input_table. If input_table consists of reference segments itself, they point to
+  // the rows that these segments reference instead, so that the output never references another reference table.
+  static void _append_reference_segments(const std::shared_ptr<const Table>& input_table,
+                                         const std::vector<std::shared_ptr<const PosList>>& pos_lists,
+                                         std::vector<std::shared_ptr<Chunk>>& output_chunks);
+
   // Shared pointers to input operators. Can be nullptr, for example, if an operator is the leaf operator in the query
   // plan or if the operator has only one input operator.
   std::shared_ptr<const AbstractOperator> _left_input;
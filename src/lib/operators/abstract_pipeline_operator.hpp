@@ -0,0 +1,43 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "abstract_operator.hpp"
+#include "batch.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+// A range of rows [begin, end) of the chunk chunk_id of the input table of a pipeline. Bit i of the bitmask (see
+// compare_to_bitmask for the layout) is set if the row begin + i is still part of the output of the pipeline. begin is
+// a multiple of 64, so that the bitmasks of consecutive morsels can be concatenated.
+struct Morsel {
+  ChunkID chunk_id;
+  ChunkOffset begin;
+  ChunkOffset end;
+  std::vector<uint64_t> bitmask;
+};
+
+// AbstractPipelineOperator is the abstract super class of operators that decide for each row of their input
+// independently whether it is part of their output, e.g., the TableScan. Besides being executed on their whole input,
+// such operators can be part of a Pipeline, which pushes morsels of rows through several of them without
+// materializing their outputs in between (see Pipeline). A morsel tracks its rows in a bitmask and leaves it to each
+// operator how to read its input, whereas a Batch also carries decoded column vectors from operator to operator.
+//
+// Pipeline operators only have a left input, and their output has the same columns as their input. Thus, a row of
+// any operator of a pipeline can be identified by its position in the input table of the first operator.
+class AbstractPipelineOperator : public AbstractOperator {
+ public:
+  using AbstractOperator::AbstractOperator;
+
+  // Clears the bits of the rows of the morsel that are not part of the output of the operator. table is the input
+  // table of the first operator of the pipeline. Can be called concurrently for different morsels.
+  virtual void process_morsel(const std::shared_ptr<const Table>& table, Morsel& morsel) const = 0;
+
+  // Removes the rows that are not part of the output of the operator from the selection of the batch. Can be called
+  // concurrently for different batches.
+  virtual void process_batch(Batch& batch) const = 0;
+};
+
+}  // namespace opossum
@@ -0,0 +1,723 @@
+#include "aggregate.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "resolve_type.hpp"
+#include "scheduler/worker_pool.hpp"
+#include "storage/dictionary_segment.hpp"
+#include "storage/front_coded_dictionary_segment.hpp"
+#include "storage/run_length_segment.hpp"
+#include "storage/segment_iterate.hpp"
+#include "storage/segment_statistics.hpp"
+#include "storage/table.hpp"
+#include "storage/value_segment.hpp"
+#include "utils/assert.hpp"
+#include "utils/hash_value.hpp"
+
+namespace opossum {
+
+namespace {
+
+// Maps keys to dense ids 0, 1, 2, ... in the order in which they are inserted. The hash table is a flat array of slots
+// that hold the ids of the keys, with open addressing and linear probing. The keys and their hashes are stored in
+// arrays indexed by the ids, so that probing compares the hashes first and growing does not hash the keys again.
+template <typename Key>
+class DenseIdMap {
+ public:
+  explicit DenseIdMap(const size_t expected_key_count) {
+    _slots.resize(std::bit_ceil(std::max(expected_key_count * 2, size_t{16})), EMPTY_SLOT);
+  }
+
+  // Returns the id of the key and inserts it first if it is not contained yet.
+  template <typename K>
+  uint32_t id_of(K&& key, const size_t hash) {
+    const auto slot_mask = _slots.size() - 1;
+    auto slot = hash & slot_mask;
+    while (_slots[slot] != EMPTY_SLOT) {
+      const auto id = _slots[slot];
+      if (_hashes[id] == hash && _keys[id] == key) return id;
+      slot = (slot + 1) & slot_mask;
+    }
+
+    const auto id = static_cast<uint32_t>(_keys.size());
+    _slots[slot] = id;
+    _keys.push_back(std::forward<K>(key));
+    _hashes.push_back(hash);
+    if (_keys.size() * 2 > _slots.size()) {
+      _grow();
+    }
+    return id;
+  }
+
+  size_t size() const { return _keys.size(); }
+
+  std::vector<Key>& keys() { return _keys; }
+
+ private:
+  static constexpr auto EMPTY_SLOT = std::numeric_limits<uint32_t>::max();
+
+  void _grow() {
+    _slots.assign(_slots.size() * 2, EMPTY_SLOT);
+    const auto slot_mask = _slots.size() - 1;
+    for (auto id = uint32_t{0}; id < _keys.size(); ++id) {
+      auto slot = _hashes[id] & slot_mask;
+      while (_slots[slot] != EMPTY_SLOT) {
+        slot = (slot + 1) & slot_mask;
+      }
+      _slots[slot] = id;
+    }
+  }
+
+  std::vector<uint32_t> _slots;
+  std::vector<Key> _keys;
+  std::vector<size_t> _hashes;
+};
+
+// The values of the group by columns of a group are identified by a key that concatenates their binary
+// representations (a length prefix and the characters for strings). Keys of groups of different chunks can thus be
+// compared and hashed without knowing the data types of the columns.
+template <typename T>
+void append_to_key(std::string& key, const T& value) {
+  if constexpr (std::is_same_v<T, std::string>) {
+    const auto size = static_cast<uint32_t>(value.size());
+    key.append(reinterpret_cast<const char*>(&size), sizeof(size));
+    key.append(value);
+  } else {
+    // -0.0 equals 0.0 and must form the same group.
+    auto normalized_value = value;
+    if constexpr (std::is_floating_point_v<T>) {
+      if (value == T{0}) normalized_value = T{0};
+    }
+    key.append(reinterpret_cast<const char*>(&normalized_value), sizeof(T));
+  }
+}
+
+template <typename T>
+T read_from_key(const std::string_view key, size_t& position) {
+  if constexpr (std::is_same_v<T, std::string>) {
+    auto size = uint32_t{0};
+    std::memcpy(&size, key.data() + position, sizeof(size));
+    position += sizeof(size);
+    auto value = std::string{key.substr(position, size)};
+    position += size;
+    return value;
+  } else {
+    auto value = T{};
+    std::memcpy(&value, key.data() + position, sizeof(T));
+    position += sizeof(T);
+    return value;
+  }
+}
+
+// The groups of a chunk. Each row belongs to the group group_ids[row]. Dense group ids of several columns can leave
+// some ids without rows, these groups have a row count of zero and an empty key. The keys of all groups are stored
+// one after the other in key_data. Without group by columns, there is a single group and group_ids is empty.
+struct ChunkGroups {
+  std::vector<uint32_t> group_ids;
+  std::vector<int64_t> row_counts;
+  // the first row of each group.
+  std::vector<ChunkOffset> first_rows;
+  std::string key_data;
+  std::vector<size_t> key_offsets;
+  std::vector<size_t> key_hashes;
+
+  std::string_view key(const size_t group_id) const {
+    return std::string_view{key_data}.substr(key_offsets[group_id], key_offsets[group_id + 1] - key_offsets[group_id]);
+  }
+};
+
+// Dense ids of the values of a group by column of a chunk, and the keys of the values by id.
+struct ColumnCodes {
+  std::vector<uint32_t> codes;
+  std::vector<std::string> code_keys;
+};
+
+template <typename T>
+ColumnCodes encode_column(const std::shared_ptr<const AbstractSegment>& segment) {
+  auto column_codes = ColumnCodes{};
+  auto& codes = column_codes.codes;
+  codes.resize(segment->size());
+
+  // the value ids of dictionary segments are dense ids already.
+  const auto encode_value_ids = [&](const auto& dictionary_segment, const auto& value_of_value_id) {
+    dictionary_segment.attribute_vector()->decode(0, codes.size(), codes.data());
+    column_codes.code_keys.resize(dictionary_segment.unique_values_count());
+    for (auto value_id = ValueID{0}; value_id < column_codes.code_keys.size(); ++value_id) {
+      append_to_key(column_codes.code_keys[value_id], value_of_value_id(value_id));
+    }
+  };
+  if (const auto dictionary_segment = std::dynamic_pointer_cast<const DictionarySegment<T>>(segment)) {
+    const auto& dictionary = dictionary_segment->dictionary();
+    encode_value_ids(*dictionary_segment, [&](const ValueID value_id) -> const T& { return dictionary[value_id]; });
+    return column_codes;
+  }
+  if constexpr (std::is_same_v<T, std::string>) {
+    if (const auto front_coded_segment = std::dynamic_pointer_cast<const FrontCodedDictionarySegment<T>>(segment)) {
+      encode_value_ids(*front_coded_segment,
+                       [&](const ValueID value_id) { return front_coded_segment->value_of_value_id(value_id); });
+      return column_codes;
+    }
+  }
+
+  auto value_ids = DenseIdMap<T>{1'024};
+  segment_iterate<T>(*segment, [&](const auto& position) {
+    const auto& value = position.value();
+    codes[position.chunk_offset()] = value_ids.id_of(value, hash_value(value));
+  });
+  column_codes.code_keys.resize(value_ids.size());
+  for (auto code = size_t{0}; code < value_ids.size(); ++code) {
+    append_to_key(column_codes.code_keys[code], value_ids.keys()[code]);
+  }
+  return column_codes;
+}
+
+// Assigns the rows of a chunk to groups. The codes of the first column are the initial group ids. Each further
+// column combines the group ids with its codes: If the combinations fit into an array as large as the chunk, the
+// combined ids are used directly. Otherwise, they are mapped to dense ids by a hash table.
+ChunkGroups group_chunk(const std::shared_ptr<const Table>& table, const ChunkID chunk_id,
+                        const std::vector<ColumnID>& group_by_column_ids) {
+  const auto chunk = table->get_chunk(chunk_id);
+  const auto row_count = size_t{chunk->size()};
+
+  auto groups = ChunkGroups{};
+  if (group_by_column_ids.empty()) {
+    // all rows form a single group with an empty key, and there are no group
+    // ids to look at.
+    groups.row_counts.assign(row_count > 0 ? 1 : 0, static_cast<int64_t>(row_count));
+    groups.first_rows.assign(groups.row_counts.size(), ChunkOffset{0});
+    groups.key_offsets.assign(groups.row_counts.size() + 1, size_t{0});
+    groups.key_hashes.assign(groups.row_counts.size(), std::hash<std::string_view>{}(std::string_view{}));
+    return groups;
+  }
+
+  auto& group_ids = groups.group_ids;
+  group_ids.resize(row_count);
+  auto group_count = row_count > 0 ? size_t{1} : size_t{0};
+
+  auto column_codes = std::vector<ColumnCodes>{};
+  for (const auto column_id : group_by_column_ids) {
+    resolve_data_type(table->column_type(column_id), [&](auto type) {
+      using Type = typename decltype(type)::type;
+      column_codes.emplace_back(encode_column<Type>(chunk->get_segment(column_id)));
+    });
+    const auto& codes = column_codes.back().codes;
+    const auto code_count = column_codes.back().code_keys.size();
+
+    if (group_count * code_count <= std::max(row_count, size_t{1})) {
+      for (auto row = size_t{0}; row < row_count; ++row) {
+        group_ids[row] = static_cast<uint32_t>(group_ids[row] * code_count + codes[row]);
+      }
+      group_count *= code_count;
+    } else {
+      auto combined_ids = DenseIdMap<uint64_t>{row_count};
+      for (auto row = size_t{0}; row < row_count; ++row) {
+        const auto combined_id = uint64_t{group_ids[row]} * code_count + codes[row];
+        group_ids[row] = combined_ids.id_of(combined_id, hash_value(combined_id));
+      }
+      group_count = combined_ids.size();
+    }
+  }
+
+  groups.row_counts.resize(group_count);
+  groups.first_rows.resize(group_count);
+  for (auto row = ChunkOffset{0}; row < row_count; ++row) {
+    if (groups.row_counts[group_ids[row]]++ == 0) {
+      groups.first_rows[group_ids[row]] = row;
+    }
+  }
+
+  groups.key_offsets.resize(group_count + 1);
+  groups.key_hashes.resize(group_count);
+  for (auto group_id = size_t{0}; group_id < group_count; ++group_id) {
+    if (groups.row_counts[group_id] > 0) {
+      for (const auto& codes : column_codes) {
+        groups.key_data += codes.code_keys[codes.codes[groups.first_rows[group_id]]];
+      }
+    }
+    groups.key_offsets[group_id + 1] = groups.key_data.size();
+    groups.key_hashes[group_id] = std::hash<std::string_view>{}(groups.key(group_id));
+  }
+  return groups;
+}
+
+// The results of an aggregate (except COUNT, which is the row count of the groups) for some groups.
+class BaseAggregateResults {
+ public:
+  virtual ~BaseAggregateResults() = default;
+
+  // Aggregates the values of a column of a chunk into the groups of the chunk.
+  virtual void aggregate(const Chunk& chunk, const ColumnID column_id, const ChunkGroups& groups) = 0;
+
+  // Creates empty results for the same aggregate.
+  virtual std::unique_ptr<BaseAggregateResults> create_empty() const = 0;
+
+  // Combines the groups source_group_ids[i] of source with the groups group_ids[i]. Groups with an id of at least the
+  // current group count are new groups and take the results of source.
+  virtual void merge_groups(const BaseAggregateResults& source, const std::vector<uint32_t>& source_group_ids,
+                            const std::vector<uint32_t>& group_ids) = 0;
+
+  // Creates the output segment. AVG divides the sums by the row counts of the groups.
+  virtual std::shared_ptr<AbstractSegment> create_output_segment(const std::vector<int64_t>& row_counts) = 0;
+};
+
+template <typename T>
+class AggregateResults : public BaseAggregateResults {
+ public:
+  using SumType = std::conditional_t<std::is_integral_v<T>, int64_t, double>;
+
+  explicit AggregateResults(const AggregateFunction function) : _function{function} {}
+
+  void aggregate(const Chunk& chunk, const ColumnID column_id, const ChunkGroups& groups) override {
+    const auto group_count = groups.row_counts.size();
+    if (group_count == 0) return;
+    if (groups.group_ids.empty()) {
+      _aggregate_single_group(chunk, column_id);
+      return;
+    }
+
+    const auto* group_ids = groups.group_ids.data();
+    segment_with_iterators<T>(*chunk.get_segment(column_id), [&](const auto begin, const auto end) {
+      switch (_function) {
+        case AggregateFunction::Min:
+        case AggregateFunction::Max:
+          // each group starts with the value of its first row.
+          _values.resize(group_count);
+          for (auto group_id = size_t{0}; group_id < group_count; ++group_id) {
+            if (groups.row_counts[group_id] == 0) continue;
+            _values[group_id] = (*(begin + groups.first_rows[group_id])).value();
+          }
+          if (_function == AggregateFunction::Min) {
+            std::for_each(begin, end, [&](const auto& position) {
+              auto& value = _values[group_ids[position.chunk_offset()]];
+              if (position.value() < value) value = position.value();
+            });
+          } else {
+            std::for_each(begin, end, [&](const auto& position) {
+              auto& value = _values[group_ids[position.chunk_offset()]];
+              if (value < position.value()) value = position.value();
+            });
+          }
+          break;
+        case AggregateFunction::Sum:
+        case AggregateFunction::Avg:
+          if constexpr (std::is_arithmetic_v<T>) {
+            _sums.resize(group_count);
+            std::for_each(begin, end, [&](const auto& position) {
+              _sums[group_ids[position.chunk_offset()]] += position.value();
+            });
+          } else {
+            Fail("SUM and AVG are not supported for strings");
+          }
+          break;
+        case AggregateFunction::CountDistinct: {
+          auto group_values = std::vector<std::pair<uint32_t, T>>{};
+          group_values.reserve(std::distance(begin, end));
+          std::for_each(begin, end, [&](const auto& position) {
+            group_values.emplace_back(group_ids[position.chunk_offset()], position.value());
+          });
+          std::sort(group_values.begin(), group_values.end());
+          group_values.erase(std::unique(group_values.begin(), group_values.end()), group_values.end());
+          _distinct_values.resize(group_count);
+          for (auto& [group_id, value] : group_values) {
+            _distinct_values[group_id].push_back(std::move(value));
+          }
+        } break;
+        case AggregateFunction::Count:
+          Fail("COUNT does not need values");
+      }
+    });
+  }
+
+  std::unique_ptr<BaseAggregateResults> create_empty() const override {
+    return std::make_unique<AggregateResults<T>>(_function);
+  }
+
+  void merge_groups(const BaseAggregateResults& source, const std::vector<uint32_t>& source_group_ids,
+                    const std::vector<uint32_t>& group_ids) override {
+    const auto& typed_source = static_cast<const AggregateResults<T>&>(source);
+    const auto merge = [&](auto& results, const auto& source_results, const auto& combine) {
+      const auto group_count = results.size();
+      auto new_group_count = group_count;
+      for (const auto group_id : group_ids) {
+        new_group_count = std::max(new_group_count, size_t{group_id} + 1);
+      }
+      results.resize(new_group_count);
+      for (auto index = size_t{0}; index < group_ids.size(); ++index) {
+        const auto group_id = group_ids[index];
+        const auto& source_result = source_results[source_group_ids[index]];
+        results[group_id] = group_id < group_count ? combine(results[group_id], source_result) : source_result;
+      }
+    };
+
+    switch (_function) {
+      case AggregateFunction::Min:
+        merge(_values, typed_source._values, [](const T& lhs, const T& rhs) { return std::min(lhs, rhs); });
+        break;
+      case AggregateFunction::Max:
+        merge(_values, typed_source._values, [](const T& lhs, const T& rhs) { return std::max(lhs, rhs); });
+        break;
+      case AggregateFunction::Sum:
+      case AggregateFunction::Avg:
+        merge(_sums, typed_source._sums, std::plus<SumType>{});
+        break;
+      case AggregateFunction::CountDistinct:
+        merge(_distinct_values, typed_source._distinct_values,
+              [](const std::vector<T>& lhs, const std::vector<T>& rhs) {
+                auto values = std::vector<T>{};
+                values.reserve(lhs.size() + rhs.size());
+                std::set_union(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend(), std::back_inserter(values));
+                return values;
+              });
+        break;
+      case AggregateFunction::Count:
+        Fail("COUNT does not need values");
+    }
+  }
+
+  std::shared_ptr<AbstractSegment> create_output_segment(const std::vector<int64_t>& row_counts) override {
+    if (_is_min_or_max()) return std::make_shared<ValueSegment<T>>(std::move(_values));
+    if (_function == AggregateFunction::Sum) return std::make_shared<ValueSegment<SumType>>(std::move(_sums));
+    if (_function == AggregateFunction::CountDistinct) {
+      auto distinct_counts = std::vector<int64_t>(_distinct_values.size());
+      for (auto group_id = size_t{0}; group_id < distinct_counts.size(); ++group_id) {
+        distinct_counts[group_id] = static_cast<int64_t>(_distinct_values[group_id].size());
+      }
+      return std::make_shared<ValueSegment<int64_t>>(std::move(distinct_counts));
+    }
+
+    auto averages = std::vector<double>(_sums.size());
+    for (auto group_id = size_t{0}; group_id < averages.size(); ++group_id) {
+      averages[group_id] = static_cast<double>(_sums[group_id]) / static_cast<double>(row_counts[group_id]);
+    }
+    return std::make_shared<ValueSegment<double>>(std::move(averages));
+  }
+
+ private:
+  bool _is_min_or_max() const {
+    return _function == AggregateFunction::Min || _function == AggregateFunction::Max;
+  }
+
+  // Aggregates all rows of the chunk into a single group. Where possible, the result is derived from the metadata of
+  // the segment instead of its values: MIN and MAX come from the statistics of the chunk, which are read from the
+  // dictionary of dictionary segments. SUM and AVG multiply the dictionary entries with a histogram of the value ids
+  // or the values of runs with their lengths. COUNT(DISTINCT) takes the dictionary itself. Other segments are scanned.
+  void _aggregate_single_group(const Chunk& chunk, const ColumnID column_id) {
+    const auto segment = chunk.get_segment(column_id);
+    const auto dictionary_segment = std::dynamic_pointer_cast<const DictionarySegment<T>>(segment);
+    switch (_function) {
+      case AggregateFunction::Min:
+      case AggregateFunction::Max:
+        if (const auto statistics =
+                std::dynamic_pointer_cast<const MinMaxStatistics<T>>(chunk.get_statistics(column_id))) {
+          _values = {_function == AggregateFunction::Min ? statistics->minimum() : statistics->maximum()};
+          return;
+        }
+        break;
+      case AggregateFunction::Sum:
+      case AggregateFunction::Avg:
+        if constexpr (std::is_arithmetic_v<T>) {
+          auto sum = SumType{0};
+          if (dictionary_segment) {
+            const auto& dictionary = dictionary_segment->dictionary();
+            auto value_ids = std::vector<ValueID::base_type>(dictionary_segment->size());
+            dictionary_segment->attribute_vector()->decode(0, value_ids.size(), value_ids.data());
+            auto value_counts = std::vector<int64_t>(dictionary.size());
+            for (const auto value_id : value_ids) {
+              ++value_counts[value_id];
+            }
+            for (auto value_id = size_t{0}; value_id < dictionary.size(); ++value_id) {
+              sum += static_cast<SumType>(dictionary[value_id]) * static_cast<SumType>(value_counts[value_id]);
+            }
+            _sums = {sum};
+            return;
+          }
+          if (const auto run_length_segment = std::dynamic_pointer_cast<const RunLengthSegment<T>>(segment)) {
+            const auto& values = run_length_segment->values();
+            const auto& end_positions = run_length_segment->end_positions();
+            auto run_begin = size_t{0};
+            for (auto run_index = size_t{0}; run_index < values.size(); ++run_index) {
+              const auto run_length = end_positions[run_index] + 1 - run_begin;
+              sum += static_cast<SumType>(values[run_index]) * static_cast<SumType>(run_length);
+              run_begin = end_positions[run_index] + 1;
+            }
+            _sums = {sum};
+            return;
+          }
+        }
+        break;
+      case AggregateFunction::CountDistinct:
+        if (dictionary_segment) {
+          _distinct_values = {dictionary_segment->dictionary()};
+          return;
+        }
+        if constexpr (std::is_same_v<T, std::string>) {
+          if (const auto front_coded_segment =
+                  std::dynamic_pointer_cast<const FrontCodedDictionarySegment<T>>(segment)) {
+            auto values = std::vector<T>(front_coded_segment->unique_values_count());
+            for (auto value_id = ValueID{0}; value_id < values.size(); ++value_id) {
+              values[value_id] = front_coded_segment->value_of_value_id(value_id);
+            }
+            _distinct_values = {std::move(values)};
+            return;
+          }
+        }
+        break;
+      case AggregateFunction::Count:
+        Fail("COUNT does not need values");
+    }
+
+    segment_with_iterators<T>(*segment, [&](const auto begin, const auto end) {
+      switch (_function) {
+        case AggregateFunction::Min:
+        case AggregateFunction::Max: {
+          auto value = (*begin).value();
+          if (_function == AggregateFunction::Min) {
+            std::for_each(begin, end, [&](const auto& position) {
+              if (position.value() < value) value = position.value();
+            });
+          } else {
+            std::for_each(begin, end, [&](const auto& position) {
+              if (value < position.value()) value = position.value();
+            });
+          }
+          _values = {std::move(value)};
+        } break;
+        case AggregateFunction::Sum:
+        case AggregateFunction::Avg:
+          if constexpr (std::is_arithmetic_v<T>) {
+            auto sum = SumType{0};
+            std::for_each(begin, end, [&](const auto& position) { sum += position.value(); });
+            _sums = {sum};
+          } else {
+            Fail("SUM and AVG are not supported for strings");
+          }
+          break;
+        case AggregateFunction::CountDistinct: {
+          // hashing the values is cheaper than sorting all of them, only the
+          // distinct values are sorted afterwards.
+          auto value_ids = DenseIdMap<T>{1'024};
+          std::for_each(begin, end, [&](const auto& position) {
+            const auto& value = position.value();
+            value_ids.id_of(value, hash_value(value));
+          });
+          auto& values = value_ids.keys();
+          std::sort(values.begin(), values.end());
+          _distinct_values = {std::move(values)};
+        } break;
+        case AggregateFunction::Count:
+          Fail("COUNT does not need values");
+      }
+    });
+  }
+
+  const AggregateFunction _function;
+  std::vector<T> _values;
+  std::vector<SumType> _sums;
+  // the sorted distinct values of each group.
+  std::vector<std::vector<T>> _distinct_values;
+};
+
+// Returns the part of an output column name before the name of the aggregated column, e.g., "SUM(" for "SUM(a)".
+std::string aggregate_column_name_prefix(const AggregateFunction function) {
+  switch (function) {
+    case AggregateFunction::Min:
+      return "MIN(";
+    case AggregateFunction::Max:
+      return "MAX(";
+    case AggregateFunction::Sum:
+      return "SUM(";
+    case AggregateFunction::Avg:
+      return "AVG(";
+    case AggregateFunction::Count:
+      return "COUNT(";
+    case AggregateFunction::CountDistinct:
+      return "COUNT(DISTINCT ";
+  }
+  Fail("Unknown aggregate function");
+}
+
+}  // namespace
+
+Aggregate::Aggregate(const std::shared_ptr<const AbstractOperator>& input,
+                     const std::vector<AggregateColumnDefinition>& aggregates,
+                     const std::vector<ColumnID>& group_by_column_ids)
+    : AbstractOperator{input}, _aggregates{aggregates}, _group_by_column_ids{group_by_column_ids} {
+  for (const auto& aggregate : _aggregates) {
+    Assert(aggregate.column_id || aggregate.function == AggregateFunction::Count, "Only COUNT can omit the column");
+  }
+}
+
+const std::vector<AggregateColumnDefinition>& Aggregate::aggregates() const { return _aggregates; }
+
+const std::vector<ColumnID>& Aggregate::group_by_column_ids() const { return _group_by_column_ids; }
+
+std::shared_ptr<const Table> Aggregate::_on_execute() {
+  const auto in_table_ptr = _left_input_table();
+  const auto n_chunks = in_table_ptr->chunk_count();
+
+  auto column_definitions = std::make_shared<Table>();
+  for (const auto column_id : _group_by_column_ids) {
+    Assert(column_id < in_table_ptr->column_count(), "Group by column does not exist");
+    column_definitions->add_column_definition(in_table_ptr->column_name(column_id),
+                                              in_table_ptr->column_type(column_id));
+  }
+  for (const auto& aggregate : _aggregates) {
+    if (!aggregate.column_id) {
+      column_definitions->add_column_definition("COUNT(*)", "long");
+      continue;
+    }
+    Assert(*aggregate.column_id < in_table_ptr->column_count(), "Aggregate column does not exist");
+    const auto& column_type = in_table_ptr->column_type(*aggregate.column_id);
+    auto output_type = std::string{"long"};
+    switch (aggregate.function) {
+      case AggregateFunction::Min:
+      case AggregateFunction::Max:
+        output_type = column_type;
+        break;
+      case AggregateFunction::Sum:
+        Assert(column_type != "string", "SUM is not supported for strings");
+        output_type = column_type == "int" || column_type == "long" ? "long" : "double";
+        break;
+      case AggregateFunction::Avg:
+        Assert(column_type != "string", "AVG is not supported for strings");
+        output_type = "double";
+        break;
+      case AggregateFunction::Count:
+      case AggregateFunction::CountDistinct:
+        break;
+    }
+    column_definitions->add_column_definition(
+        aggregate_column_name_prefix(aggregate.function) + in_table_ptr->column_name(*aggregate.column_id) + ")",
+        output_type);
+  }
+
+  // each chunk is grouped and aggregated on its own. COUNT is the row count
+  // of the groups, so it has no results of its own.
+  auto chunk_groups = std::vector<ChunkGroups>(n_chunks);
+  auto chunk_results = std::vector<std::vector<std::unique_ptr<BaseAggregateResults>>>(n_chunks);
+  WorkerPool::get().parallel_for(n_chunks, [&](const size_t chunk_index) {
+    const auto chunk_id = static_cast<ChunkID>(chunk_index);
+    auto& groups = chunk_groups[chunk_index];
+    groups = group_chunk(in_table_ptr, chunk_id, _group_by_column_ids);
+
+    auto& results = chunk_results[chunk_index];
+    for (const auto& aggregate : _aggregates) {
+      if (aggregate.function == AggregateFunction::Count) {
+        results.emplace_back();
+        continue;
+      }
+      resolve_data_type(in_table_ptr->column_type(*aggregate.column_id), [&](auto type) {
+        using Type = typename decltype(type)::type;
+        results.emplace_back(std::make_unique<AggregateResults<Type>>(aggregate.function));
+      });
+      results.back()->aggregate(*in_table_ptr->get_chunk(chunk_id), *aggregate.column_id, groups);
+    }
+    groups.group_ids = {};
+  });
+
+  // the groups of all chunks are partitioned by the upper bits of the hashes
+  // of their keys. The lower bits select the slots of the hash tables.
+  auto group_count = size_t{0};
+  for (const auto& groups : chunk_groups) {
+    group_count += groups.row_counts.size();
+  }
+  const auto n_partitions =
+      std::min(std::bit_ceil(std::max(group_count / MERGE_PARTITION_SIZE, size_t{1})), size_t{1'024});
+  const auto partition_of = [&](const size_t hash) { return (hash >> 40) & (n_partitions - 1); };
+
+  auto chunk_partition_groups = std::vector<std::vector<std::vector<uint32_t>>>(n_chunks);
+  WorkerPool::get().parallel_for(n_chunks, [&](const size_t chunk_index) {
+    const auto& groups = chunk_groups[chunk_index];
+    auto& partition_groups = chunk_partition_groups[chunk_index];
+    partition_groups.resize(n_partitions);
+    for (auto group_id = uint32_t{0}; group_id < groups.row_counts.size(); ++group_id) {
+      if (groups.row_counts[group_id] == 0) continue;
+      partition_groups[partition_of(groups.key_hashes[group_id])].push_back(group_id);
+    }
+  });
+
+  auto output_chunks = std::vector<std::shared_ptr<Chunk>>(n_partitions);
+  WorkerPool::get().parallel_for(n_partitions, [&](const size_t partition_index) {
+    // the keys point into the key data of the chunks.
+    auto keys = DenseIdMap<std::string_view>{MERGE_PARTITION_SIZE};
+    auto row_counts = std::vector<int64_t>{};
+    auto results = std::vector<std::unique_ptr<BaseAggregateResults>>(_aggregates.size());
+    auto group_ids = std::vector<uint32_t>{};
+    for (auto chunk_index = size_t{0}; chunk_index < n_chunks; ++chunk_index) {
+      const auto& groups = chunk_groups[chunk_index];
+      const auto& source_group_ids = chunk_partition_groups[chunk_index][partition_index];
+      group_ids.resize(source_group_ids.size());
+      for (auto index = size_t{0}; index < source_group_ids.size(); ++index) {
+        const auto source_group_id = source_group_ids[index];
+        group_ids[index] = keys.id_of(groups.key(source_group_id), groups.key_hashes[source_group_id]);
+      }
+
+      row_counts.resize(keys.size());
+      for (auto index = size_t{0}; index < source_group_ids.size(); ++index) {
+        row_counts[group_ids[index]] += groups.row_counts[source_group_ids[index]];
+      }
+      const auto& source_results = chunk_results[chunk_index];
+      for (auto aggregate_index = size_t{0}; aggregate_index < results.size(); ++aggregate_index) {
+        if (!source_results[aggregate_index]) continue;
+        if (!results[aggregate_index]) {
+          results[aggregate_index] = source_results[aggregate_index]->create_empty();
+        }
+        results[aggregate_index]->merge_groups(*source_results[aggregate_index], source_group_ids, group_ids);
+      }
+    }
+    if (row_counts.empty()) return;
+
+    // the values of the group by columns are read back from the keys.
+    auto& output_chunk = output_chunks[partition_index];
+    output_chunk = std::make_shared<Chunk>();
+    auto key_positions = std::vector<size_t>(keys.size());
+    for (const auto column_id : _group_by_column_ids) {
+      resolve_data_type(in_table_ptr->column_type(column_id), [&](auto type) {
+        using Type = typename decltype(type)::type;
+        auto values = std::vector<Type>(keys.size());
+        for (auto group_id = size_t{0}; group_id < keys.size(); ++group_id) {
+          values[group_id] = read_from_key<Type>(keys.keys()[group_id], key_positions[group_id]);
+        }
+        output_chunk->add_segment(std::make_shared<ValueSegment<Type>>(std::move(values)));
+      });
+    }
+    for (auto& aggregate_results : results) {
+      if (aggregate_results) {
+        output_chunk->add_segment(aggregate_results->create_output_segment(row_counts));
+      } else {
+        output_chunk->add_segment(std::make_shared<ValueSegment<int64_t>>(std::vector<int64_t>(row_counts)));
+      }
+    }
+  });
+  std::erase(output_chunks, nullptr);
+
+  // without group by columns, an empty input still has one row, in which all
+  // counts are zero. The other aggregates would be NULL, which cannot be
+  // represented, so there is no row for them.
+  const auto is_count = [](const auto& aggregate) {
+    return aggregate.function == AggregateFunction::Count || aggregate.function == AggregateFunction::CountDistinct;
+  };
+  if (output_chunks.empty() && _group_by_column_ids.empty() && !_aggregates.empty() &&
+      std::all_of(_aggregates.cbegin(), _aggregates.cend(), is_count)) {
+    auto& output_chunk = output_chunks.emplace_back(std::make_shared<Chunk>());
+    for (auto aggregate_index = size_t{0}; aggregate_index < _aggregates.size(); ++aggregate_index) {
+      output_chunk->add_segment(std::make_shared<ValueSegment<int64_t>>(std::vector<int64_t>{0}));
+    }
+  }
+
+  if (output_chunks.empty()) return std::make_shared<Table>(column_definitions);
+  return std::make_shared<Table>(output_chunks, column_definitions);
+}
+
+}  // namespace opossum
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "abstract_operator.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+enum class AggregateFunction { Min, Max, Sum, Avg, Count, CountDistinct };
+
+// An aggregate of a column, e.g., SUM(a). Count is the only function that does not need a column (COUNT(*)). As there
+// are no NULL values, COUNT(a) equals COUNT(*). CountDistinct counts the different values of its column.
+struct AggregateColumnDefinition {
+  AggregateFunction function;
+  std::optional<ColumnID> column_id;
+};
+
+// Groups the rows of its input by the values of the group by columns and computes the aggregates for each group, like
+// SELECT <group by columns>, <aggregates> FROM input GROUP BY <group by columns>. The output has the group by columns
+// followed by one column per aggregate, e.g., "SUM(a)", "COUNT(*)", or "COUNT(DISTINCT a)". MIN and MAX have the data
+// type of their column, SUM of an integer column is a long, SUM of a floating-point column and AVG are doubles, and
+// COUNT and COUNT(DISTINCT) are longs. SUM and AVG of string columns are not supported. Without group by columns, all
+// rows form a single group, so the output has one row. If the input is empty, this row only exists if all aggregates
+// are counts, as there are no NULL values for the others. The order of the output rows is not defined.
+//
+// The chunks are aggregated in parallel. Each chunk assigns its rows to dense group ids first: The value ids of
+// dictionary segments are used as the group ids directly, and the values of other segments are mapped to ids by a flat
+// hash table with open addressing. The ids of several group by columns are combined in the same way. The partial
+// aggregates of each chunk are kept in arrays indexed by these ids. Finally, the groups of all chunks are partitioned
+// by the hashes of their values, and the partitions are merged in parallel. Each partition becomes one output chunk.
+//
+// Without group by columns, the chunks are not grouped at all and the aggregates avoid decoding values where the
+// segments allow it: COUNT(*) is the size of the chunk, MIN and MAX are taken from the statistics of the chunk (the
+// first and last dictionary entries of dictionary segments), COUNT(DISTINCT) merges the dictionaries, and SUM and AVG
+// of dictionary and run-length segments are computed per distinct value and run. Only the remaining segments are
+// scanned, so MIN, MAX, and COUNT over dictionary-encoded tables take time in the order of their chunk count.
+class Aggregate : public AbstractOperator {
+ public:
+  // The groups of all chunks are merged in partitions of about this many groups.
+  static constexpr auto MERGE_PARTITION_SIZE = size_t{16'384};
+
+  Aggregate(const std::shared_ptr<const AbstractOperator>& input,
+            const std::vector<AggregateColumnDefinition>& aggregates, const std::vector<ColumnID>& group_by_column_ids);
+
+  const std::vector<AggregateColumnDefinition>& aggregates() const;
+  const std::vector<ColumnID>& group_by_column_ids() const;
+
+ protected:
+  std::shared_ptr<const Table> _on_execute() override;
+
+  const std::vector<AggregateColumnDefinition> _aggregates;
+  const std::vector<ColumnID> _group_by_column_ids;
+};
+
+}  // namespace opossum
@@ -0,0 +1,33 @@
+#include "batch.hpp"
+
+#include <memory>
+#include <numeric>
+#include <vector>
+
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+Batch::Batch(const std::shared_ptr<const Table>& table, const ChunkID chunk_id, const ChunkOffset begin,
+             const ChunkOffset end)
+    : _table{table}, _chunk_id{chunk_id}, _begin{begin}, _end{end}, _columns(table->column_count()) {
+  Assert(begin <= end && end - begin <= MAX_SIZE, "A batch must not have more than MAX_SIZE rows");
+  _selection.resize(end - begin);
+  std::iota(_selection.begin(), _selection.end(), uint16_t{0});
+}
+
+const std::shared_ptr<const Table>& Batch::table() const { return _table; }
+
+ChunkID Batch::chunk_id() const { return _chunk_id; }
+
+ChunkOffset Batch::begin() const { return _begin; }
+
+ChunkOffset Batch::end() const { return _end; }
+
+ChunkOffset Batch::size() const { return _end - _begin; }
+
+std::vector<uint16_t>& Batch::selection() { return _selection; }
+
+const std::vector<uint16_t>& Batch::selection() const { return _selection; }
+
+}  // namespace opossum
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <any>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "storage/segment_accessor.hpp"
+#include "storage/segment_iterate.hpp"
+#include "storage/table.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+// A batch of at most MAX_SIZE consecutive rows [begin, end) of one chunk of the input table of a Pipeline, for
+// vector-at-a-time execution. Operators exchange the batch instead of PosLists: The selection vector holds the offsets
+// of the rows that are still part of the output, relative to begin and in ascending order, and operators remove the
+// rows they filter out. The values of a column are decoded into a vector when an operator first asks for them and are
+// reused by later operators on the same column, so that all operators of a pipeline work on vectors that stay in the
+// L1 cache.
+//
+// Because rows are only ever removed from the selection, values(column_id) only decodes the rows that are selected at
+// the first call. The values of the other rows are default-constructed.
+class Batch : private Noncopyable {
+ public:
+  static constexpr auto MAX_SIZE = ChunkOffset{4096};
+
+  // All rows of the range are selected initially.
+  Batch(const std::shared_ptr<const Table>& table, const ChunkID chunk_id, const ChunkOffset begin,
+        const ChunkOffset end);
+
+  const std::shared_ptr<const Table>& table() const;
+  ChunkID chunk_id() const;
+  ChunkOffset begin() const;
+  ChunkOffset end() const;
+  ChunkOffset size() const;
+
+  std::vector<uint16_t>& selection();
+  const std::vector<uint16_t>& selection() const;
+
+  // Returns the values of the column for the rows of the batch, indexed by their offset relative to begin. T must be
+  // the data type of the column. The values of a ValueSegment are not copied but read from the segment directly.
+  template <typename T>
+  const T* values(const ColumnID column_id) {
+    auto& column = _columns[column_id];
+    if (!column.values) {
+      column.values = _materialize<T>(column_id, column);
+    }
+    return static_cast<const T*>(column.values);
+  }
+
+ protected:
+  // The values of a column that has been requested, the segment they were read from, and the std::vector<T> that
+  // holds them unless they are read from a ValueSegment directly.
+  struct Column {
+    const void* values{nullptr};
+    std::shared_ptr<const AbstractSegment> segment;
+    std::any decoded_values;
+  };
+
+  template <typename T>
+  const T* _materialize(const ColumnID column_id, Column& column) {
+    column.segment = _table->get_chunk(_chunk_id)->get_segment(column_id);
+    const auto& segment = column.segment;
+    if (const auto* value_segment = dynamic_cast<const ValueSegment<T>*>(segment.get())) {
+      return value_segment->values().data() + _begin;
+    }
+
+    auto values = std::vector<T>(size());
+    resolve_segment_type<T>(*segment, [&](const auto& typed_segment) {
+      using SegmentType = std::decay_t<decltype(typed_segment)>;
+      if constexpr (std::is_same_v<SegmentType, ReferenceSegment>) {
+        // the referenced rows are read one by one. A bitmap finds its positions through the sampled ranks, so the
+        // whole bitmap is not decoded for every batch.
+        const auto& pos_list = *typed_segment.pos_list();
+        auto accessors = ReferencedSegmentAccessors<T>{typed_segment};
+        for (const auto offset : _selection) {
+          const auto row_id = pos_list[_begin + offset];
+          values[offset] = accessors.get(row_id.chunk_id).access(row_id.chunk_offset);
+        }
+      } else if constexpr (std::is_same_v<SegmentType, FrontCodedDictionarySegment<T>>) {
+        // decoding the whole front-coded dictionary, as the segment iterators do, does not pay off for a single batch.
+        for (const auto offset : _selection) {
+          values[offset] = typed_segment.get(_begin + offset);
+        }
+      } else {
+        segment_with_iterators<T>(typed_segment, [&](auto iterator, const auto /* end */) {
+          iterator += _begin;
+          auto previous_offset = uint16_t{0};
+          for (const auto offset : _selection) {
+            iterator += offset - previous_offset;
+            values[offset] = (*iterator).value();
+            previous_offset = offset;
+          }
+        });
+      }
+    });
+
+    // moving the vector into the std::any keeps its buffer.
+    const auto* data = values.data();
+    column.decoded_values = std::move(values);
+    return data;
+  }
+
+  const std::shared_ptr<const Table> _table;
+  const ChunkID _chunk_id;
+  const ChunkOffset _begin;
+  const ChunkOffset _end;
+  std::vector<uint16_t> _selection;
+
+  std::vector<Column> _columns;
+};
+
+}  // namespace opossum
@@ -0,0 +1,200 @@
+#include "expression.hpp"
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/hana/for_each.hpp>
+
+#include "type_cast.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+namespace {
+
+// The numeric data types from the narrowest to the widest.
+constexpr auto NUMERIC_DATA_TYPES = std::array{"int", "long", "float", "double"};
+
+bool is_numeric(const std::string& data_type) {
+  return std::find(NUMERIC_DATA_TYPES.cbegin(), NUMERIC_DATA_TYPES.cend(), data_type) != NUMERIC_DATA_TYPES.cend();
+}
+
+std::string data_type_of(const AllTypeVariant& value) {
+  auto data_type = std::string{};
+  hana::for_each(data_types, [&](auto data_type_pair) {
+    using Type = typename decltype(+hana::second(data_type_pair))::type;
+    if (boost::get<Type>(&value)) data_type = hana::first(data_type_pair);
+  });
+  return data_type;
+}
+
+std::string operator_symbol(const ArithmeticOperator arithmetic_operator) {
+  switch (arithmetic_operator) {
+    case ArithmeticOperator::Addition:
+      return "+";
+    case ArithmeticOperator::Subtraction:
+      return "-";
+    case ArithmeticOperator::Multiplication:
+      return "*";
+    case ArithmeticOperator::Division:
+      return "/";
+  }
+  Fail("Unknown arithmetic operator");
+}
+
+std::string operator_symbol(const ScanType scan_type) {
+  switch (scan_type) {
+    case ScanType::OpEquals:
+      return "=";
+    case ScanType::OpNotEquals:
+      return "!=";
+    case ScanType::OpLessThan:
+      return "<";
+    case ScanType::OpLessThanEquals:
+      return "<=";
+    case ScanType::OpGreaterThan:
+      return ">";
+    case ScanType::OpGreaterThanEquals:
+      return ">=";
+  }
+  Fail("Unknown scan type");
+}
+
+}  // namespace
+
+std::string wider_data_type(const std::string& lhs, const std::string& rhs) {
+  Assert(is_numeric(lhs) && is_numeric(rhs), "Only numbers can be combined, not " + lhs + " and " + rhs);
+  const auto lhs_position = std::find(NUMERIC_DATA_TYPES.cbegin(), NUMERIC_DATA_TYPES.cend(), lhs);
+  const auto rhs_position = std::find(NUMERIC_DATA_TYPES.cbegin(), NUMERIC_DATA_TYPES.cend(), rhs);
+  return *std::max(lhs_position, rhs_position);
+}
+
+Expression::Expression(const ExpressionType type, std::vector<std::shared_ptr<const Expression>> arguments)
+    : _type{type}, _arguments{std::move(arguments)} {
+  for (const auto& argument : _arguments) {
+    Assert(argument, "Arguments must not be null");
+  }
+}
+
+std::shared_ptr<const Expression> Expression::column(const ColumnID column_id) {
+  auto expression = std::shared_ptr<Expression>(new Expression(ExpressionType::Column, {}));
+  expression->_column_id = column_id;
+  return expression;
+}
+
+std::shared_ptr<const Expression> Expression::value(const AllTypeVariant& value) {
+  auto expression = std::shared_ptr<Expression>(new Expression(ExpressionType::Value, {}));
+  expression->_value = value;
+  return expression;
+}
+
+std::shared_ptr<const Expression> Expression::arithmetic(const ArithmeticOperator arithmetic_operator,
+                                                         const std::shared_ptr<const Expression>& left,
+                                                         const std::shared_ptr<const Expression>& right) {
+  auto expression = std::shared_ptr<Expression>(new Expression(ExpressionType::Arithmetic, {left, right}));
+  expression->_arithmetic_operator = arithmetic_operator;
+  return expression;
+}
+
+std::shared_ptr<const Expression> Expression::comparison(const ScanType scan_type,
+                                                         const std::shared_ptr<const Expression>& left,
+                                                         const std::shared_ptr<const Expression>& right) {
+  auto expression = std::shared_ptr<Expression>(new Expression(ExpressionType::Comparison, {left, right}));
+  expression->_scan_type = scan_type;
+  return expression;
+}
+
+std::shared_ptr<const Expression> Expression::case_when(const std::shared_ptr<const Expression>& condition,
+                                                        const std::shared_ptr<const Expression>& then_result,
+                                                        const std::shared_ptr<const Expression>& else_result) {
+  return std::shared_ptr<Expression>(new Expression(ExpressionType::Case, {condition, then_result, else_result}));
+}
+
+ExpressionType Expression::type() const { return _type; }
+
+ColumnID Expression::column_id() const {
+  DebugAssert(_type == ExpressionType::Column, "Only column expressions have a column id");
+  return _column_id;
+}
+
+const AllTypeVariant& Expression::value() const {
+  DebugAssert(_type == ExpressionType::Value, "Only value expressions have a value");
+  return _value;
+}
+
+ArithmeticOperator Expression::arithmetic_operator() const {
+  DebugAssert(_type == ExpressionType::Arithmetic, "Only arithmetic expressions have an operator");
+  return _arithmetic_operator;
+}
+
+ScanType Expression::scan_type() const {
+  DebugAssert(_type == ExpressionType::Comparison, "Only comparisons have a scan type");
+  return _scan_type;
+}
+
+const std::vector<std::shared_ptr<const Expression>>& Expression::arguments() const { return _arguments; }
+
+std::string Expression::data_type(const Table& table) const {
+  switch (_type) {
+    case ExpressionType::Column:
+      Assert(_column_id < table.column_count(), "Column does not exist");
+      return table.column_type(_column_id);
+    case ExpressionType::Value:
+      return data_type_of(_value);
+    case ExpressionType::Arithmetic:
+      return wider_data_type(_arguments[0]->data_type(table), _arguments[1]->data_type(table));
+    case ExpressionType::Comparison: {
+      const auto left_data_type = _arguments[0]->data_type(table);
+      const auto right_data_type = _arguments[1]->data_type(table);
+      Assert((left_data_type == "string") == (right_data_type == "string"),
+             "Strings can only be compared with strings");
+      return "int";
+    }
+    case ExpressionType::Case: {
+      Assert(_arguments[0]->data_type(table) == "int", "The condition of a CASE must be an int");
+      const auto then_data_type = _arguments[1]->data_type(table);
+      const auto else_data_type = _arguments[2]->data_type(table);
+      if (then_data_type == "string" && else_data_type == "string") return "string";
+      return wider_data_type(then_data_type, else_data_type);
+    }
+  }
+  Fail("Unknown expression type");
+}
+
+std::string Expression::description(const Table& table) const {
+  // nested arithmetic and comparisons are put in parentheses.
+  const auto argument_description = [&](const size_t argument_index) {
+    const auto& argument = *_arguments[argument_index];
+    const auto description = argument.description(table);
+    if (argument.type() == ExpressionType::Arithmetic || argument.type() == ExpressionType::Comparison) {
+      return "(" + description + ")";
+    }
+    return description;
+  };
+
+  switch (_type) {
+    case ExpressionType::Column:
+      return table.column_name(_column_id);
+    case ExpressionType::Value: {
+      if (data_type_of(_value) != "string") return type_cast<std::string>(_value);
+      auto quoted_value = std::string{"'"};
+      quoted_value += boost::get<std::string>(_value);
+      quoted_value += '\'';
+      return quoted_value;
+    }
+    case ExpressionType::Arithmetic:
+      return argument_description(0) + " " + operator_symbol(_arithmetic_operator) + " " + argument_description(1);
+    case ExpressionType::Comparison:
+      return argument_description(0) + " " + operator_symbol(_scan_type) + " " + argument_description(1);
+    case ExpressionType::Case:
+      return "CASE WHEN " + _arguments[0]->description(table) + " THEN " + _arguments[1]->description(table) +
+             " ELSE " + _arguments[2]->description(table) + " END";
+  }
+  Fail("Unknown expression type");
+}
+
+}  // namespace opossum
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "all_type_variant.hpp"
+#include "storage/table.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+enum class ExpressionType { Column, Value, Arithmetic, Comparison, Case };
+
+enum class ArithmeticOperator { Addition, Subtraction, Multiplication, Division };
+
+// Returns the wider of two numeric data types in the order int, long, float, double, e.g., "double" for "long" and
+// "double". Fails if one of them is not numeric.
+std::string wider_data_type(const std::string& lhs, const std::string& rhs);
+
+// A node of an expression tree that computes one value per row of a table, e.g., "a + 1", "b < c * 2", or
+// "CASE WHEN a > 0 THEN a ELSE -a END". Expressions are immutable and created with the static factory methods, which
+// allows subtrees to be shared.
+//
+// The data type of an expression follows from the types of the columns that it refers to: Arithmetic on two numbers
+// yields the wider of their types in the order int, long, float, double. Comparisons yield an int that is 1 if the
+// comparison holds and 0 otherwise, as there are no booleans. Numbers can be compared with numbers and strings with
+// strings. The condition of a CASE must be an int, and its results are widened like the operands of arithmetic.
+// Arithmetic on strings is not supported. Integer division truncates, and dividing an integer by zero fails.
+class Expression : private Noncopyable {
+ public:
+  static std::shared_ptr<const Expression> column(const ColumnID column_id);
+  static std::shared_ptr<const Expression> value(const AllTypeVariant& value);
+  static std::shared_ptr<const Expression> arithmetic(const ArithmeticOperator arithmetic_operator,
+                                                     const std::shared_ptr<const Expression>& left,
+                                                     const std::shared_ptr<const Expression>& right);
+  static std::shared_ptr<const Expression> comparison(const ScanType scan_type,
+                                                      const std::shared_ptr<const Expression>& left,
+                                                      const std::shared_ptr<const Expression>& right);
+  // CASE WHEN condition THEN then_result ELSE else_result END.
+  static std::shared_ptr<const Expression> case_when(const std::shared_ptr<const Expression>& condition,
+                                                     const std::shared_ptr<const Expression>& then_result,
+                                                     const std::shared_ptr<const Expression>& else_result);
+
+  ExpressionType type() const;
+
+  // Only for column expressions.
+  ColumnID column_id() const;
+
+  // Only for value expressions.
+  const AllTypeVariant& value() const;
+
+  // Only for arithmetic expressions.
+  ArithmeticOperator arithmetic_operator() const;
+
+  // Only for comparisons.
+  ScanType scan_type() const;
+
+  // The operands of arithmetic expressions and comparisons, or the condition and the two results of a CASE.
+  const std::vector<std::shared_ptr<const Expression>>& arguments() const;
+
+  // Returns the data type of the values of the expression for rows of the given table, e.g., "long". Fails if the
+  // expression refers to a column that the table does not have or if the types of its arguments do not fit.
+  std::string data_type(const Table& table) const;
+
+  // Returns a readable form of the expression, e.g., "a + 1" for the table with column a.
+  std::string description(const Table& table) const;
+
+ protected:
+  Expression(const ExpressionType type, std::vector<std::shared_ptr<const Expression>> arguments);
+
+  const ExpressionType _type;
+  const std::vector<std::shared_ptr<const Expression>> _arguments;
+  ColumnID _column_id{0};
+  AllTypeVariant _value{};
+  ArithmeticOperator _arithmetic_operator{ArithmeticOperator::Addition};
+  ScanType _scan_type{ScanType::OpEquals};
+};
+
+}  // namespace opossum
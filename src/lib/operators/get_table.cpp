@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <vector>
@@ -8,13 +9,33 @@
 
 namespace opossum {
 
-GetTable::GetTable(const std::string& name) : _table_name{name} {}
+GetTable::GetTable(const std::string& name, const std::vector<ChunkPruningPredicate>& pruning_predicates)
+    : _table_name{name}, _pruning_predicates{pruning_predicates} {}
 
 const std::string& GetTable::table_name() { return _table_name; }
 
+const std::vector<ChunkPruningPredicate>& GetTable::pruning_predicates() const { return _pruning_predicates; }
+
 std::shared_ptr<const Table> GetTable::_on_execute() {
   DebugAssert(StorageManager::get().has_table(_table_name), "Table " + _table_name + " does not exist");
-  return StorageManager::get().get_table(_table_name);
+  const auto table = StorageManager::get().get_table(_table_name);
+  if (_pruning_predicates.empty()) return table;
+
+  auto remaining_chunks = std::vector<std::shared_ptr<Chunk>>{};
+  const auto chunk_count = table->chunk_count();
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    const auto chunk = table->get_chunk(chunk_id);
+    const auto is_pruned =
+        std::any_of(_pruning_predicates.cbegin(), _pruning_predicates.cend(), [&](const auto& predicate) {
+          return chunk->can_prune(predicate.column_id, predicate.scan_type, predicate.search_value);
+        });
+    if (!is_pruned) remaining_chunks.emplace_back(chunk);
+  }
+
+  // the stored table is returned as is if no chunk could be pruned.
+  if (remaining_chunks.size() == chunk_count) return table;
+  if (remaining_chunks.empty()) return std::make_shared<Table>(table, table->target_chunk_size());
+  return std::make_shared<Table>(remaining_chunks, table, table->target_chunk_size());
 }
 
 }  // namespace opossum
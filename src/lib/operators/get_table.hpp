@@ -5,18 +5,31 @@
 #include <vector>
 
 #include "abstract_operator.hpp"
+#include "all_type_variant.hpp"
+#include "types.hpp"
 
 namespace opossum {
 
+// A predicate of the form value <scan_type> search_value on one column, used by GetTable to prune chunks.
+struct ChunkPruningPredicate {
+  ColumnID column_id;
+  ScanType scan_type;
+  AllTypeVariant search_value;
+};
+
 // Operator to retrieve a table from the StorageManager by specifying its name.
+// If pruning predicates are given (typically those of a TableScan that consumes the output), the chunks whose min/max
+// statistics prove that they cannot satisfy all predicates are left out of the output table.
 class GetTable : public AbstractOperator {
  public:
-  explicit GetTable(const std::string& name);
+  explicit GetTable(const std::string& name, const std::vector<ChunkPruningPredicate>& pruning_predicates = {});
   const std::string& table_name();
+  const std::vector<ChunkPruningPredicate>& pruning_predicates() const;
 
  protected:
   std::shared_ptr<const Table> _on_execute();
   std::string _table_name;
+  std::vector<ChunkPruningPredicate> _pruning_predicates;
 };
 
 }  // namespace opossum
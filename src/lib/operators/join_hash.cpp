@@ -0,0 +1,220 @@
+#include "join_hash.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "resolve_type.hpp"
+#include "scheduler/worker_pool.hpp"
+#include "storage/pos_list.hpp"
+#include "storage/segment_iterate.hpp"
+#include "utils/assert.hpp"
+#include "utils/hash_value.hpp"
+
+namespace opossum {
+
+namespace {
+
+// A value of the join column together with its position in the input table and its hash.
+template <typename T>
+struct PartitionElement {
+  size_t hash;
+  RowID row_id;
+  T value;
+};
+
+// The elements of all partitions, stored one partition after the other. The elements of partition p are at
+// [partition_offsets[p], partition_offsets[p + 1]).
+template <typename T>
+struct RadixPartitions {
+  std::vector<PartitionElement<T>> elements;
+  std::vector<size_t> partition_offsets;
+};
+
+// Materializes the join column of the table and partitions it by the lowest radix_bits bits of the hashes. The chunks
+// are materialized in parallel. Then, each chunk scatters its elements to the partitions, where the elements of a
+// chunk follow those of the previous chunks.
+template <typename T>
+RadixPartitions<T> radix_partition(const std::shared_ptr<const Table>& table, const ColumnID column_id,
+                                   const uint8_t radix_bits) {
+  const auto n_chunks = table->chunk_count();
+  const auto n_partitions = size_t{1} << radix_bits;
+  const auto partition_mask = n_partitions - 1;
+
+  auto chunk_elements = std::vector<std::vector<PartitionElement<T>>>(n_chunks);
+  auto chunk_histograms = std::vector<std::vector<size_t>>(n_chunks);
+  WorkerPool::get().parallel_for(n_chunks, [&](const size_t chunk_index) {
+    const auto chunk_id = static_cast<ChunkID>(chunk_index);
+    const auto segment = table->get_chunk(chunk_id)->get_segment(column_id);
+    auto& elements = chunk_elements[chunk_index];
+    auto& histogram = chunk_histograms[chunk_index];
+    elements.reserve(segment->size());
+    histogram.resize(n_partitions);
+    segment_iterate<T>(*segment, [&](const auto& position) {
+      const auto hash = hash_value(position.value());
+      elements.push_back(PartitionElement<T>{hash, RowID{chunk_id, position.chunk_offset()}, position.value()});
+      ++histogram[hash & partition_mask];
+    });
+  });
+
+  // the elements of chunk c in partition p start after those of all
+  // previous partitions and after those of the previous chunks in p.
+  auto partitions = RadixPartitions<T>{};
+  partitions.partition_offsets.resize(n_partitions + 1);
+  auto chunk_offsets = std::vector<std::vector<size_t>>(n_chunks, std::vector<size_t>(n_partitions));
+  auto offset = size_t{0};
+  for (auto partition_index = size_t{0}; partition_index < n_partitions; ++partition_index) {
+    partitions.partition_offsets[partition_index] = offset;
+    for (auto chunk_index = size_t{0}; chunk_index < n_chunks; ++chunk_index) {
+      chunk_offsets[chunk_index][partition_index] = offset;
+      offset += chunk_histograms[chunk_index][partition_index];
+    }
+  }
+  partitions.partition_offsets[n_partitions] = offset;
+
+  partitions.elements.resize(offset);
+  WorkerPool::get().parallel_for(n_chunks, [&](const size_t chunk_index) {
+    auto& offsets = chunk_offsets[chunk_index];
+    for (auto& element : chunk_elements[chunk_index]) {
+      partitions.elements[offsets[element.hash & partition_mask]++] = std::move(element);
+    }
+    chunk_elements[chunk_index] = {};
+  });
+  return partitions;
+}
+
+// The matching rows of a partition, by input.
+struct PartitionMatches {
+  std::vector<RowID> build_row_ids;
+  std::vector<RowID> probe_row_ids;
+};
+
+// Builds a hash table on the build elements and probes it with the probe elements. The hash table chains the build
+// elements of a bucket through their indexes, so it consists of two arrays of 32-bit integers only. The bits of the
+// hash that select the partition are the same for all elements of a partition and are not used for the bucket.
+template <typename T>
+PartitionMatches join_partition(const PartitionElement<T>* build_elements, const size_t build_element_count,
+                                const PartitionElement<T>* probe_elements, const size_t probe_element_count,
+                                const uint8_t radix_bits) {
+  auto matches = PartitionMatches{};
+  if (build_element_count == 0 || probe_element_count == 0) return matches;
+
+  constexpr auto NO_ELEMENT = std::numeric_limits<uint32_t>::max();
+  const auto bucket_count = std::bit_ceil(build_element_count);
+  const auto bucket_mask = bucket_count - 1;
+  auto bucket_heads = std::vector<uint32_t>(bucket_count, NO_ELEMENT);
+  auto next_elements = std::vector<uint32_t>(build_element_count);
+  for (auto element_index = uint32_t{0}; element_index < build_element_count; ++element_index) {
+    auto& bucket_head = bucket_heads[(build_elements[element_index].hash >> radix_bits) & bucket_mask];
+    next_elements[element_index] = bucket_head;
+    bucket_head = element_index;
+  }
+
+  for (auto probe_index = size_t{0}; probe_index < probe_element_count; ++probe_index) {
+    const auto& probe_element = probe_elements[probe_index];
+    auto element_index = bucket_heads[(probe_element.hash >> radix_bits) & bucket_mask];
+    while (element_index != NO_ELEMENT) {
+      const auto& build_element = build_elements[element_index];
+      if (build_element.hash == probe_element.hash && build_element.value == probe_element.value) {
+        matches.build_row_ids.push_back(build_element.row_id);
+        matches.probe_row_ids.push_back(probe_element.row_id);
+      }
+      element_index = next_elements[element_index];
+    }
+  }
+  return matches;
+}
+
+}  // namespace
+
+JoinHash::JoinHash(const std::shared_ptr<const AbstractOperator>& left,
+                   const std::shared_ptr<const AbstractOperator>& right, const ColumnID left_column_id,
+                   const ColumnID right_column_id, const std::optional<uint8_t> radix_bits)
+    : AbstractJoinOperator{left, right, left_column_id, right_column_id, ScanType::OpEquals}, _radix_bits{radix_bits} {
+  Assert(!radix_bits || *radix_bits <= MAX_RADIX_BITS, "Too many radix bits");
+}
+
+std::shared_ptr<const Table> JoinHash::_on_execute() {
+  const auto& data_type = _left_input_table()->column_type(_left_column_id);
+  Assert(data_type == _right_input_table()->column_type(_right_column_id),
+         "The join columns must have the same data type");
+
+  auto output = std::shared_ptr<const Table>{};
+  resolve_data_type(data_type, [&](auto type) {
+    using Type = typename decltype(type)::type;
+    output = _join<Type>();
+  });
+  return output;
+}
+
+template <typename T>
+std::shared_ptr<const Table> JoinHash::_join() {
+  const auto left_table = _left_input_table();
+  const auto right_table = _right_input_table();
+
+  // the hash table is built on the smaller input.
+  const auto build_is_left = left_table->row_count() <= right_table->row_count();
+  const auto build_row_count = std::min(left_table->row_count(), right_table->row_count());
+
+  // use as many radix bits as needed for the hash tables of the partitions
+  // to fit into PARTITION_SIZE_BYTES (an element and two bucket entries per
+  // build row).
+  auto radix_bits = uint8_t{0};
+  if (_radix_bits) {
+    radix_bits = *_radix_bits;
+  } else {
+    const auto build_size_bytes = build_row_count * (sizeof(PartitionElement<T>) + 2 * sizeof(uint32_t));
+    while (radix_bits < MAX_RADIX_BITS && (build_size_bytes >> radix_bits) > PARTITION_SIZE_BYTES) {
+      ++radix_bits;
+    }
+  }
+
+  const auto left_partitions = radix_partition<T>(left_table, _left_column_id, radix_bits);
+  const auto right_partitions = radix_partition<T>(right_table, _right_column_id, radix_bits);
+  const auto& build_partitions = build_is_left ? left_partitions : right_partitions;
+  const auto& probe_partitions = build_is_left ? right_partitions : left_partitions;
+
+  const auto n_partitions = size_t{1} << radix_bits;
+  auto partition_matches = std::vector<PartitionMatches>(n_partitions);
+  WorkerPool::get().parallel_for(n_partitions, [&](const size_t partition_index) {
+    const auto build_begin = build_partitions.partition_offsets[partition_index];
+    const auto build_end = build_partitions.partition_offsets[partition_index + 1];
+    const auto probe_begin = probe_partitions.partition_offsets[partition_index];
+    const auto probe_end = probe_partitions.partition_offsets[partition_index + 1];
+    Assert(build_end - build_begin < std::numeric_limits<uint32_t>::max(), "Partition is too large");
+    partition_matches[partition_index] =
+        join_partition(build_partitions.elements.data() + build_begin, build_end - build_begin,
+                       probe_partitions.elements.data() + probe_begin, probe_end - probe_begin, radix_bits);
+  });
+
+  // consecutive partitions are combined into output chunks.
+  auto left_pos_lists = std::vector<std::shared_ptr<const PosList>>{};
+  auto right_pos_lists = std::vector<std::shared_ptr<const PosList>>{};
+  auto left_row_ids = std::vector<RowID>{};
+  auto right_row_ids = std::vector<RowID>{};
+  for (auto partition_index = size_t{0}; partition_index < n_partitions; ++partition_index) {
+    auto& matches = partition_matches[partition_index];
+    const auto& partition_left_row_ids = build_is_left ? matches.build_row_ids : matches.probe_row_ids;
+    const auto& partition_right_row_ids = build_is_left ? matches.probe_row_ids : matches.build_row_ids;
+    left_row_ids.insert(left_row_ids.end(), partition_left_row_ids.cbegin(), partition_left_row_ids.cend());
+    right_row_ids.insert(right_row_ids.end(), partition_right_row_ids.cbegin(), partition_right_row_ids.cend());
+    matches = {};
+
+    const auto is_last_partition = partition_index + 1 == n_partitions;
+    if (left_row_ids.size() >= MIN_OUTPUT_CHUNK_SIZE || (is_last_partition && !left_row_ids.empty())) {
+      left_pos_lists.emplace_back(std::make_shared<PosList>(std::move(left_row_ids)));
+      right_pos_lists.emplace_back(std::make_shared<PosList>(std::move(right_row_ids)));
+      left_row_ids = {};
+      right_row_ids = {};
+    }
+  }
+
+  return _build_output_table(left_pos_lists, right_pos_lists);
+}
+
+}  // namespace opossum
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+#include "abstract_join_operator.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+// Equi-join that builds a hash table on the smaller input and probes it with the other one. Both inputs are radix
+// partitioned by the lowest bits of the hashes of their join values first. Then, each partition of the smaller input
+// is small enough for its hash table to stay in the L2 cache while the matching partition of the other input is
+// probed. The partitions are materialized chunk by chunk and joined partition by partition on the WorkerPool.
+//
+// The order of the output rows is not defined.
+class JoinHash : public AbstractJoinOperator {
+ public:
+  // The hash table of a partition should not exceed this size (the L2 cache size of common CPUs).
+  static constexpr auto PARTITION_SIZE_BYTES = size_t{256 * 1024};
+
+  // Partitioning with more bits scatters the values to too many places at once.
+  static constexpr auto MAX_RADIX_BITS = uint8_t{10};
+
+  // Consecutive partitions are combined into output chunks of at least this many rows (except for the last chunk).
+  static constexpr auto MIN_OUTPUT_CHUNK_SIZE = size_t{65'536};
+
+  // By default, the number of radix bits is chosen based on the size of the smaller input.
+  JoinHash(const std::shared_ptr<const AbstractOperator>& left, const std::shared_ptr<const AbstractOperator>& right,
+           const ColumnID left_column_id, const ColumnID right_column_id,
+           const std::optional<uint8_t> radix_bits = std::nullopt);
+
+ protected:
+  std::shared_ptr<const Table> _on_execute() override;
+
+  template <typename T>
+  std::shared_ptr<const Table> _join();
+
+  const std::optional<uint8_t> _radix_bits;
+};
+
+}  // namespace opossum
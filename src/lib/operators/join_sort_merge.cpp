@@ -0,0 +1,335 @@
+#include "join_sort_merge.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "resolve_type.hpp"
+#include "scheduler/worker_pool.hpp"
+#include "storage/dictionary_segment.hpp"
+#include "storage/pos_list.hpp"
+#include "storage/resolve_attribute_vector_type.hpp"
+#include "storage/segment_iterate.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+namespace {
+
+// A value of the join column together with its position in the input table.
+template <typename T>
+struct SortElement {
+  T value;
+  RowID row_id;
+};
+
+template <typename T>
+bool operator<(const SortElement<T>& lhs, const SortElement<T>& rhs) {
+  return lhs.value < rhs.value;
+}
+
+// Sorted sequences of elements, stored one after the other. The elements of sequence s are at
+// [offsets[s], offsets[s + 1]). Before merging, there is one sequence per input chunk, afterwards one per value range.
+template <typename T>
+struct SortedSequences {
+  std::vector<SortElement<T>> elements;
+  std::vector<size_t> offsets;
+};
+
+// Materializes the join column of the table and sorts the elements of each chunk. As the dictionary of a dictionary
+// segment is sorted, its elements are sorted by counting the value ids, without comparing any values.
+template <typename T>
+SortedSequences<T> sort_chunks(const std::shared_ptr<const Table>& table, const ColumnID column_id) {
+  const auto n_chunks = table->chunk_count();
+  auto chunks = SortedSequences<T>{};
+  chunks.offsets.resize(n_chunks + 1);
+  for (auto chunk_id = ChunkID{0}; chunk_id < n_chunks; ++chunk_id) {
+    chunks.offsets[chunk_id + 1] = chunks.offsets[chunk_id] + table->get_chunk(chunk_id)->size();
+  }
+  chunks.elements.resize(chunks.offsets.back());
+
+  WorkerPool::get().parallel_for(n_chunks, [&](const size_t chunk_index) {
+    const auto chunk_id = static_cast<ChunkID>(chunk_index);
+    const auto segment = table->get_chunk(chunk_id)->get_segment(column_id);
+    auto* const output = chunks.elements.data() + chunks.offsets[chunk_index];
+    const auto output_end = chunks.elements.data() + chunks.offsets[chunk_index + 1];
+
+    if (const auto dictionary_segment = std::dynamic_pointer_cast<const DictionarySegment<T>>(segment)) {
+      const auto& dictionary = dictionary_segment->dictionary();
+      resolve_attribute_vector_type(*dictionary_segment->attribute_vector(), [&](const auto& attribute_vector) {
+        // value_positions[v] is the position of the next element with the
+        // value id v.
+        auto value_positions = std::vector<size_t>(dictionary.size() + 1);
+        for (auto chunk_offset = size_t{0}; chunk_offset < attribute_vector.size(); ++chunk_offset) {
+          ++value_positions[attribute_vector[chunk_offset] + 1];
+        }
+        std::partial_sum(value_positions.cbegin(), value_positions.cend(), value_positions.begin());
+        for (auto chunk_offset = ChunkOffset{0}; chunk_offset < attribute_vector.size(); ++chunk_offset) {
+          const auto value_id = attribute_vector[chunk_offset];
+          output[value_positions[value_id]++] = SortElement<T>{dictionary[value_id], RowID{chunk_id, chunk_offset}};
+        }
+      });
+      return;
+    }
+
+    auto index = size_t{0};
+    segment_iterate<T>(*segment, [&](const auto& position) {
+      output[index++] = SortElement<T>{position.value(), RowID{chunk_id, position.chunk_offset()}};
+    });
+    // clustered chunks do not need to be sorted.
+    if (!std::is_sorted(output, output_end)) {
+      std::sort(output, output_end);
+    }
+  });
+  return chunks;
+}
+
+// Picks splitters that divide the values of both inputs into (at most) partition_count ranges of similar size. Range p
+// holds the values v with splitters[p - 1] <= v < splitters[p]. The splitters are picked from evenly spaced samples
+// of the sorted chunks. As the samples are taken across all chunks, they represent the distribution of the values.
+template <typename T>
+std::vector<T> pick_splitters(const SortedSequences<T>& left_chunks, const SortedSequences<T>& right_chunks,
+                              const size_t partition_count) {
+  constexpr auto SAMPLES_PER_PARTITION = size_t{16};
+  if (partition_count <= 1) return {};
+
+  auto samples = std::vector<T>{};
+  for (const auto* chunks : {&left_chunks, &right_chunks}) {
+    const auto element_count = chunks->elements.size();
+    const auto sample_count = std::min(element_count, partition_count * SAMPLES_PER_PARTITION);
+    for (auto sample_index = size_t{0}; sample_index < sample_count; ++sample_index) {
+      samples.push_back(chunks->elements[sample_index * element_count / sample_count].value);
+    }
+  }
+  if (samples.empty()) return {};
+  std::sort(samples.begin(), samples.end());
+
+  auto splitters = std::vector<T>{};
+  for (auto partition_index = size_t{1}; partition_index < partition_count; ++partition_index) {
+    const auto& splitter = samples[partition_index * samples.size() / partition_count];
+    // equal splitters would only create empty ranges.
+    if (splitters.empty() || splitters.back() < splitter) {
+      splitters.push_back(splitter);
+    }
+  }
+  return splitters;
+}
+
+// Splits the sorted chunks into the value ranges given by the splitters and merges the parts of each range, so that
+// all elements are sorted afterwards. The ranges are merged in parallel.
+template <typename T>
+SortedSequences<T> merge_chunks(SortedSequences<T>& chunks, const std::vector<T>& splitters) {
+  const auto n_chunks = chunks.offsets.size() - 1;
+  const auto n_partitions = splitters.size() + 1;
+
+  // the part of chunk c in range p is at [bounds[c][p], bounds[c][p + 1]).
+  auto bounds = std::vector<std::vector<size_t>>(n_chunks, std::vector<size_t>(n_partitions + 1));
+  WorkerPool::get().parallel_for(n_chunks, [&](const size_t chunk_index) {
+    auto& chunk_bounds = bounds[chunk_index];
+    const auto chunk_end = chunks.elements.cbegin() + chunks.offsets[chunk_index + 1];
+    chunk_bounds.front() = chunks.offsets[chunk_index];
+    for (auto partition_index = size_t{1}; partition_index < n_partitions; ++partition_index) {
+      const auto part_begin = chunks.elements.cbegin() + chunk_bounds[partition_index - 1];
+      const auto part_end =
+          std::lower_bound(part_begin, chunk_end, splitters[partition_index - 1],
+                           [](const SortElement<T>& element, const T& splitter) { return element.value < splitter; });
+      chunk_bounds[partition_index] = std::distance(chunks.elements.cbegin(), part_end);
+    }
+    chunk_bounds.back() = std::distance(chunks.elements.cbegin(), chunk_end);
+  });
+
+  auto partitions = SortedSequences<T>{};
+  partitions.offsets.resize(n_partitions + 1);
+  for (auto partition_index = size_t{0}; partition_index < n_partitions; ++partition_index) {
+    auto partition_size = size_t{0};
+    for (const auto& chunk_bounds : bounds) {
+      partition_size += chunk_bounds[partition_index + 1] - chunk_bounds[partition_index];
+    }
+    partitions.offsets[partition_index + 1] = partitions.offsets[partition_index] + partition_size;
+  }
+  partitions.elements.resize(partitions.offsets.back());
+
+  WorkerPool::get().parallel_for(n_partitions, [&](const size_t partition_index) {
+    const auto output = partitions.elements.begin() + partitions.offsets[partition_index];
+
+    // the parts of the chunks are copied one after the other and merged
+    // pairwise until one sorted sequence remains.
+    auto part_ends = std::vector<size_t>{0};
+    for (const auto& chunk_bounds : bounds) {
+      const auto part_begin = chunks.elements.begin() + chunk_bounds[partition_index];
+      const auto part_end = chunks.elements.begin() + chunk_bounds[partition_index + 1];
+      if (part_begin == part_end) continue;
+      std::move(part_begin, part_end, output + part_ends.back());
+      part_ends.push_back(part_ends.back() + std::distance(part_begin, part_end));
+    }
+
+    while (part_ends.size() > 2) {
+      auto merged_part_ends = std::vector<size_t>{0};
+      const auto part_count = part_ends.size() - 1;
+      for (auto part_index = size_t{0}; part_index < part_count; part_index += 2) {
+        if (part_index + 1 < part_count) {
+          std::inplace_merge(output + part_ends[part_index], output + part_ends[part_index + 1],
+                             output + part_ends[part_index + 2]);
+          merged_part_ends.push_back(part_ends[part_index + 2]);
+        } else {
+          merged_part_ends.push_back(part_ends[part_index + 1]);
+        }
+      }
+      part_ends = std::move(merged_part_ends);
+    }
+  });
+
+  chunks = {};
+  return partitions;
+}
+
+// The matching rows of a value range.
+struct PartitionMatches {
+  std::vector<RowID> left_row_ids;
+  std::vector<RowID> right_row_ids;
+};
+
+// Joins the left elements of the value range partition_index with the right elements. For each distinct left value,
+// the equal right values are found by merging with the right elements of the same range. All smaller right values
+// are before them and all larger ones after them, so each scan type matches at most two ranges of right elements.
+template <typename T>
+PartitionMatches join_partition(const SortedSequences<T>& left, const SortedSequences<T>& right,
+                                const size_t partition_index, const ScanType scan_type) {
+  auto matches = PartitionMatches{};
+  const auto& right_elements = right.elements;
+  const auto right_count = right_elements.size();
+
+  const auto append_matches = [&](const size_t left_begin, const size_t left_end, const size_t right_begin,
+                                  const size_t right_end) {
+    if (right_begin == right_end) return;
+    for (auto left_index = left_begin; left_index < left_end; ++left_index) {
+      matches.left_row_ids.insert(matches.left_row_ids.end(), right_end - right_begin,
+                                  left.elements[left_index].row_id);
+      for (auto right_index = right_begin; right_index < right_end; ++right_index) {
+        matches.right_row_ids.push_back(right_elements[right_index].row_id);
+      }
+    }
+  };
+
+  auto right_position = right.offsets[partition_index];
+  const auto right_partition_end = right.offsets[partition_index + 1];
+  const auto left_partition_end = left.offsets[partition_index + 1];
+  for (auto run_begin = left.offsets[partition_index]; run_begin < left_partition_end;) {
+    const auto& value = left.elements[run_begin].value;
+    auto run_end = run_begin + 1;
+    while (run_end < left_partition_end && !(value < left.elements[run_end].value)) {
+      ++run_end;
+    }
+
+    while (right_position < right_partition_end && right_elements[right_position].value < value) {
+      ++right_position;
+    }
+    const auto equal_begin = right_position;
+    while (right_position < right_partition_end && !(value < right_elements[right_position].value)) {
+      ++right_position;
+    }
+    const auto equal_end = right_position;
+
+    switch (scan_type) {
+      case ScanType::OpEquals:
+        append_matches(run_begin, run_end, equal_begin, equal_end);
+        break;
+      case ScanType::OpNotEquals:
+        append_matches(run_begin, run_end, 0, equal_begin);
+        append_matches(run_begin, run_end, equal_end, right_count);
+        break;
+      case ScanType::OpLessThan:
+        append_matches(run_begin, run_end, equal_end, right_count);
+        break;
+      case ScanType::OpLessThanEquals:
+        append_matches(run_begin, run_end, equal_begin, right_count);
+        break;
+      case ScanType::OpGreaterThan:
+        append_matches(run_begin, run_end, 0, equal_begin);
+        break;
+      case ScanType::OpGreaterThanEquals:
+        append_matches(run_begin, run_end, 0, equal_end);
+        break;
+    }
+    run_begin = run_end;
+  }
+  return matches;
+}
+
+}  // namespace
+
+JoinSortMerge::JoinSortMerge(const std::shared_ptr<const AbstractOperator>& left,
+                             const std::shared_ptr<const AbstractOperator>& right, const ColumnID left_column_id,
+                             const ColumnID right_column_id, const ScanType scan_type,
+                             const std::optional<size_t> partition_count)
+    : AbstractJoinOperator{left, right, left_column_id, right_column_id, scan_type},
+      _partition_count{partition_count} {
+  Assert(!partition_count || *partition_count > 0, "At least one partition is needed");
+}
+
+std::shared_ptr<const Table> JoinSortMerge::_on_execute() {
+  const auto& data_type = _left_input_table()->column_type(_left_column_id);
+  Assert(data_type == _right_input_table()->column_type(_right_column_id),
+         "The join columns must have the same data type");
+
+  auto output = std::shared_ptr<const Table>{};
+  resolve_data_type(data_type, [&](auto type) {
+    using Type = typename decltype(type)::type;
+    output = _join<Type>();
+  });
+  return output;
+}
+
+template <typename T>
+std::shared_ptr<const Table> JoinSortMerge::_join() {
+  auto left_chunks = sort_chunks<T>(_left_input_table(), _left_column_id);
+  auto right_chunks = sort_chunks<T>(_right_input_table(), _right_column_id);
+
+  const auto row_count = left_chunks.elements.size() + right_chunks.elements.size();
+  const auto partition_count = _partition_count.value_or(
+      std::max(std::min(row_count / MIN_PARTITION_SIZE, WorkerPool::get().worker_count()), size_t{1}));
+  const auto splitters = pick_splitters(left_chunks, right_chunks, partition_count);
+  const auto left_partitions = merge_chunks(left_chunks, splitters);
+  const auto right_partitions = merge_chunks(right_chunks, splitters);
+
+  const auto n_partitions = splitters.size() + 1;
+  auto partition_matches = std::vector<PartitionMatches>(n_partitions);
+  WorkerPool::get().parallel_for(n_partitions, [&](const size_t partition_index) {
+    partition_matches[partition_index] = join_partition(left_partitions, right_partitions, partition_index, _scan_type);
+  });
+
+  // consecutive value ranges are combined into output chunks, which keeps
+  // the output ordered by the left join values.
+  auto left_pos_lists = std::vector<std::shared_ptr<const PosList>>{};
+  auto right_pos_lists = std::vector<std::shared_ptr<const PosList>>{};
+  auto left_row_ids = std::vector<RowID>{};
+  auto right_row_ids = std::vector<RowID>{};
+  for (auto partition_index = size_t{0}; partition_index < n_partitions; ++partition_index) {
+    auto& matches = partition_matches[partition_index];
+    if (left_row_ids.empty()) {
+      left_row_ids = std::move(matches.left_row_ids);
+      right_row_ids = std::move(matches.right_row_ids);
+    } else {
+      left_row_ids.insert(left_row_ids.end(), matches.left_row_ids.cbegin(), matches.left_row_ids.cend());
+      right_row_ids.insert(right_row_ids.end(), matches.right_row_ids.cbegin(), matches.right_row_ids.cend());
+    }
+    matches = {};
+
+    const auto is_last_partition = partition_index + 1 == n_partitions;
+    if (left_row_ids.size() >= MIN_OUTPUT_CHUNK_SIZE || (is_last_partition && !left_row_ids.empty())) {
+      left_pos_lists.emplace_back(std::make_shared<PosList>(std::move(left_row_ids)));
+      right_pos_lists.emplace_back(std::make_shared<PosList>(std::move(right_row_ids)));
+      left_row_ids = {};
+      right_row_ids = {};
+    }
+  }
+
+  return _build_output_table(left_pos_lists, right_pos_lists);
+}
+
+}  // namespace opossum
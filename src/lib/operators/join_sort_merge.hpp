@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+
+#include "abstract_join_operator.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+// Join that sorts both inputs by their join values and merges them. Unlike JoinHash, it supports all scan types, so it
+// also handles band and range joins, e.g., "left value < right value".
+//
+// Both join columns are materialized chunk by chunk as pairs of value and RowID and sorted per chunk on the WorkerPool.
+// Dictionary segments are sorted by counting their value ids, as the dictionary is already in order, and chunks whose
+// values are already in order are not sorted at all. The sorted chunks of both inputs are then split into value
+// ranges by splitters sampled from their values, and the chunks of each range are merged in parallel. Hence, equal
+// values of both inputs end up in the same range, and the ranges can be joined concurrently: The matches of equal
+// values are found within a range, whereas the right rows that are smaller or larger than a left value are found in
+// the ranges before or after it.
+//
+// The output rows are ordered by the join value of the left input.
+class JoinSortMerge : public AbstractJoinOperator {
+ public:
+  // By default, each value range holds at least this many rows of both inputs together, and there are at most as many
+  // value ranges as workers.
+  static constexpr auto MIN_PARTITION_SIZE = size_t{65'536};
+
+  // Consecutive value ranges are combined into output chunks of at least this many rows (except for the last chunk).
+  static constexpr auto MIN_OUTPUT_CHUNK_SIZE = size_t{65'536};
+
+  // By default, the number of value ranges is chosen based on the size of the inputs and the number of workers.
+  JoinSortMerge(const std::shared_ptr<const AbstractOperator>& left,
+                const std::shared_ptr<const AbstractOperator>& right, const ColumnID left_column_id,
+                const ColumnID right_column_id, const ScanType scan_type,
+                const std::optional<size_t> partition_count = std::nullopt);
+
+ protected:
+  std::shared_ptr<const Table> _on_execute() override;
+
+  template <typename T>
+  std::shared_ptr<const Table> _join();
+
+  const std::optional<size_t> _partition_count;
+};
+
+}  // namespace opossum
@@ -0,0 +1,62 @@
+#include "normalized_keys.hpp"
+
+#include <algorithm>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "resolve_type.hpp"
+#include "storage/segment_iterate.hpp"
+
+namespace opossum {
+
+NormalizedKeys encode_normalized_keys(const Table& table, const Chunk& chunk,
+                                      const std::vector<SortColumnDefinition>& definitions) {
+  const auto row_count = size_t{chunk.size()};
+  auto keys = NormalizedKeys{};
+  auto& key_offsets = keys.key_offsets;
+  key_offsets.resize(row_count + 1);
+
+  // the keys of numeric columns have a fixed size, only strings need to be
+  // looked at to determine the size of the keys.
+  auto fixed_key_size = size_t{0};
+  for (const auto& definition : definitions) {
+    resolve_data_type(table.column_type(definition.column_id), [&](auto type) {
+      using Type = typename decltype(type)::type;
+      if constexpr (std::is_same_v<Type, std::string>) {
+        segment_iterate<Type>(*chunk.get_segment(definition.column_id), [&](const auto& position) {
+          key_offsets[position.chunk_offset() + 1] += normalized_key_size(position.value());
+        });
+      } else {
+        fixed_key_size += sizeof(Type);
+      }
+    });
+  }
+  for (auto row = size_t{0}; row < row_count; ++row) {
+    key_offsets[row + 1] += key_offsets[row] + fixed_key_size;
+  }
+
+  keys.key_data.resize(key_offsets.back());
+  auto* key_data = keys.key_data.data();
+  auto write_offsets = std::vector<size_t>(key_offsets.cbegin(), key_offsets.cend() - 1);
+  for (const auto& definition : definitions) {
+    const auto descending = definition.sort_mode == SortMode::Descending;
+    resolve_data_type(table.column_type(definition.column_id), [&](auto type) {
+      using Type = typename decltype(type)::type;
+      segment_iterate<Type>(*chunk.get_segment(definition.column_id), [&](const auto& position) {
+        auto& write_offset = write_offsets[position.chunk_offset()];
+        auto* const key_begin = key_data + write_offset;
+        auto* const key_end = write_normalized_key(position.value(), key_begin);
+        // inverting the bytes reverses the order of the keys, as none of
+        // them is a prefix of another.
+        if (descending) {
+          std::transform(key_begin, key_end, key_begin, [](const uint8_t byte) { return static_cast<uint8_t>(~byte); });
+        }
+        write_offset += key_end - key_begin;
+      });
+    });
+  }
+  return keys;
+}
+
+}  // namespace opossum
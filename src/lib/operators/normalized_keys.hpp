@@ -0,0 +1,90 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "sort.hpp"
+#include "storage/table.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+// A normalized key encodes the values of the sort columns of a row into a byte string whose order under memcmp is the
+// order of the rows, so that rows can be compared without knowing the data types of the sort columns. The encodings of
+// the single values are prefix-free, i.e., no key is a prefix of another key.
+
+// Returns the number of bytes of the normalized key of a value.
+template <typename T>
+size_t normalized_key_size(const T& value) {
+  if constexpr (std::is_same_v<T, std::string>) {
+    return value.size() + std::count(value.cbegin(), value.cend(), '\0') + 2;
+  } else {
+    return sizeof(T);
+  }
+}
+
+// Writes the normalized key of a value to output and returns the end of the key. The keys of two values compare like
+// the values under memcmp. Integers are written big-endian, with their sign bit inverted, so that negative numbers come
+// first. Negative floating-point numbers have all their bits inverted, as a larger magnitude means a smaller number.
+// Strings end with two zero bytes, and a zero byte within a string is written as 0x00 0xFF, so that a string compares
+// smaller than all strings that it is a prefix of.
+template <typename T>
+uint8_t* write_normalized_key(const T& value, uint8_t* output) {
+  if constexpr (std::is_same_v<T, std::string>) {
+    for (const auto character : value) {
+      *output++ = static_cast<uint8_t>(character);
+      if (character == '\0') *output++ = 0xFF;
+    }
+    *output++ = 0x00;
+    *output++ = 0x00;
+    return output;
+  } else {
+    using Bits = std::conditional_t<sizeof(T) == 8, uint64_t, uint32_t>;
+    static_assert(sizeof(T) == sizeof(Bits), "Unexpected size of a numeric type");
+    constexpr auto SIGN_BIT = Bits{1} << (sizeof(Bits) * 8 - 1);
+
+    auto bits = Bits{};
+    if constexpr (std::is_floating_point_v<T>) {
+      // -0.0 equals 0.0 and must have the same key.
+      const auto normalized_value = value == T{0} ? T{0} : value;
+      std::memcpy(&bits, &normalized_value, sizeof(Bits));
+      bits = (bits & SIGN_BIT) ? ~bits : bits | SIGN_BIT;
+    } else {
+      bits = static_cast<Bits>(value) ^ SIGN_BIT;
+    }
+    for (auto byte_index = sizeof(Bits); byte_index > 0; --byte_index) {
+      *output++ = static_cast<uint8_t>(bits >> ((byte_index - 1) * 8));
+    }
+    return output;
+  }
+}
+
+// Returns the normalized key of a single value of a sort column.
+template <typename T>
+std::string normalized_key(const T& value, const SortMode sort_mode) {
+  auto key = std::string(normalized_key_size(value), '\0');
+  auto* const key_begin = reinterpret_cast<uint8_t*>(key.data());
+  auto* const key_end = write_normalized_key(value, key_begin);
+  if (sort_mode == SortMode::Descending) {
+    std::transform(key_begin, key_end, key_begin, [](const uint8_t byte) { return static_cast<uint8_t>(~byte); });
+  }
+  return key;
+}
+
+// The normalized keys of the rows of a chunk, stored one after the other. The key of the row at chunk offset r is
+// key_data[key_offsets[r], key_offsets[r + 1]).
+struct NormalizedKeys {
+  std::vector<uint8_t> key_data;
+  std::vector<size_t> key_offsets;
+};
+
+// Encodes the values of the sort columns of each row of the chunk into a normalized key. The keys are built column by
+// column, so that each segment is iterated once and the data type is only resolved per segment.
+NormalizedKeys encode_normalized_keys(const Table& table, const Chunk& chunk,
+                                      const std::vector<SortColumnDefinition>& definitions);
+
+}  // namespace opossum
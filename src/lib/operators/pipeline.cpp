@@ -0,0 +1,140 @@
+#include "pipeline.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "scheduler/worker_pool.hpp"
+#include "storage/pos_list.hpp"
+#include "table_scan.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+namespace {
+
+std::shared_ptr<const AbstractOperator> first_input(
+    const std::vector<std::shared_ptr<AbstractPipelineOperator>>& operators) {
+  Assert(!operators.empty(), "A pipeline needs at least one operator");
+  return operators.front()->left_input();
+}
+
+}  // namespace
+
+Pipeline::Pipeline(const std::vector<std::shared_ptr<AbstractPipelineOperator>>& operators,
+                   const ChunkOffset morsel_size, const Mode mode)
+    : AbstractOperator{first_input(operators)}, _operators{operators}, _morsel_size{morsel_size}, _mode{mode} {
+  Assert(_morsel_size > 0 && _morsel_size % 64 == 0, "The morsel size must be a positive multiple of 64");
+  for (auto operator_index = size_t{1}; operator_index < _operators.size(); ++operator_index) {
+    Assert(_operators[operator_index]->left_input() == _operators[operator_index - 1],
+           "Each operator of a pipeline must be the input of the next one");
+  }
+}
+
+const std::vector<std::shared_ptr<AbstractPipelineOperator>>& Pipeline::operators() const { return _operators; }
+
+ChunkOffset Pipeline::morsel_size() const { return _morsel_size; }
+
+Pipeline::Mode Pipeline::mode() const { return _mode; }
+
+std::shared_ptr<const Table> Pipeline::_on_execute() {
+  const auto in_table_ptr = _left_input_table();
+  const auto n_chunks = in_table_ptr->chunk_count();
+
+  // the morsels of a chunk are consecutive and start at multiples of 64, so
+  // that their bitmasks can simply be concatenated afterwards.
+  auto morsels = std::vector<Morsel>{};
+  auto first_morsel_indexes = std::vector<size_t>(n_chunks + 1);
+  for (auto chunk_id = ChunkID{0}; chunk_id < n_chunks; ++chunk_id) {
+    first_morsel_indexes[chunk_id] = morsels.size();
+    const auto chunk_size = in_table_ptr->get_chunk(chunk_id)->size();
+    for (auto begin = ChunkOffset{0}; begin < chunk_size;) {
+      const auto end = static_cast<ChunkOffset>(begin + std::min(_morsel_size, chunk_size - begin));
+      morsels.emplace_back(Morsel{chunk_id, begin, end, {}});
+      begin = end;
+    }
+  }
+  first_morsel_indexes[n_chunks] = morsels.size();
+
+  WorkerPool::get().parallel_for(morsels.size(), [&](const size_t morsel_index) {
+    if (_mode == Mode::Batches) {
+      _process_morsel_in_batches(in_table_ptr, morsels[morsel_index]);
+    } else {
+      _process_morsel(in_table_ptr, morsels[morsel_index]);
+    }
+  });
+
+  auto result_chunks = std::vector<std::shared_ptr<Chunk>>(n_chunks);
+  WorkerPool::get().parallel_for(n_chunks, [&](const size_t chunk_index) {
+    const auto chunk_id = static_cast<ChunkID>(chunk_index);
+    const auto chunk_ptr = in_table_ptr->get_chunk(chunk_id);
+    const auto chunk_size = chunk_ptr->size();
+
+    auto bitmask = std::vector<uint64_t>{};
+    bitmask.reserve((chunk_size + 63) / 64);
+    for (auto morsel_index = first_morsel_indexes[chunk_index]; morsel_index < first_morsel_indexes[chunk_index + 1];
+         ++morsel_index) {
+      bitmask.insert(bitmask.end(), morsels[morsel_index].bitmask.cbegin(), morsels[morsel_index].bitmask.cend());
+    }
+
+    const auto matches = TableScan::matches_from_bitmask(chunk_id, std::move(bitmask), chunk_size);
+    if (matches->empty()) return;
+    result_chunks[chunk_index] = TableScan::subset_chunk(in_table_ptr, chunk_ptr, matches);
+  });
+  std::erase(result_chunks, nullptr);
+
+  const auto output = result_chunks.empty() ? std::make_shared<Table>(in_table_ptr)
+                                            : std::make_shared<Table>(result_chunks, in_table_ptr);
+  _operators.back()->_output = output;
+  return output;
+}
+
+void Pipeline::_process_morsel(const std::shared_ptr<const Table>& table, Morsel& morsel) const {
+  // the morsel starts with all its rows and passes through the operators
+  // until no row remains.
+  const auto n_rows = size_t{morsel.end - morsel.begin};
+  morsel.bitmask.assign((n_rows + 63) / 64, ~uint64_t{0});
+  if (n_rows % 64 != 0) {
+    morsel.bitmask.back() = (uint64_t{1} << (n_rows % 64)) - 1;
+  }
+  for (const auto& pipeline_operator : _operators) {
+    pipeline_operator->process_morsel(table, morsel);
+    if (std::all_of(morsel.bitmask.cbegin(), morsel.bitmask.cend(), [](const auto word) { return word == 0; })) {
+      return;
+    }
+  }
+}
+
+void Pipeline::_process_morsel_in_batches(const std::shared_ptr<const Table>& table, Morsel& morsel) const {
+  // the remaining rows of each batch are set in the bitmask of the morsel.
+  // Batches start at multiples of 64 within the morsel, like morsels
+  // within the chunk.
+  static_assert(Batch::MAX_SIZE % 64 == 0, "Batches must fill whole bitmask words");
+  morsel.bitmask.assign((morsel.end - morsel.begin + 63) / 64, uint64_t{0});
+  for (auto begin = morsel.begin; begin < morsel.end;) {
+    const auto end = static_cast<ChunkOffset>(begin + std::min(Batch::MAX_SIZE, morsel.end - begin));
+    auto batch = Batch{table, morsel.chunk_id, begin, end};
+    for (const auto& pipeline_operator : _operators) {
+      pipeline_operator->process_batch(batch);
+      if (batch.selection().empty()) break;
+    }
+
+    // the bits of a word are collected in a register, so that consecutive
+    // offsets do not wait for each other's store to the same word.
+    auto* bitmask = morsel.bitmask.data() + (begin - morsel.begin) / 64;
+    auto word_index = size_t{0};
+    auto word = uint64_t{0};
+    for (const auto offset : batch.selection()) {
+      if (offset / 64 != word_index) {
+        bitmask[word_index] = word;
+        word_index = offset / 64;
+        word = 0;
+      }
+      word |= uint64_t{1} << (offset % 64);
+    }
+    bitmask[word_index] = word;
+    begin = end;
+  }
+}
+
+}  // namespace opossum
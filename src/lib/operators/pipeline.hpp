@@ -0,0 +1,56 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "abstract_operator.hpp"
+#include "abstract_pipeline_operator.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+// Executes a chain of pipeline operators, e.g., several TableScans on top of each other, without materializing the
+// outputs of the inner operators. The chunks of the input table of the first operator are split into morsels of at
+// most morsel_size rows, which must be a multiple of 64. Each morsel tracks its remaining rows in a bitmask. Each
+// morsel is pushed through all operators by one worker of the WorkerPool, so that the rows stay in the caches of that
+// worker from the first to the last operator. Only the rows that remain after the last operator are materialized, as
+// one output chunk per input chunk with matching rows, like a TableScan does.
+//
+// With Mode::Batches, each morsel is further split into Batches, which the operators process vector at a time: The
+// columns that the operators read are decoded into vectors of at most Batch::MAX_SIZE values and the remaining rows
+// are tracked in a selection vector. With Mode::Morsels, the operators process the whole morsel and read its rows from
+// the segments directly.
+//
+// Operators that need to see their whole input first, e.g., hash builds, aggregates, or sorts, are not pipeline
+// operators. They break pipelines and consume the output of the pipeline below them. OperatorTask can create the
+// pipelines of a query plan automatically (see OperatorTask::ExecutionMode::Pipelined).
+//
+// The output of the pipeline is also set as the output of its last operator, so that consumers of that operator do
+// not need to know about the pipeline. The inner operators have no output and must not have other consumers.
+class Pipeline : public AbstractOperator {
+ public:
+  static constexpr auto DEFAULT_MORSEL_SIZE = ChunkOffset{16'384};
+
+  enum class Mode { Morsels, Batches };
+
+  // The operators are ordered from the first to the last one, and each operator must be the left input of the next.
+  explicit Pipeline(const std::vector<std::shared_ptr<AbstractPipelineOperator>>& operators,
+                    const ChunkOffset morsel_size = DEFAULT_MORSEL_SIZE, const Mode mode = Mode::Morsels);
+
+  const std::vector<std::shared_ptr<AbstractPipelineOperator>>& operators() const;
+  ChunkOffset morsel_size() const;
+  Mode mode() const;
+
+ protected:
+  std::shared_ptr<const Table> _on_execute() override;
+
+  // Passes the morsel through the operators and clears the bits of the rows that they filter out.
+  void _process_morsel(const std::shared_ptr<const Table>& table, Morsel& morsel) const;
+  void _process_morsel_in_batches(const std::shared_ptr<const Table>& table, Morsel& morsel) const;
+
+  std::vector<std::shared_ptr<AbstractPipelineOperator>> _operators;
+  ChunkOffset _morsel_size;
+  Mode _mode;
+};
+
+}  // namespace opossum
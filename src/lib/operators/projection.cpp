@@ -0,0 +1,381 @@
+#include "projection.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "resolve_type.hpp"
+#include "scheduler/worker_pool.hpp"
+#include "simd_scan_kernels.hpp"
+#include "storage/pos_list.hpp"
+#include "storage/reference_segment.hpp"
+#include "storage/segment_iterate.hpp"
+#include "storage/value_segment.hpp"
+#include "type_comparison.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+namespace {
+
+// The values of an expression for all rows of a block.
+template <typename T>
+struct ExpressionValues {
+  const T* data() const { return borrowed_values ? borrowed_values : values.data(); }
+
+  // literals are not repeated for each row.
+  bool is_constant{false};
+  T constant{};
+
+  // the values of ValueSegments are read in place instead of being copied.
+  const T* borrowed_values{nullptr};
+  std::vector<T> values{};
+};
+
+// The rows of a chunk that an expression is evaluated for.
+struct BlockContext {
+  // the data type of each node of the expressions.
+  const std::unordered_map<const Expression*, std::string>& data_types;
+
+  // the values of the columns that the expressions read, see decode_columns.
+  const std::vector<std::shared_ptr<const AbstractSegment>>& columns;
+
+  ChunkOffset begin;
+  size_t n_rows;
+
+  // the rows whose values are actually used, i.e., those that the enclosing
+  // CASEs select, or nullptr for all rows.
+  const int32_t* used_rows{nullptr};
+};
+
+template <typename T>
+ExpressionValues<T> evaluate(const Expression& expression, const BlockContext& context);
+
+// Returns whether any of the rows with a zero divisor is used, in which case
+// the division fails.
+template <typename T>
+bool divides_by_zero(const ExpressionValues<T>& divisors, const BlockContext& context) {
+  const auto n_rows = context.n_rows;
+  if (divisors.is_constant) {
+    if (divisors.constant != 0) return false;
+    return !context.used_rows ||
+           std::any_of(context.used_rows, context.used_rows + n_rows, [](const int32_t used) { return used != 0; });
+  }
+  const auto* divisor_values = divisors.data();
+  for (auto row = size_t{0}; row < n_rows; ++row) {
+    if (divisor_values[row] == 0 && (!context.used_rows || context.used_rows[row])) return true;
+  }
+  return false;
+}
+
+// Returns function(left[row], right[row]) for each row. The loops for vectors
+// and constants are separate, so that each of them compiles to a simple loop
+// over arrays.
+template <typename Result, typename Left, typename Right, typename Function>
+ExpressionValues<Result> combine(const ExpressionValues<Left>& left, const ExpressionValues<Right>& right,
+                                 const size_t n_rows, const Function& function) {
+  auto result = ExpressionValues<Result>{};
+  if (left.is_constant && right.is_constant) {
+    result.is_constant = true;
+    result.constant = function(left.constant, right.constant);
+    return result;
+  }
+
+  result.values.resize(n_rows);
+  auto* output = result.values.data();
+  if (left.is_constant) {
+    const auto& left_value = left.constant;
+    const auto* right_values = right.data();
+    for (auto row = size_t{0}; row < n_rows; ++row) {
+      output[row] = function(left_value, right_values[row]);
+    }
+  } else if (right.is_constant) {
+    const auto* left_values = left.data();
+    const auto& right_value = right.constant;
+    for (auto row = size_t{0}; row < n_rows; ++row) {
+      output[row] = function(left_values[row], right_value);
+    }
+  } else {
+    const auto* left_values = left.data();
+    const auto* right_values = right.data();
+    for (auto row = size_t{0}; row < n_rows; ++row) {
+      output[row] = function(left_values[row], right_values[row]);
+    }
+  }
+  return result;
+}
+
+template <typename T>
+ExpressionValues<T> column_values(const ColumnID column_id, const BlockContext& context) {
+  const auto& column = static_cast<const ValueSegment<T>&>(*context.columns[column_id]);
+  auto result = ExpressionValues<T>{};
+  result.borrowed_values = column.values().data() + context.begin;
+  return result;
+}
+
+template <typename T>
+ExpressionValues<T> arithmetic_values(const Expression& expression, const BlockContext& context) {
+  const auto left = evaluate<T>(*expression.arguments()[0], context);
+  const auto right = evaluate<T>(*expression.arguments()[1], context);
+  switch (expression.arithmetic_operator()) {
+    case ArithmeticOperator::Addition:
+      return combine<T>(left, right, context.n_rows, std::plus<T>{});
+    case ArithmeticOperator::Subtraction:
+      return combine<T>(left, right, context.n_rows, std::minus<T>{});
+    case ArithmeticOperator::Multiplication:
+      return combine<T>(left, right, context.n_rows, std::multiplies<T>{});
+    case ArithmeticOperator::Division:
+      if constexpr (std::is_integral_v<T>) {
+        Assert(!divides_by_zero(right, context), "Integer division by zero");
+        // rows that no CASE selects may still divide by zero, their result is
+        // never used.
+        return combine<T>(left, right, context.n_rows,
+                          [](const T dividend, const T divisor) { return divisor == 0 ? T{0} : dividend / divisor; });
+      } else {
+        return combine<T>(left, right, context.n_rows, std::divides<T>{});
+      }
+  }
+  Fail("Unknown arithmetic operator");
+}
+
+ExpressionValues<int32_t> comparison_values(const Expression& expression, const BlockContext& context) {
+  const auto& arguments = expression.arguments();
+  const auto& left_data_type = context.data_types.at(arguments[0].get());
+  const auto common_data_type = left_data_type == "string"
+                                    ? left_data_type
+                                    : wider_data_type(left_data_type, context.data_types.at(arguments[1].get()));
+
+  auto result = ExpressionValues<int32_t>{};
+  resolve_data_type(common_data_type, [&](auto type) {
+    using Type = typename decltype(type)::type;
+    const auto left = evaluate<Type>(*arguments[0], context);
+    const auto right = evaluate<Type>(*arguments[1], context);
+    with_comparator(expression.scan_type(), [&](auto comparator) {
+      result = combine<int32_t>(left, right, context.n_rows, [&](const auto& left_value, const auto& right_value) {
+        return static_cast<int32_t>(comparator(left_value, right_value));
+      });
+    });
+  });
+  return result;
+}
+
+// Appends the value of each of the n_rows rows to output, repeating constants.
+template <typename T>
+void append_values(const ExpressionValues<T>& values, const size_t n_rows, std::vector<T>& output) {
+  if (values.is_constant) {
+    output.insert(output.end(), n_rows, values.constant);
+  } else {
+    output.insert(output.end(), values.data(), values.data() + n_rows);
+  }
+}
+
+template <typename T>
+ExpressionValues<T> case_values(const Expression& expression, const BlockContext& context) {
+  const auto& arguments = expression.arguments();
+  const auto condition = evaluate<int32_t>(*arguments[0], context);
+  if (condition.is_constant) return evaluate<T>(*arguments[condition.constant ? 1 : 2], context);
+
+  // both results are computed for all rows, which keeps the selection free
+  // of branches. The rows that each of them is used for are passed on.
+  const auto n_rows = context.n_rows;
+  const auto* conditions = condition.data();
+  auto then_rows = std::vector<int32_t>(n_rows);
+  auto else_rows = std::vector<int32_t>(n_rows);
+  for (auto row = size_t{0}; row < n_rows; ++row) {
+    const auto used = !context.used_rows || context.used_rows[row];
+    then_rows[row] = used && conditions[row];
+    else_rows[row] = used && !conditions[row];
+  }
+  auto then_context = context;
+  then_context.used_rows = then_rows.data();
+  auto else_context = context;
+  else_context.used_rows = else_rows.data();
+  auto then_values = std::vector<T>{};
+  append_values(evaluate<T>(*arguments[1], then_context), n_rows, then_values);
+  auto else_values = std::vector<T>{};
+  append_values(evaluate<T>(*arguments[2], else_context), n_rows, else_values);
+
+  auto result = ExpressionValues<T>{};
+  result.values.resize(n_rows);
+  for (auto row = size_t{0}; row < n_rows; ++row) {
+    result.values[row] = conditions[row] ? then_values[row] : else_values[row];
+  }
+  return result;
+}
+
+// Evaluates an expression whose data type is T.
+template <typename T>
+ExpressionValues<T> evaluate_as_data_type(const Expression& expression, const BlockContext& context) {
+  switch (expression.type()) {
+    case ExpressionType::Column:
+      return column_values<T>(expression.column_id(), context);
+    case ExpressionType::Value: {
+      auto result = ExpressionValues<T>{};
+      result.is_constant = true;
+      result.constant = boost::get<T>(expression.value());
+      return result;
+    }
+    case ExpressionType::Arithmetic:
+      if constexpr (std::is_arithmetic_v<T>) {
+        return arithmetic_values<T>(expression, context);
+      } else {
+        Fail("Arithmetic is only supported for numbers");
+      }
+    case ExpressionType::Comparison:
+      if constexpr (std::is_same_v<T, int32_t>) {
+        return comparison_values(expression, context);
+      } else {
+        Fail("Comparisons yield ints");
+      }
+    case ExpressionType::Case:
+      return case_values<T>(expression, context);
+  }
+  Fail("Unknown expression type");
+}
+
+// Evaluates an expression and converts its values to T, e.g., to combine an
+// int column with a double.
+template <typename T>
+ExpressionValues<T> evaluate(const Expression& expression, const BlockContext& context) {
+  auto result = ExpressionValues<T>{};
+  resolve_data_type(context.data_types.at(&expression), [&](auto type) {
+    using Type = typename decltype(type)::type;
+    auto values = evaluate_as_data_type<Type>(expression, context);
+    if constexpr (std::is_same_v<Type, T>) {
+      result = std::move(values);
+    } else if constexpr (std::is_arithmetic_v<Type> && std::is_arithmetic_v<T>) {
+      result.is_constant = values.is_constant;
+      result.constant = static_cast<T>(values.constant);
+      if (values.is_constant) return;
+      const auto* input = values.data();
+      result.values.resize(context.n_rows);
+      std::transform(input, input + context.n_rows, result.values.begin(),
+                     [](const Type value) { return static_cast<T>(value); });
+    } else {
+      Fail("Strings and numbers cannot be converted into each other");
+    }
+  });
+  return result;
+}
+
+// Returns the columns of the chunk that are marked in used_columns as
+// ValueSegments, decoding the segments of other types. The others are nullptr.
+std::vector<std::shared_ptr<const AbstractSegment>> decode_columns(const Table& table, const Chunk& chunk,
+                                                                   const std::vector<bool>& used_columns) {
+  auto columns = std::vector<std::shared_ptr<const AbstractSegment>>(used_columns.size());
+  for (auto column_id = ColumnID{0}; column_id < used_columns.size(); ++column_id) {
+    if (!used_columns[column_id]) continue;
+    resolve_data_type(table.column_type(column_id), [&](auto type) {
+      using Type = typename decltype(type)::type;
+      const auto segment = chunk.get_segment(column_id);
+      if (std::dynamic_pointer_cast<const ValueSegment<Type>>(segment)) {
+        columns[column_id] = segment;
+        return;
+      }
+
+      auto values = std::vector<Type>(chunk.size());
+      segment_iterate<Type>(*segment, [&](const auto& position) {
+        values[position.chunk_offset()] = position.value();
+      });
+      columns[column_id] = std::make_shared<ValueSegment<Type>>(std::move(values));
+    });
+  }
+  return columns;
+}
+
+// Returns a bitmap that includes all n_rows rows of the chunk.
+std::shared_ptr<const PosList> all_rows(const ChunkID chunk_id, const size_t n_rows) {
+  auto bitmask = std::vector<uint64_t>(bitmask_word_count(n_rows), ~uint64_t{0});
+  if (n_rows % 64 != 0) bitmask.back() = (uint64_t{1} << (n_rows % 64)) - 1;
+  return std::make_shared<PosList>(chunk_id, std::move(bitmask));
+}
+
+}  // namespace
+
+Projection::Projection(const std::shared_ptr<const AbstractOperator>& input,
+                       const std::vector<std::shared_ptr<const Expression>>& expressions)
+    : AbstractOperator{input}, _expressions{expressions} {
+  Assert(!expressions.empty(), "At least one expression is needed");
+  for (const auto& expression : expressions) {
+    Assert(expression, "Expressions must not be null");
+  }
+}
+
+const std::vector<std::shared_ptr<const Expression>>& Projection::expressions() const { return _expressions; }
+
+std::shared_ptr<const Table> Projection::_on_execute() {
+  const auto input_table = _left_input_table();
+
+  // this also checks the expressions against the input before any chunk is
+  // processed.
+  auto column_definitions = std::make_shared<Table>();
+  for (const auto& expression : _expressions) {
+    column_definitions->add_column_definition(expression->description(*input_table),
+                                              expression->data_type(*input_table));
+  }
+
+  // the data types of all nodes and the columns read by computed expressions.
+  auto expression_data_types = std::unordered_map<const Expression*, std::string>{};
+  auto used_columns = std::vector<bool>(input_table->column_count());
+  const auto add_computed_expression = [&](const auto& self, const Expression& expression) -> void {
+    expression_data_types.emplace(&expression, expression.data_type(*input_table));
+    if (expression.type() == ExpressionType::Column) used_columns[expression.column_id()] = true;
+    for (const auto& argument : expression.arguments()) {
+      self(self, *argument);
+    }
+  };
+  for (const auto& expression : _expressions) {
+    if (expression->type() != ExpressionType::Column) add_computed_expression(add_computed_expression, *expression);
+  }
+
+  const auto n_chunks = input_table->chunk_count();
+  auto output_chunks = std::vector<std::shared_ptr<Chunk>>(n_chunks);
+  WorkerPool::get().parallel_for(n_chunks, [&](const size_t chunk_index) {
+    const auto chunk_id = static_cast<ChunkID>(chunk_index);
+    const auto chunk = input_table->get_chunk(chunk_id);
+    const auto n_rows = chunk->size();
+    if (n_rows == 0) return;
+
+    auto output_chunk = std::make_shared<Chunk>();
+    const auto columns = decode_columns(*input_table, *chunk, used_columns);
+    // the forwarded columns of the chunk share one PosList.
+    auto pos_list = std::shared_ptr<const PosList>{};
+    for (auto expression_index = size_t{0}; expression_index < _expressions.size(); ++expression_index) {
+      const auto& expression = *_expressions[expression_index];
+      if (expression.type() == ExpressionType::Column) {
+        const auto segment = chunk->get_segment(expression.column_id());
+        if (std::dynamic_pointer_cast<const ReferenceSegment>(segment)) {
+          output_chunk->add_segment(segment);
+          continue;
+        }
+        if (!pos_list) pos_list = all_rows(chunk_id, n_rows);
+        output_chunk->add_segment(std::make_shared<ReferenceSegment>(input_table, expression.column_id(), pos_list));
+        continue;
+      }
+
+      resolve_data_type(expression_data_types.at(&expression), [&](auto type) {
+        using Type = typename decltype(type)::type;
+        auto values = std::vector<Type>{};
+        values.reserve(n_rows);
+        for (auto begin = ChunkOffset{0}; begin < n_rows; begin += BLOCK_SIZE) {
+          const auto block_size = std::min(size_t{BLOCK_SIZE}, size_t{n_rows - begin});
+          const auto context = BlockContext{expression_data_types, columns, begin, block_size};
+          append_values(evaluate<Type>(expression, context), block_size, values);
+        }
+        output_chunk->add_segment(std::make_shared<ValueSegment<Type>>(std::move(values)));
+      });
+    }
+    output_chunks[chunk_index] = output_chunk;
+  });
+
+  std::erase(output_chunks, nullptr);
+  if (output_chunks.empty()) return std::make_shared<Table>(column_definitions);
+  return std::make_shared<Table>(output_chunks, column_definitions);
+}
+
+}  // namespace opossum
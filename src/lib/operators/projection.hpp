@@ -0,0 +1,39 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "abstract_operator.hpp"
+#include "expression.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+// Computes one output column per expression, like SELECT <expressions> FROM input. The output columns are named after
+// the descriptions of the expressions, e.g., "a + 1", and have their data types (see Expression).
+//
+// Expressions that are just a column are forwarded without copying any values: Reference segments of the input are
+// passed on as they are, and other segments are referenced by a ReferenceSegment that covers all rows of their chunk.
+// All other expressions are evaluated column-at-a-time for blocks of rows: Each node of the expression tree produces
+// the values of all rows of the block as a typed vector (or as a single value for literals), which its parent combines
+// in a tight loop per operator that the compiler can vectorize. The blocks are small enough that these intermediate
+// vectors stay in the CPU caches. The columns read by the expressions are used in place if they are ValueSegments and
+// decoded once per chunk through the typed segment iterators otherwise, so no AllTypeVariant is created per value. The
+// results are stored in ValueSegments. The chunks are processed in parallel on the WorkerPool.
+class Projection : public AbstractOperator {
+ public:
+  // The number of rows that expressions are evaluated for at a time.
+  static constexpr auto BLOCK_SIZE = ChunkOffset{2'048};
+
+  Projection(const std::shared_ptr<const AbstractOperator>& input,
+             const std::vector<std::shared_ptr<const Expression>>& expressions);
+
+  const std::vector<std::shared_ptr<const Expression>>& expressions() const;
+
+ protected:
+  std::shared_ptr<const Table> _on_execute() override;
+
+  const std::vector<std::shared_ptr<const Expression>> _expressions;
+};
+
+}  // namespace opossum
@@ -0,0 +1,490 @@
+#include "simd_scan_kernels.hpp"
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <type_traits>
+#include <vector>
+
+#include "type_comparison.hpp"
+#include "types.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+namespace {
+
+// The positions of the set bits of each byte value in ascending order, followed by zeros.
+constexpr auto BYTE_BIT_POSITIONS = [] {
+  auto positions = std::array<std::array<uint8_t, 8>, 256>{};
+  for (auto byte = size_t{0}; byte < 256; ++byte) {
+    auto position_count = size_t{0};
+    for (auto bit = uint8_t{0}; bit < 8; ++bit) {
+      if ((byte >> bit) & 1) positions[byte][position_count++] = bit;
+    }
+  }
+  return positions;
+}();
+
+// Converts a runtime ScanType into a compile-time constant so that kernels can be instantiated per scan type.
+template <typename Functor>
+void with_scan_type(const ScanType scan_type, const Functor& func) {
+  switch (scan_type) {
+    case ScanType::OpEquals:
+      func(std::integral_constant<ScanType, ScanType::OpEquals>{});
+      return;
+    case ScanType::OpNotEquals:
+      func(std::integral_constant<ScanType, ScanType::OpNotEquals>{});
+      return;
+    case ScanType::OpLessThan:
+      func(std::integral_constant<ScanType, ScanType::OpLessThan>{});
+      return;
+    case ScanType::OpLessThanEquals:
+      func(std::integral_constant<ScanType, ScanType::OpLessThanEquals>{});
+      return;
+    case ScanType::OpGreaterThan:
+      func(std::integral_constant<ScanType, ScanType::OpGreaterThan>{});
+      return;
+    case ScanType::OpGreaterThanEquals:
+      func(std::integral_constant<ScanType, ScanType::OpGreaterThanEquals>{});
+      return;
+  }
+  Fail("Unknown scan type");
+}
+
+// Scalar fallback. The SIMD kernels also use it for the tail of the input that does not fill a full word.
+template <typename T>
+void compare_scalar(const T* values, const size_t value_count, const ScanType scan_type, const T search_value,
+                    uint64_t* bitmask) {
+  with_comparator(scan_type, [&](const auto& comparator) {
+    const auto word_count = bitmask_word_count(value_count);
+    for (auto word_index = size_t{0}; word_index < word_count; ++word_index) {
+      const auto begin = word_index * 64;
+      const auto end = std::min(begin + 64, value_count);
+      auto word = uint64_t{0};
+      for (auto offset = begin; offset < end; ++offset) {
+        word |= static_cast<uint64_t>(comparator(values[offset], search_value)) << (offset - begin);
+      }
+      bitmask[word_index] = word;
+    }
+  });
+}
+
+#if defined(__x86_64__)
+
+#define AVX2_TARGET __attribute__((target("avx2")))
+#define AVX512_TARGET __attribute__((target("avx512f,avx512bw")))
+
+// Predicates for _mm256_cmp_p[sd] and _mm512_cmp_p[sd]_mask. They mirror the behavior of the scalar operators for NaN,
+// i.e., only != is true if one side is NaN.
+constexpr int float_predicate(const ScanType scan_type) {
+  switch (scan_type) {
+    case ScanType::OpEquals:
+      return _CMP_EQ_OQ;
+    case ScanType::OpNotEquals:
+      return _CMP_NEQ_UQ;
+    case ScanType::OpLessThan:
+      return _CMP_LT_OQ;
+    case ScanType::OpLessThanEquals:
+      return _CMP_LE_OQ;
+    case ScanType::OpGreaterThan:
+      return _CMP_GT_OQ;
+    case ScanType::OpGreaterThanEquals:
+      return _CMP_GE_OQ;
+  }
+  Fail("Unknown scan type");
+}
+
+// Predicates for _mm512_cmp_ep[iu]XX_mask.
+constexpr int integer_predicate(const ScanType scan_type) {
+  switch (scan_type) {
+    case ScanType::OpEquals:
+      return _MM_CMPINT_EQ;
+    case ScanType::OpNotEquals:
+      return _MM_CMPINT_NE;
+    case ScanType::OpLessThan:
+      return _MM_CMPINT_LT;
+    case ScanType::OpLessThanEquals:
+      return _MM_CMPINT_LE;
+    case ScanType::OpGreaterThan:
+      return _MM_CMPINT_NLE;
+    case ScanType::OpGreaterThanEquals:
+      return _MM_CMPINT_NLT;
+  }
+  Fail("Unknown scan type");
+}
+
+// AVX2 only offers signed equality and greater-than comparisons for integers. Everything else is derived from these
+// two. Unsigned codes are compared by flipping their sign bit first (see the Avx2Kernel specializations).
+template <ScanType scan_type, typename Kernel>
+AVX2_TARGET __m256i avx2_integer_mask(const __m256i values, const __m256i search) {
+  const auto all_ones = _mm256_set1_epi32(-1);
+  if constexpr (scan_type == ScanType::OpEquals) {
+    return Kernel::equal(values, search);
+  } else if constexpr (scan_type == ScanType::OpNotEquals) {
+    return _mm256_xor_si256(Kernel::equal(values, search), all_ones);
+  } else if constexpr (scan_type == ScanType::OpLessThan) {
+    return Kernel::greater(search, values);
+  } else if constexpr (scan_type == ScanType::OpLessThanEquals) {
+    return _mm256_xor_si256(Kernel::greater(values, search), all_ones);
+  } else if constexpr (scan_type == ScanType::OpGreaterThan) {
+    return Kernel::greater(values, search);
+  } else {
+    return _mm256_xor_si256(Kernel::greater(search, values), all_ones);
+  }
+}
+
+// Each kernel compares LANES values starting at the given pointer and returns one bit per value.
+template <typename T>
+struct Avx2Kernel;
+
+template <>
+struct Avx2Kernel<int32_t> {
+  static constexpr auto LANES = size_t{8};
+  AVX2_TARGET static __m256i broadcast(const int32_t value) { return _mm256_set1_epi32(value); }
+  AVX2_TARGET static __m256i equal(const __m256i lhs, const __m256i rhs) { return _mm256_cmpeq_epi32(lhs, rhs); }
+  AVX2_TARGET static __m256i greater(const __m256i lhs, const __m256i rhs) { return _mm256_cmpgt_epi32(lhs, rhs); }
+
+  template <ScanType scan_type>
+  AVX2_TARGET static uint64_t compare(const int32_t* values, const __m256i search) {
+    const auto loaded = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values));
+    const auto mask = avx2_integer_mask<scan_type, Avx2Kernel>(loaded, search);
+    return static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(mask)));
+  }
+};
+
+template <>
+struct Avx2Kernel<int64_t> {
+  static constexpr auto LANES = size_t{4};
+  AVX2_TARGET static __m256i broadcast(const int64_t value) { return _mm256_set1_epi64x(value); }
+  AVX2_TARGET static __m256i equal(const __m256i lhs, const __m256i rhs) { return _mm256_cmpeq_epi64(lhs, rhs); }
+  AVX2_TARGET static __m256i greater(const __m256i lhs, const __m256i rhs) { return _mm256_cmpgt_epi64(lhs, rhs); }
+
+  template <ScanType scan_type>
+  AVX2_TARGET static uint64_t compare(const int64_t* values, const __m256i search) {
+    const auto loaded = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values));
+    const auto mask = avx2_integer_mask<scan_type, Avx2Kernel>(loaded, search);
+    return static_cast<uint32_t>(_mm256_movemask_pd(_mm256_castsi256_pd(mask)));
+  }
+};
+
+template <>
+struct Avx2Kernel<float> {
+  static constexpr auto LANES = size_t{8};
+  AVX2_TARGET static __m256 broadcast(const float value) { return _mm256_set1_ps(value); }
+
+  template <ScanType scan_type>
+  AVX2_TARGET static uint64_t compare(const float* values, const __m256 search) {
+    constexpr auto PREDICATE = float_predicate(scan_type);
+    const auto mask = _mm256_cmp_ps(_mm256_loadu_ps(values), search, PREDICATE);
+    return static_cast<uint32_t>(_mm256_movemask_ps(mask));
+  }
+};
+
+template <>
+struct Avx2Kernel<double> {
+  static constexpr auto LANES = size_t{4};
+  AVX2_TARGET static __m256d broadcast(const double value) { return _mm256_set1_pd(value); }
+
+  template <ScanType scan_type>
+  AVX2_TARGET static uint64_t compare(const double* values, const __m256d search) {
+    constexpr auto PREDICATE = float_predicate(scan_type);
+    const auto mask = _mm256_cmp_pd(_mm256_loadu_pd(values), search, PREDICATE);
+    return static_cast<uint32_t>(_mm256_movemask_pd(mask));
+  }
+};
+
+template <>
+struct Avx2Kernel<uint8_t> {
+  static constexpr auto LANES = size_t{32};
+  AVX2_TARGET static __m256i sign_bits() { return _mm256_set1_epi8(static_cast<char>(0x80)); }
+  AVX2_TARGET static __m256i broadcast(const uint8_t value) {
+    return _mm256_xor_si256(_mm256_set1_epi8(static_cast<char>(value)), sign_bits());
+  }
+  AVX2_TARGET static __m256i equal(const __m256i lhs, const __m256i rhs) { return _mm256_cmpeq_epi8(lhs, rhs); }
+  AVX2_TARGET static __m256i greater(const __m256i lhs, const __m256i rhs) { return _mm256_cmpgt_epi8(lhs, rhs); }
+
+  template <ScanType scan_type>
+  AVX2_TARGET static uint64_t compare(const uint8_t* values, const __m256i search) {
+    const auto loaded = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(values)), sign_bits());
+    const auto mask = avx2_integer_mask<scan_type, Avx2Kernel>(loaded, search);
+    return static_cast<uint32_t>(_mm256_movemask_epi8(mask));
+  }
+};
+
+template <>
+struct Avx2Kernel<uint16_t> {
+  // Two registers are compared at once so that their masks can be packed into bytes for _mm256_movemask_epi8.
+  static constexpr auto LANES = size_t{32};
+  AVX2_TARGET static __m256i sign_bits() { return _mm256_set1_epi16(static_cast<int16_t>(0x8000)); }
+  AVX2_TARGET static __m256i broadcast(const uint16_t value) {
+    return _mm256_xor_si256(_mm256_set1_epi16(static_cast<int16_t>(value)), sign_bits());
+  }
+  AVX2_TARGET static __m256i equal(const __m256i lhs, const __m256i rhs) { return _mm256_cmpeq_epi16(lhs, rhs); }
+  AVX2_TARGET static __m256i greater(const __m256i lhs, const __m256i rhs) { return _mm256_cmpgt_epi16(lhs, rhs); }
+
+  template <ScanType scan_type>
+  AVX2_TARGET static uint64_t compare(const uint16_t* values, const __m256i search) {
+    const auto* vectors = reinterpret_cast<const __m256i*>(values);
+    const auto low = avx2_integer_mask<scan_type, Avx2Kernel>(
+        _mm256_xor_si256(_mm256_loadu_si256(vectors), sign_bits()), search);
+    const auto high = avx2_integer_mask<scan_type, Avx2Kernel>(
+        _mm256_xor_si256(_mm256_loadu_si256(vectors + 1), sign_bits()), search);
+    // _mm256_packs_epi16 interleaves the 128-bit lanes of its inputs; the permutation restores the value order.
+    const auto packed = _mm256_permute4x64_epi64(_mm256_packs_epi16(low, high), 0b11011000);
+    return static_cast<uint32_t>(_mm256_movemask_epi8(packed));
+  }
+};
+
+template <>
+struct Avx2Kernel<uint32_t> {
+  static constexpr auto LANES = size_t{8};
+  AVX2_TARGET static __m256i sign_bits() { return _mm256_set1_epi32(static_cast<int32_t>(0x80000000)); }
+  AVX2_TARGET static __m256i broadcast(const uint32_t value) {
+    return _mm256_xor_si256(_mm256_set1_epi32(static_cast<int32_t>(value)), sign_bits());
+  }
+  AVX2_TARGET static __m256i equal(const __m256i lhs, const __m256i rhs) { return _mm256_cmpeq_epi32(lhs, rhs); }
+  AVX2_TARGET static __m256i greater(const __m256i lhs, const __m256i rhs) { return _mm256_cmpgt_epi32(lhs, rhs); }
+
+  template <ScanType scan_type>
+  AVX2_TARGET static uint64_t compare(const uint32_t* values, const __m256i search) {
+    const auto loaded = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(values)), sign_bits());
+    const auto mask = avx2_integer_mask<scan_type, Avx2Kernel>(loaded, search);
+    return static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(mask)));
+  }
+};
+
+// AVX-512 comparisons directly produce bit masks and support all predicates and unsigned integers natively.
+template <typename T>
+struct Avx512Kernel;
+
+template <>
+struct Avx512Kernel<int32_t> {
+  static constexpr auto LANES = size_t{16};
+  AVX512_TARGET static __m512i broadcast(const int32_t value) { return _mm512_set1_epi32(value); }
+
+  template <ScanType scan_type>
+  AVX512_TARGET static uint64_t compare(const int32_t* values, const __m512i search) {
+    constexpr auto PREDICATE = integer_predicate(scan_type);
+    return _mm512_cmp_epi32_mask(_mm512_loadu_si512(values), search, PREDICATE);
+  }
+};
+
+template <>
+struct Avx512Kernel<int64_t> {
+  static constexpr auto LANES = size_t{8};
+  AVX512_TARGET static __m512i broadcast(const int64_t value) { return _mm512_set1_epi64(value); }
+
+  template <ScanType scan_type>
+  AVX512_TARGET static uint64_t compare(const int64_t* values, const __m512i search) {
+    constexpr auto PREDICATE = integer_predicate(scan_type);
+    return _mm512_cmp_epi64_mask(_mm512_loadu_si512(values), search, PREDICATE);
+  }
+};
+
+template <>
+struct Avx512Kernel<float> {
+  static constexpr auto LANES = size_t{16};
+  AVX512_TARGET static __m512 broadcast(const float value) { return _mm512_set1_ps(value); }
+
+  template <ScanType scan_type>
+  AVX512_TARGET static uint64_t compare(const float* values, const __m512 search) {
+    constexpr auto PREDICATE = float_predicate(scan_type);
+    return _mm512_cmp_ps_mask(_mm512_loadu_ps(values), search, PREDICATE);
+  }
+};
+
+template <>
+struct Avx512Kernel<double> {
+  static constexpr auto LANES = size_t{8};
+  AVX512_TARGET static __m512d broadcast(const double value) { return _mm512_set1_pd(value); }
+
+  template <ScanType scan_type>
+  AVX512_TARGET static uint64_t compare(const double* values, const __m512d search) {
+    constexpr auto PREDICATE = float_predicate(scan_type);
+    return _mm512_cmp_pd_mask(_mm512_loadu_pd(values), search, PREDICATE);
+  }
+};
+
+template <>
+struct Avx512Kernel<uint8_t> {
+  static constexpr auto LANES = size_t{64};
+  AVX512_TARGET static __m512i broadcast(const uint8_t value) { return _mm512_set1_epi8(static_cast<char>(value)); }
+
+  template <ScanType scan_type>
+  AVX512_TARGET static uint64_t compare(const uint8_t* values, const __m512i search) {
+    constexpr auto PREDICATE = integer_predicate(scan_type);
+    return _mm512_cmp_epu8_mask(_mm512_loadu_si512(values), search, PREDICATE);
+  }
+};
+
+template <>
+struct Avx512Kernel<uint16_t> {
+  static constexpr auto LANES = size_t{32};
+  AVX512_TARGET static __m512i broadcast(const uint16_t value) {
+    return _mm512_set1_epi16(static_cast<int16_t>(value));
+  }
+
+  template <ScanType scan_type>
+  AVX512_TARGET static uint64_t compare(const uint16_t* values, const __m512i search) {
+    constexpr auto PREDICATE = integer_predicate(scan_type);
+    return _mm512_cmp_epu16_mask(_mm512_loadu_si512(values), search, PREDICATE);
+  }
+};
+
+template <>
+struct Avx512Kernel<uint32_t> {
+  static constexpr auto LANES = size_t{16};
+  AVX512_TARGET static __m512i broadcast(const uint32_t value) {
+    return _mm512_set1_epi32(static_cast<int32_t>(value));
+  }
+
+  template <ScanType scan_type>
+  AVX512_TARGET static uint64_t compare(const uint32_t* values, const __m512i search) {
+    constexpr auto PREDICATE = integer_predicate(scan_type);
+    return _mm512_cmp_epu32_mask(_mm512_loadu_si512(values), search, PREDICATE);
+  }
+};
+
+// The drivers fill one bitmask word per 64 values. They are duplicated per instruction set because the target
+// attribute of the driver must match the kernel's so that the kernel can be inlined.
+template <typename Kernel, ScanType scan_type, typename T>
+AVX2_TARGET void compare_full_words_avx2(const T* values, const size_t word_count, const T search_value,
+                                         uint64_t* bitmask) {
+  const auto search = Kernel::broadcast(search_value);
+  for (auto word_index = size_t{0}; word_index < word_count; ++word_index) {
+    const auto* word_values = values + word_index * 64;
+    auto word = uint64_t{0};
+    for (auto lane_offset = size_t{0}; lane_offset < 64; lane_offset += Kernel::LANES) {
+      word |= Kernel::template compare<scan_type>(word_values + lane_offset, search) << lane_offset;
+    }
+    bitmask[word_index] = word;
+  }
+}
+
+template <typename Kernel, ScanType scan_type, typename T>
+AVX512_TARGET void compare_full_words_avx512(const T* values, const size_t word_count, const T search_value,
+                                             uint64_t* bitmask) {
+  const auto search = Kernel::broadcast(search_value);
+  for (auto word_index = size_t{0}; word_index < word_count; ++word_index) {
+    const auto* word_values = values + word_index * 64;
+    auto word = uint64_t{0};
+    for (auto lane_offset = size_t{0}; lane_offset < 64; lane_offset += Kernel::LANES) {
+      word |= Kernel::template compare<scan_type>(word_values + lane_offset, search) << lane_offset;
+    }
+    bitmask[word_index] = word;
+  }
+}
+
+#endif
+
+}  // namespace
+
+SimdLevel detected_simd_level() {
+  static const auto simd_level = [] {
+#if defined(__x86_64__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) return SimdLevel::AVX512;
+    if (__builtin_cpu_supports("avx2")) return SimdLevel::AVX2;
+#endif
+    return SimdLevel::Scalar;
+  }();
+  return simd_level;
+}
+
+template <typename T>
+void compare_to_bitmask(const T* values, const size_t value_count, const ScanType scan_type, const T search_value,
+                        uint64_t* bitmask, const SimdLevel simd_level) {
+  DebugAssert(simd_level == SimdLevel::Scalar || simd_level <= detected_simd_level(),
+              "SIMD level is not supported by this CPU");
+#if defined(__x86_64__)
+  if (simd_level != SimdLevel::Scalar) {
+    const auto full_word_count = value_count / 64;
+    with_scan_type(scan_type, [&](auto scan_type_constant) {
+      constexpr auto SCAN_TYPE = decltype(scan_type_constant)::value;
+      if (simd_level == SimdLevel::AVX512) {
+        compare_full_words_avx512<Avx512Kernel<T>, SCAN_TYPE>(values, full_word_count, search_value, bitmask);
+      } else {
+        compare_full_words_avx2<Avx2Kernel<T>, SCAN_TYPE>(values, full_word_count, search_value, bitmask);
+      }
+    });
+
+    const auto processed_value_count = full_word_count * 64;
+    if (processed_value_count < value_count) {
+      compare_scalar(values + processed_value_count, value_count - processed_value_count, scan_type, search_value,
+                     bitmask + full_word_count);
+    }
+    return;
+  }
+#endif
+  compare_scalar(values, value_count, scan_type, search_value, bitmask);
+}
+
+void append_matching_offsets(const uint64_t* bitmask, const size_t value_count, std::vector<ChunkOffset>& offsets) {
+  const auto word_count = bitmask_word_count(value_count);
+  auto match_count = size_t{0};
+  for (auto word_index = size_t{0}; word_index < word_count; ++word_index) {
+    match_count += std::popcount(bitmask[word_index]);
+  }
+
+  const auto previous_size = offsets.size();
+  offsets.resize(previous_size + match_count);
+  auto* output = offsets.data() + previous_size;
+  for (auto word_index = size_t{0}; word_index < word_count; ++word_index) {
+    const auto word_begin = static_cast<ChunkOffset>(word_index * 64);
+    auto word = bitmask[word_index];
+    if (word == ~uint64_t{0}) {
+      for (auto bit = ChunkOffset{0}; bit < 64; ++bit) {
+        *output++ = word_begin + bit;
+      }
+      continue;
+    }
+    while (word) {
+      *output++ = word_begin + static_cast<ChunkOffset>(std::countr_zero(word));
+      word &= word - 1;
+    }
+  }
+}
+
+size_t bitmask_to_selection(const uint64_t* bitmask, const size_t value_count, uint16_t* selection,
+                            const size_t buffer_size) {
+  DebugAssert(value_count <= 65'536, "Selection offsets must fit into 16 bits");
+  DebugAssert(buffer_size >= selection_buffer_size(value_count), "Selection buffer is too small");
+  auto selection_size = size_t{0};
+  const auto word_count = bitmask_word_count(value_count);
+  for (auto word_index = size_t{0}; word_index < word_count; ++word_index) {
+    const auto word = bitmask[word_index];
+    for (auto byte_index = size_t{0}; byte_index < 8; ++byte_index) {
+      // all eight positions are written, and only the valid ones are kept.
+      const auto byte = static_cast<uint8_t>(word >> (byte_index * 8));
+      const auto& positions = BYTE_BIT_POSITIONS[byte];
+      const auto byte_begin = static_cast<uint16_t>(word_index * 64 + byte_index * 8);
+      for (auto position_index = size_t{0}; position_index < 8; ++position_index) {
+        selection[selection_size + position_index] = static_cast<uint16_t>(byte_begin + positions[position_index]);
+      }
+      selection_size += std::popcount(byte);
+    }
+  }
+  return selection_size;
+}
+
+template void compare_to_bitmask<int32_t>(const int32_t*, const size_t, const ScanType, const int32_t, uint64_t*,
+                                          const SimdLevel);
+template void compare_to_bitmask<int64_t>(const int64_t*, const size_t, const ScanType, const int64_t, uint64_t*,
+                                          const SimdLevel);
+template void compare_to_bitmask<float>(const float*, const size_t, const ScanType, const float, uint64_t*,
+                                        const SimdLevel);
+template void compare_to_bitmask<double>(const double*, const size_t, const ScanType, const double, uint64_t*,
+                                         const SimdLevel);
+template void compare_to_bitmask<uint8_t>(const uint8_t*, const size_t, const ScanType, const uint8_t, uint64_t*,
+                                          const SimdLevel);
+template void compare_to_bitmask<uint16_t>(const uint16_t*, const size_t, const ScanType, const uint16_t, uint64_t*,
+                                           const SimdLevel);
+template void compare_to_bitmask<uint32_t>(const uint32_t*, const size_t, const ScanType, const uint32_t, uint64_t*,
+                                           const SimdLevel);
+
+}  // namespace opossum
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "types.hpp"
+
+namespace opossum {
+
+// The scan kernels in this file compare a contiguous array of values against a constant and write the result as a
+// bitmask: bit (i % 64) of bitmask[i / 64] is set if values[i] satisfies the scan type. Afterwards,
+// append_matching_offsets turns the bitmask into the offsets that TableScan emits.
+//
+// Besides a scalar fallback, there are hand-written AVX2 and AVX-512 kernels. They are compiled with function-level
+// target attributes and selected at runtime based on cpuid, so that a binary built on one host still runs on a host
+// with a smaller instruction set.
+//
+// Kernels are provided for the arithmetic column types (int32_t, int64_t, float, double) and for the code types of
+// FixedWidthIntegerVector (uint8_t, uint16_t, uint32_t).
+
+enum class SimdLevel { Scalar, AVX2, AVX512 };
+
+// Returns the most capable instruction set supported by the current CPU (determined once).
+SimdLevel detected_simd_level();
+
+// Returns the number of uint64_t words needed to hold the bitmask for value_count values.
+constexpr size_t bitmask_word_count(const size_t value_count) { return (value_count + 63) / 64; }
+
+// Writes bitmask_word_count(value_count) words to bitmask. Bits beyond value_count are zero. Passing a SimdLevel that
+// the CPU does not support is illegal; use detected_simd_level() unless you want to benchmark or test a specific level.
+template <typename T>
+void compare_to_bitmask(const T* values, const size_t value_count, const ScanType scan_type, const T search_value,
+                        uint64_t* bitmask, const SimdLevel simd_level = detected_simd_level());
+
+// Appends the offsets of all set bits in bitmask, i.e., of all matching values, to offsets.
+void append_matching_offsets(const uint64_t* bitmask, const size_t value_count, std::vector<ChunkOffset>& offsets);
+
+// Returns the number of entries that the selection passed to bitmask_to_selection must have room for. Each byte of the
+// bitmask writes eight entries, starting at the number of offsets before it, so the last byte writes up to index
+// value_count + 7, but never beyond the bits of the last bitmask word.
+constexpr size_t selection_buffer_size(const size_t value_count) {
+  return std::min(value_count + 8, bitmask_word_count(value_count) * 64);
+}
+
+// Writes the offsets of all set bits in bitmask to selection and returns their number, e.g., for the selection vector
+// of a Batch. value_count must not exceed 65536. The bits are decoded a byte at a time without branches, which
+// overwrites entries after the last offset, so buffer_size must be at least selection_buffer_size(value_count).
+size_t bitmask_to_selection(const uint64_t* bitmask, const size_t value_count, uint16_t* selection,
+                            const size_t buffer_size);
+
+}  // namespace opossum
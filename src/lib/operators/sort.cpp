@@ -0,0 +1,248 @@
+#include "sort.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "normalized_keys.hpp"
+#include "scheduler/worker_pool.hpp"
+#include "storage/pos_list.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+namespace {
+
+// The normalized keys of all rows, which point into the keys of the chunks.
+struct RowKeys {
+  // Returns the eight bytes of the key of a row that start at key_offset, zero-padded and read big-endian.
+  uint64_t prefix(const uint32_t row, const size_t key_offset) const {
+    auto prefix = uint64_t{0};
+    for (auto byte_index = key_offset; byte_index < key_offset + sizeof(prefix); ++byte_index) {
+      prefix = (prefix << 8) | (byte_index < sizes[row] ? data[row][byte_index] : uint8_t{0});
+    }
+    return prefix;
+  }
+
+  std::vector<const uint8_t*> data;
+  std::vector<uint32_t> sizes;
+};
+
+// A row to be sorted together with the first eight bytes of its key.
+struct SortEntry {
+  uint64_t key_prefix;
+  uint32_t row;
+};
+
+// Compares entries by their key prefixes, then by their whole keys, and then by their position in the input, which
+// keeps the sort stable.
+class SortEntryComparator {
+ public:
+  explicit SortEntryComparator(const RowKeys& keys) : _keys{keys} {}
+
+  bool operator()(const SortEntry& lhs, const SortEntry& rhs) const {
+    if (lhs.key_prefix != rhs.key_prefix) return lhs.key_prefix < rhs.key_prefix;
+    const auto lhs_key_size = _keys.sizes[lhs.row];
+    const auto rhs_key_size = _keys.sizes[rhs.row];
+    const auto comparison =
+        std::memcmp(_keys.data[lhs.row], _keys.data[rhs.row], std::min(lhs_key_size, rhs_key_size));
+    if (comparison != 0) return comparison < 0;
+    if (lhs_key_size != rhs_key_size) return lhs_key_size < rhs_key_size;
+    return lhs.row < rhs.row;
+  }
+
+ private:
+  const RowKeys& _keys;
+};
+
+// Sorts the entries by their key_prefix with a least significant digit radix sort, one byte per pass. The sort is
+// stable, so entries with equal prefixes keep their order. Passes in which all entries have the same byte, e.g., the
+// zero padding of short keys or the high bytes of small integers, are skipped.
+void radix_sort_by_prefix(SortEntry* const begin, SortEntry* const end, SortEntry* const buffer) {
+  const auto entry_count = static_cast<size_t>(end - begin);
+  auto histograms = std::array<std::array<size_t, 256>, sizeof(uint64_t)>{};
+  for (auto* entry = begin; entry != end; ++entry) {
+    for (auto byte_index = size_t{0}; byte_index < sizeof(uint64_t); ++byte_index) {
+      ++histograms[byte_index][(entry->key_prefix >> (byte_index * 8)) & 0xFF];
+    }
+  }
+
+  auto* source = begin;
+  auto* target = buffer;
+  for (auto byte_index = size_t{0}; byte_index < sizeof(uint64_t); ++byte_index) {
+    auto& histogram = histograms[byte_index];
+    if (std::find(histogram.cbegin(), histogram.cend(), entry_count) != histogram.cend()) continue;
+
+    auto bucket_offset = size_t{0};
+    for (auto& bucket : histogram) {
+      bucket_offset += std::exchange(bucket, bucket_offset);
+    }
+    for (auto* entry = source; entry != source + entry_count; ++entry) {
+      target[histogram[(entry->key_prefix >> (byte_index * 8)) & 0xFF]++] = *entry;
+    }
+    std::swap(source, target);
+  }
+  if (source != begin) std::copy(source, source + entry_count, begin);
+}
+
+// Fewer entries than this are sorted by comparing their prefixes and rows, as clearing the histograms of a radix sort
+// would take longer.
+constexpr auto MIN_RADIX_SORT_SIZE = size_t{64};
+
+// Sorts the entries, which are in the order of their rows and whose keys are equal in their first key_offset bytes, by
+// the bytes of their keys from key_offset on. The entries are radix sorted by the next eight bytes, and each group of
+// entries that are still equal is sorted by the following eight bytes, and so on. Afterwards, the key_prefix of each
+// entry holds the eight bytes at key_offset again.
+void sort_by_keys(SortEntry* const begin, SortEntry* const end, SortEntry* const buffer, const RowKeys& keys,
+                  const size_t key_offset) {
+  if (key_offset > 0) {
+    for (auto* entry = begin; entry != end; ++entry) {
+      entry->key_prefix = keys.prefix(entry->row, key_offset);
+    }
+  }
+  if (static_cast<size_t>(end - begin) >= MIN_RADIX_SORT_SIZE) {
+    radix_sort_by_prefix(begin, end, buffer);
+  } else {
+    std::sort(begin, end, [](const SortEntry& lhs, const SortEntry& rhs) {
+      return std::tie(lhs.key_prefix, lhs.row) < std::tie(rhs.key_prefix, rhs.row);
+    });
+  }
+
+  for (auto* equal_begin = begin; equal_begin != end;) {
+    const auto key_prefix = equal_begin->key_prefix;
+    auto* const equal_end =
+        std::find_if(equal_begin + 1, end, [&](const SortEntry& entry) { return entry.key_prefix != key_prefix; });
+    // if no key continues after the prefix, all keys of the group are equal.
+    const auto keys_continue = std::any_of(equal_begin, equal_end, [&](const SortEntry& entry) {
+      return keys.sizes[entry.row] > key_offset + sizeof(uint64_t);
+    });
+    if (equal_end - equal_begin > 1 && keys_continue) {
+      sort_by_keys(equal_begin, equal_end, buffer + (equal_begin - begin), keys, key_offset + sizeof(uint64_t));
+      std::for_each(equal_begin, equal_end, [&](SortEntry& entry) { entry.key_prefix = key_prefix; });
+    }
+    equal_begin = equal_end;
+  }
+}
+
+// Sorts the entries, which are in the order of their rows. Runs of the entries are sorted by their keys in parallel
+// and then merged pairwise, where the pairs of each round are merged in parallel.
+void sort_entries(std::vector<SortEntry>& entries, const RowKeys& keys) {
+  const auto entry_count = entries.size();
+  const auto run_count =
+      std::max(std::min(entry_count / Sort::MIN_RUN_SIZE, WorkerPool::get().worker_count()), size_t{1});
+  auto run_bounds = std::vector<size_t>(run_count + 1);
+  for (auto run_index = size_t{0}; run_index <= run_count; ++run_index) {
+    run_bounds[run_index] = entry_count * run_index / run_count;
+  }
+
+  auto buffer = std::vector<SortEntry>(entry_count);
+  WorkerPool::get().parallel_for(run_count, [&](const size_t run_index) {
+    sort_by_keys(entries.data() + run_bounds[run_index], entries.data() + run_bounds[run_index + 1],
+                 buffer.data() + run_bounds[run_index], keys, 0);
+  });
+
+  const auto comparator = SortEntryComparator{keys};
+  while (run_bounds.size() > 2) {
+    const auto current_run_count = run_bounds.size() - 1;
+    const auto pair_count = (current_run_count + 1) / 2;
+    WorkerPool::get().parallel_for(pair_count, [&](const size_t pair_index) {
+      const auto first = entries.begin() + run_bounds[2 * pair_index];
+      const auto middle = entries.begin() + run_bounds[std::min(2 * pair_index + 1, current_run_count)];
+      const auto last = entries.begin() + run_bounds[std::min(2 * pair_index + 2, current_run_count)];
+      std::merge(first, middle, middle, last, buffer.begin() + run_bounds[2 * pair_index], comparator);
+    });
+    entries.swap(buffer);
+
+    auto merged_run_bounds = std::vector<size_t>{};
+    for (auto run_index = size_t{0}; run_index < current_run_count; run_index += 2) {
+      merged_run_bounds.push_back(run_bounds[run_index]);
+    }
+    merged_run_bounds.push_back(entry_count);
+    run_bounds = std::move(merged_run_bounds);
+  }
+}
+
+}  // namespace
+
+Sort::Sort(const std::shared_ptr<const AbstractOperator>& input,
+           const std::vector<SortColumnDefinition>& sort_definitions, const ChunkOffset output_chunk_size)
+    : AbstractOperator{input}, _sort_definitions{sort_definitions}, _output_chunk_size{output_chunk_size} {
+  Assert(!sort_definitions.empty(), "At least one sort column is needed");
+  Assert(output_chunk_size > 0, "Output chunks must not be empty");
+}
+
+const std::vector<SortColumnDefinition>& Sort::sort_definitions() const { return _sort_definitions; }
+
+std::shared_ptr<const Table> Sort::_on_execute() {
+  const auto input_table = _left_input_table();
+  for (const auto& definition : _sort_definitions) {
+    Assert(definition.column_id < input_table->column_count(), "Sort column does not exist");
+  }
+
+  auto column_definitions = std::make_shared<Table>();
+  for (auto column_id = ColumnID{0}; column_id < input_table->column_count(); ++column_id) {
+    column_definitions->add_column_definition(input_table->column_name(column_id),
+                                              input_table->column_type(column_id));
+  }
+
+  const auto n_chunks = input_table->chunk_count();
+  auto chunk_row_begins = std::vector<size_t>(n_chunks + 1);
+  for (auto chunk_id = ChunkID{0}; chunk_id < n_chunks; ++chunk_id) {
+    chunk_row_begins[chunk_id + 1] = chunk_row_begins[chunk_id] + input_table->get_chunk(chunk_id)->size();
+  }
+  const auto row_count = chunk_row_begins.back();
+  if (row_count == 0) return std::make_shared<Table>(column_definitions);
+
+  // the keys of the rows point into the keys of the chunks, which are
+  // therefore kept until the rows are sorted.
+  auto chunk_keys = std::vector<NormalizedKeys>(n_chunks);
+  auto keys = RowKeys{std::vector<const uint8_t*>(row_count), std::vector<uint32_t>(row_count)};
+  auto entries = std::vector<SortEntry>(row_count);
+  auto row_ids = std::vector<RowID>(row_count);
+  WorkerPool::get().parallel_for(n_chunks, [&](const size_t chunk_index) {
+    const auto chunk_id = static_cast<ChunkID>(chunk_index);
+    auto& chunk = chunk_keys[chunk_index];
+    chunk = encode_normalized_keys(*input_table, *input_table->get_chunk(chunk_id), _sort_definitions);
+
+    const auto chunk_row_begin = chunk_row_begins[chunk_index];
+    const auto chunk_size = chunk_row_begins[chunk_index + 1] - chunk_row_begin;
+    for (auto chunk_offset = size_t{0}; chunk_offset < chunk_size; ++chunk_offset) {
+      const auto row = static_cast<uint32_t>(chunk_row_begin + chunk_offset);
+      keys.data[row] = chunk.key_data.data() + chunk.key_offsets[chunk_offset];
+      keys.sizes[row] = static_cast<uint32_t>(chunk.key_offsets[chunk_offset + 1] - chunk.key_offsets[chunk_offset]);
+      entries[row] = SortEntry{keys.prefix(row, 0), row};
+      row_ids[row] = RowID{chunk_id, static_cast<ChunkOffset>(chunk_offset)};
+    }
+  });
+
+  sort_entries(entries, keys);
+  chunk_keys = {};
+
+  const auto n_output_chunks = (row_count + _output_chunk_size - 1) / _output_chunk_size;
+  auto pos_lists = std::vector<std::shared_ptr<const PosList>>(n_output_chunks);
+  WorkerPool::get().parallel_for(n_output_chunks, [&](const size_t output_chunk_index) {
+    const auto begin = output_chunk_index * _output_chunk_size;
+    const auto end = std::min(begin + _output_chunk_size, row_count);
+    auto sorted_row_ids = std::vector<RowID>(end - begin);
+    for (auto index = begin; index < end; ++index) {
+      sorted_row_ids[index - begin] = row_ids[entries[index].row];
+    }
+    pos_lists[output_chunk_index] = std::make_shared<PosList>(std::move(sorted_row_ids));
+  });
+
+  auto output_chunks = std::vector<std::shared_ptr<Chunk>>(n_output_chunks);
+  for (auto& output_chunk : output_chunks) {
+    output_chunk = std::make_shared<Chunk>();
+  }
+  _append_reference_segments(input_table, pos_lists, output_chunks);
+  return std::make_shared<Table>(output_chunks, column_definitions);
+}
+
+}  // namespace opossum
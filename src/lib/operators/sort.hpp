@@ -0,0 +1,53 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "abstract_operator.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+enum class SortMode { Ascending, Descending };
+
+// A column of an ORDER BY clause, e.g., "b DESC".
+struct SortColumnDefinition {
+  ColumnID column_id;
+  SortMode sort_mode = SortMode::Ascending;
+};
+
+// Sorts the rows of its input by one or more columns, like SELECT * FROM input ORDER BY <sort columns>. Rows with equal
+// values in all sort columns keep their order from the input. The output has the same columns as the input, but all its
+// segments are ReferenceSegments. Like the output of a TableScan, they point to the tables that the input references if
+// the input consists of reference segments itself.
+//
+// Comparing rows value by value would require a type dispatch per column and comparison. Instead, the values of the
+// sort columns of each row are encoded into a single normalized key, a byte string whose order under memcmp is the
+// order of the rows: integers are stored big-endian with an inverted sign bit, floating-point numbers additionally
+// invert all bits if they are negative, and strings are terminated by two zero bytes (zero bytes within a string are
+// escaped). The bytes of descending columns are inverted. The keys of each chunk are encoded in parallel.
+//
+// The rows are then split into runs that are sorted on the WorkerPool and merged pairwise. Each run is radix sorted by
+// the first eight bytes of the keys, which are stored next to the rows. Rows whose keys are still equal are sorted by
+// the next eight bytes, and so on, so the keys themselves are hardly ever compared.
+class Sort : public AbstractOperator {
+ public:
+  // The sorted rows are split into output chunks of this many rows by default.
+  static constexpr auto OUTPUT_CHUNK_SIZE = ChunkOffset{65'536};
+
+  // Each run that is sorted on its own has at least this many rows, unless the input is smaller.
+  static constexpr auto MIN_RUN_SIZE = size_t{65'536};
+
+  Sort(const std::shared_ptr<const AbstractOperator>& input, const std::vector<SortColumnDefinition>& sort_definitions,
+       const ChunkOffset output_chunk_size = OUTPUT_CHUNK_SIZE);
+
+  const std::vector<SortColumnDefinition>& sort_definitions() const;
+
+ protected:
+  std::shared_ptr<const Table> _on_execute() override;
+
+  const std::vector<SortColumnDefinition> _sort_definitions;
+  const ChunkOffset _output_chunk_size;
+};
+
+}  // namespace opossum
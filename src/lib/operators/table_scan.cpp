@@ -1,24 +1,169 @@
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <functional>
+#include <limits>
 #include <memory>
+#include <numeric>
 #include <optional>
 #include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "abstract_operator.hpp"
 #include "all_type_variant.hpp"
 #include "resolve_type.hpp"
+#include "scheduler/worker_pool.hpp"
+#include "simd_scan_kernels.hpp"
+#include "storage/bit_packed_vector.hpp"
 #include "storage/dictionary_segment.hpp"
+#include "storage/fixed_width_integer_vector.hpp"
+#include "storage/frame_of_reference_segment.hpp"
+#include "storage/front_coded_dictionary_segment.hpp"
+#include "storage/pos_list.hpp"
 #include "storage/reference_segment.hpp"
+#include "storage/resolve_attribute_vector_type.hpp"
+#include "storage/resolve_segment_type.hpp"
+#include "storage/run_length_segment.hpp"
+#include "storage/segment_accessor.hpp"
+#include "storage/segment_statistics.hpp"
 #include "storage/value_segment.hpp"
 #include "table_scan.hpp"
 #include "type_cast.hpp"
+#include "type_comparison.hpp"
 #include "types.hpp"
 #include "utils/assert.hpp"
 
 namespace opossum {
 
+namespace {
+
+// Appends the offsets of all values that satisfy comparator(value, search_value) to matches. The loop body is free of
+// branches: Every offset is written, but the write position only advances for matching values. This keeps the loop
+// independent of the selectivity and allows the compiler to vectorize the comparisons.
+template <typename T, typename Comparator>
+void scan_values(const T* values, const size_t n_values, const T& search_value, const Comparator& comparator,
+                 std::vector<ChunkOffset>& matches) {
+  const auto previous_match_count = matches.size();
+  matches.resize(previous_match_count + n_values);
+  auto* output = matches.data() + previous_match_count;
+  auto n_matches = size_t{0};
+  for (auto offset = size_t{0}; offset < n_values; ++offset) {
+    output[n_matches] = static_cast<ChunkOffset>(offset);
+    n_matches += static_cast<size_t>(comparator(values[offset], search_value));
+  }
+  matches.resize(previous_match_count + n_matches);
+}
+
+// Scans rows whose values are not stored consecutively, e.g., the rows referenced by a reference segment. value_of(
+// index) gathers the value of row index, and first_offset + index is appended to matches if the value satisfies the
+// predicate.
+//
+// The branch-free loop of scan_values costs the same for every selectivity. For numeric values and few matches, it
+// is considerably faster to gather the values into a buffer, compare them with the SIMD kernels, and only visit the
+// set bits. The rows are therefore processed in batches with the SIMD kernels until a batch turns out to have many
+// matches. Then, the remaining rows are scanned with the branch-free loop, which is also used for few rows.
+template <typename T, typename ValueOf>
+void scan_gathered_values(const size_t n_rows, const ValueOf& value_of, const ScanType scan_type, const T& search_value,
+                          const ChunkOffset first_offset, std::vector<ChunkOffset>& matches) {
+  constexpr auto BATCH_SIZE = size_t{1024};
+  auto index = size_t{0};
+  if constexpr (std::is_arithmetic_v<T>) {
+    if (n_rows >= BATCH_SIZE / 16) {
+      auto values = std::array<T, BATCH_SIZE>{};
+      auto bitmask = std::array<uint64_t, BATCH_SIZE / 64>{};
+      while (index < n_rows) {
+        const auto batch_size = std::min(BATCH_SIZE, n_rows - index);
+        for (auto batch_index = size_t{0}; batch_index < batch_size; ++batch_index) {
+          values[batch_index] = value_of(index + batch_index);
+        }
+        compare_to_bitmask(values.data(), batch_size, scan_type, search_value, bitmask.data());
+
+        const auto previous_match_count = matches.size();
+        append_matching_offsets(bitmask.data(), batch_size, matches);
+        const auto batch_first_offset = static_cast<ChunkOffset>(first_offset + index);
+        for (auto match_iter = matches.begin() + previous_match_count; match_iter != matches.end(); ++match_iter) {
+          *match_iter += batch_first_offset;
+        }
+        index += batch_size;
+        if ((matches.size() - previous_match_count) * 8 > batch_size) break;
+      }
+    }
+  }
+
+  with_comparator(scan_type, [&](const auto& comparator) {
+    const auto previous_match_count = matches.size();
+    matches.resize(previous_match_count + (n_rows - index));
+    auto* output = matches.data() + previous_match_count;
+    auto n_matches = size_t{0};
+    for (; index < n_rows; ++index) {
+      output[n_matches] = static_cast<ChunkOffset>(first_offset + index);
+      n_matches += static_cast<size_t>(comparator(value_of(index), search_value));
+    }
+    matches.resize(previous_match_count + n_matches);
+  });
+}
+
+// Appends the offsets [first_offset, first_offset + n_rows) to matches.
+void append_offset_range(const ChunkOffset first_offset, const size_t n_rows, std::vector<ChunkOffset>& matches) {
+  const auto previous_match_count = matches.size();
+  matches.resize(previous_match_count + n_rows);
+  std::iota(matches.begin() + previous_match_count, matches.end(), first_offset);
+}
+
+// Sets the first bit_count bits of the bitmask and clears the remaining bits of the last word.
+void set_leading_bits(uint64_t* bitmask, const size_t bit_count) {
+  std::fill_n(bitmask, bit_count / 64, ~uint64_t{0});
+  if (bit_count % 64 != 0) bitmask[bit_count / 64] = (uint64_t{1} << (bit_count % 64)) - 1;
+}
+
+// Sets the bits [first_bit, last_bit) of the bitmask.
+void set_bit_range(uint64_t* bitmask, const size_t first_bit, const size_t last_bit) {
+  for (auto bit = first_bit; bit < last_bit;) {
+    const auto bit_in_word = bit % 64;
+    const auto bit_count = std::min(64 - bit_in_word, last_bit - bit);
+    const auto word_mask = bit_count == 64 ? ~uint64_t{0} : ((uint64_t{1} << bit_count) - 1) << bit_in_word;
+    bitmask[bit / 64] |= word_mask;
+    bit += bit_count;
+  }
+}
+
+// Returns a bitmap that includes all n_rows rows of the chunk.
+std::shared_ptr<const PosList> all_matches(const ChunkID chunk_id, const size_t n_rows) {
+  auto bitmask = std::vector<uint64_t>(bitmask_word_count(n_rows));
+  set_leading_bits(bitmask.data(), n_rows);
+  return std::make_shared<PosList>(chunk_id, std::move(bitmask));
+}
+
+// Returns the PosList of the segments of the chunk if they are all reference segments that share the same bitmap.
+std::shared_ptr<const PosList> shared_bitmap_pos_list(const Chunk& chunk) {
+  auto bitmap_pos_list = std::shared_ptr<const PosList>{};
+  const auto n_segments = chunk.column_count();
+  for (auto column_id = ColumnID{0}; column_id < n_segments; ++column_id) {
+    const auto reference_segment = std::dynamic_pointer_cast<const ReferenceSegment>(chunk.get_segment(column_id));
+    if (!reference_segment) return nullptr;
+    const auto pos_list = reference_segment->pos_list();
+    if (!bitmap_pos_list) {
+      if (!pos_list->is_bitmap()) return nullptr;
+      bitmap_pos_list = pos_list;
+    } else if (pos_list != bitmap_pos_list) {
+      return nullptr;
+    }
+  }
+  return bitmap_pos_list;
+}
+
+}  // namespace
+
 TableScan::TableScan(const std::shared_ptr<const AbstractOperator>& in, const ColumnID column_id,
-                     const ScanType scan_type, const AllTypeVariant search_value)
-    : _in{in}, _column_id{column_id}, _scan_type{scan_type}, _search_value{search_value} {}
+                     const ScanType scan_type, const AllTypeVariant search_value, const ExecutionMode execution_mode)
+    : AbstractPipelineOperator{in},
+      _column_id{column_id},
+      _scan_type{scan_type},
+      _search_value{search_value},
+      _execution_mode{execution_mode} {}
 
 ColumnID TableScan::column_id() const { return _column_id; }
 
@@ -26,28 +171,185 @@ ScanType TableScan::scan_type() const { return _scan_type; }
 
 const AllTypeVariant& TableScan::search_value() const { return _search_value; }
 
+TableScan::ExecutionMode TableScan::execution_mode() const { return _execution_mode; }
+
+void TableScan::process_morsel(const std::shared_ptr<const Table>& table, Morsel& morsel) const {
+  const auto n_rows = size_t{morsel.end - morsel.begin};
+  auto n_selected_rows = size_t{0};
+  for (const auto word : morsel.bitmask) {
+    n_selected_rows += std::popcount(word);
+  }
+  if (n_selected_rows == 0) return;
+
+  const auto chunk_ptr = table->get_chunk(morsel.chunk_id);
+  const auto segment_ptr = chunk_ptr->get_segment(_column_id);
+  const auto data_type = table->column_type(_column_id);
+  const auto statistics = chunk_ptr->get_statistics(_column_id);
+  const auto outcome = statistics ? statistics->classify(_scan_type, _search_value) : RangeOutcome::SomeRows;
+  if (outcome == RangeOutcome::AllRows) return;
+  if (outcome == RangeOutcome::NoRows) {
+    std::fill(morsel.bitmask.begin(), morsel.bitmask.end(), uint64_t{0});
+    return;
+  }
+
+  // if many rows of the morsel are still selected, the whole range of a
+  // base segment is scanned like a segment of a base table, and the result
+  // is combined with the selected rows.
+  const auto ref_segment_ptr = std::dynamic_pointer_cast<const ReferenceSegment>(segment_ptr);
+  if (!ref_segment_ptr &&
+      static_cast<double>(n_selected_rows) >= MIN_BITMAP_SELECTIVITY * static_cast<double>(n_rows)) {
+    auto range_bitmask = std::vector<uint64_t>(morsel.bitmask.size());
+    resolve_data_type(data_type, [&](auto type) {
+      using Type = typename decltype(type)::type;
+      resolve_segment_type<Type>(*segment_ptr, [&](const auto& typed_segment) {
+        using SegmentType = std::decay_t<decltype(typed_segment)>;
+        if constexpr (!std::is_same_v<SegmentType, ReferenceSegment>) {
+          scan_range(typed_segment, morsel.begin, morsel.end, range_bitmask.data());
+        }
+      });
+    });
+    for (auto word_index = size_t{0}; word_index < morsel.bitmask.size(); ++word_index) {
+      morsel.bitmask[word_index] &= range_bitmask[word_index];
+    }
+    return;
+  }
+
+  // otherwise, only the selected rows are scanned like the rows of a
+  // reference segment that points to them. If the segment is a reference
+  // segment itself, the new reference segment points to the rows that it
+  // references instead.
+  auto chunk_offsets = std::vector<ChunkOffset>{};
+  chunk_offsets.reserve(n_selected_rows);
+  append_matching_offsets(morsel.bitmask.data(), n_rows, chunk_offsets);
+  for (auto& chunk_offset : chunk_offsets) {
+    chunk_offset += morsel.begin;
+  }
+
+  auto morsel_segment_ptr = std::shared_ptr<const ReferenceSegment>{};
+  if (ref_segment_ptr) {
+    const auto& pos_list = *ref_segment_ptr->pos_list();
+    auto morsel_pos_list = std::shared_ptr<const PosList>{};
+    if (pos_list.references_single_chunk()) {
+      auto referenced_chunk_offsets = std::vector<ChunkOffset>(chunk_offsets.size());
+      if (pos_list.is_bitmap()) {
+        std::transform(chunk_offsets.cbegin(), chunk_offsets.cend(), referenced_chunk_offsets.begin(),
+                       [&](const auto offset) { return pos_list[offset].chunk_offset; });
+      } else {
+        const auto& pos_list_chunk_offsets = pos_list.chunk_offsets();
+        std::transform(chunk_offsets.cbegin(), chunk_offsets.cend(), referenced_chunk_offsets.begin(),
+                       [&](const auto offset) { return pos_list_chunk_offsets[offset]; });
+      }
+      morsel_pos_list = std::make_shared<PosList>(pos_list.common_chunk_id(), std::move(referenced_chunk_offsets));
+    } else {
+      const auto& row_ids = pos_list.row_ids();
+      auto referenced_row_ids = std::vector<RowID>(chunk_offsets.size());
+      std::transform(chunk_offsets.cbegin(), chunk_offsets.cend(), referenced_row_ids.begin(),
+                     [&](const auto offset) { return row_ids[offset]; });
+      morsel_pos_list = std::make_shared<PosList>(std::move(referenced_row_ids));
+    }
+    morsel_segment_ptr = std::make_shared<ReferenceSegment>(ref_segment_ptr->referenced_table(),
+                                                            ref_segment_ptr->referenced_column_id(), morsel_pos_list);
+  } else {
+    morsel_segment_ptr = std::make_shared<ReferenceSegment>(table, _column_id,
+                                                            std::make_shared<PosList>(morsel.chunk_id, chunk_offsets));
+  }
+
+  // the matches are indexes into chunk_offsets.
+  const auto matches = scan_chunk(morsel_segment_ptr, morsel.chunk_id, data_type);
+  std::fill(morsel.bitmask.begin(), morsel.bitmask.end(), uint64_t{0});
+  for (const auto row_id : *matches) {
+    const auto offset_in_morsel = chunk_offsets[row_id.chunk_offset] - morsel.begin;
+    morsel.bitmask[offset_in_morsel / 64] |= uint64_t{1} << (offset_in_morsel % 64);
+  }
+}
+
+void TableScan::process_batch(Batch& batch) const {
+  auto& selection = batch.selection();
+  if (selection.empty()) return;
+
+  const auto& table = batch.table();
+  const auto chunk_ptr = table->get_chunk(batch.chunk_id());
+  const auto statistics = chunk_ptr->get_statistics(_column_id);
+  const auto outcome = statistics ? statistics->classify(_scan_type, _search_value) : RangeOutcome::SomeRows;
+  if (outcome == RangeOutcome::AllRows) return;
+  if (outcome == RangeOutcome::NoRows) {
+    selection.clear();
+    return;
+  }
+
+  // if many rows of the batch are still selected, the range of a base
+  // segment is scanned with the same kernels as morsels, which work on the
+  // encoded values, and the selection keeps the rows whose bit is set.
+  const auto segment_ptr = chunk_ptr->get_segment(_column_id);
+  const auto data_type = table->column_type(_column_id);
+  if (!std::dynamic_pointer_cast<const ReferenceSegment>(segment_ptr) &&
+      static_cast<double>(selection.size()) >= MIN_BITMAP_SELECTIVITY * static_cast<double>(batch.size())) {
+    auto bitmask = std::array<uint64_t, bitmask_word_count(Batch::MAX_SIZE)>{};
+    resolve_data_type(data_type, [&](auto type) {
+      using Type = typename decltype(type)::type;
+      resolve_segment_type<Type>(*segment_ptr, [&](const auto& typed_segment) {
+        using SegmentType = std::decay_t<decltype(typed_segment)>;
+        if constexpr (!std::is_same_v<SegmentType, ReferenceSegment>) {
+          scan_range(typed_segment, batch.begin(), batch.end(), bitmask.data());
+        }
+      });
+    });
+
+    if (selection.size() == batch.size()) {
+      auto new_selection = std::array<uint16_t, selection_buffer_size(Batch::MAX_SIZE)>{};
+      const auto n_selected =
+          bitmask_to_selection(bitmask.data(), batch.size(), new_selection.data(), new_selection.size());
+      selection.assign(new_selection.cbegin(), new_selection.cbegin() + n_selected);
+    } else {
+      auto n_selected = size_t{0};
+      for (const auto offset : selection) {
+        selection[n_selected] = offset;
+        n_selected += (bitmask[offset / 64] >> (offset % 64)) & 1;
+      }
+      selection.resize(n_selected);
+    }
+    return;
+  }
+
+  // otherwise, the values of the selected rows are decoded into the batch,
+  // and the selection is compacted in place without branches: each offset
+  // is written, but only kept if the next offset must not overwrite it.
+  resolve_data_type(data_type, [&](auto type) {
+    using Type = typename decltype(type)::type;
+    const auto* values = batch.values<Type>(_column_id);
+    const auto search_value = type_cast<Type>(_search_value);
+    with_comparator(_scan_type, [&](const auto& comparator) {
+      auto n_selected = size_t{0};
+      for (const auto offset : selection) {
+        selection[n_selected] = offset;
+        n_selected += static_cast<size_t>(comparator(values[offset], search_value));
+      }
+      selection.resize(n_selected);
+    });
+  });
+}
+
 std::shared_ptr<const Table> TableScan::_on_execute() {
-  auto in_table_ptr = _in->get_output();
+  auto in_table_ptr = _left_input_table();
   auto n_chunks = in_table_ptr->chunk_count();
   auto data_type = in_table_ptr->column_type(_column_id);
 
   // accumulate the scan results here. We will have one chunk
   // for each chunk in the input table (that has at least one
-  // row matching the filter).
-  auto result_chunks_ptr = std::make_shared<std::vector<std::shared_ptr<Chunk>>>();
-
-  // iterate over all chunks in the input table and process each chunk seperately.
-  // We first determine which rows should be included in the output table,
-  // i.e. which rows match the filter condition. Then, we construct new
-  // chunks that consist of reference segments and make up the output table.
-  for (auto chunk_id = ChunkID{0}; chunk_id < n_chunks; ++chunk_id) {
-    auto chunk_ptr = in_table_ptr->get_chunk(chunk_id);
-    auto include_rows_ptr = scan_chunk(chunk_ptr, chunk_id, data_type);
-    if (!include_rows_ptr->empty()) {
-      auto out_chunk = subset_chunk(in_table_ptr, chunk_ptr, chunk_id, include_rows_ptr);
-      result_chunks_ptr->emplace_back(out_chunk);
+  // row matching the filter). Each chunk writes to its own
+  // slot, so the chunks can be scanned in parallel.
+  auto result_chunks = std::vector<std::shared_ptr<Chunk>>(n_chunks);
+  const auto scan_chunk_at = [&](const size_t chunk_index) {
+    result_chunks[chunk_index] = scan_input_chunk(in_table_ptr, static_cast<ChunkID>(chunk_index), data_type);
+  };
+  if (_execution_mode == ExecutionMode::ChunkParallel) {
+    WorkerPool::get().parallel_for(n_chunks, scan_chunk_at);
+  } else {
+    for (auto chunk_index = size_t{0}; chunk_index < n_chunks; ++chunk_index) {
+      scan_chunk_at(chunk_index);
     }
   }
+  std::erase(result_chunks, nullptr);
 
   // build the output table. There are two cases:
   // (1) if the result set is empty (i.e. no rows match
@@ -58,233 +360,778 @@ std::shared_ptr<const Table> TableScan::_on_execute() {
   // defintions.
   // We copy the column definitions from the input table by
   // using Table's specialized constructors.
-  if (result_chunks_ptr->empty()) {
+  if (result_chunks.empty()) {
     return std::make_shared<Table>(in_table_ptr);
   } else {
-    return std::make_shared<Table>(*result_chunks_ptr, in_table_ptr);
+    return std::make_shared<Table>(result_chunks, in_table_ptr);
   }
 }
 
-const std::shared_ptr<std::vector<ChunkOffset>> TableScan::scan_chunk(const std::shared_ptr<const Chunk> chunk_ptr,
-                                                                      const ChunkID chunk_id,
-                                                                      const std::string data_type) const {
+std::shared_ptr<Chunk> TableScan::scan_input_chunk(const std::shared_ptr<const Table>& table_ptr,
+                                                   const ChunkID chunk_id, const std::string& data_type) const {
+  // We first determine which rows should be included in the output table,
+  // i.e. which rows match the filter condition. Then, we construct a new
+  // chunk that consists of reference segments and becomes part of the output table.
+  // The min/max statistics of a chunk are checked first: Chunks that cannot contain a match are skipped, and if
+  // every row matches, the segment does not have to be scanned either.
+  // Chunks whose segments all reference the same bitmap, e.g., the output chunks of a previous scan with many matches,
+  // are scanned in the space of the referenced chunk instead (see scan_bitmap_chunk).
+  auto chunk_ptr = table_ptr->get_chunk(chunk_id);
+  if (const auto bitmap_pos_list = shared_bitmap_pos_list(*chunk_ptr)) {
+    return scan_bitmap_chunk(chunk_ptr, bitmap_pos_list, data_type);
+  }
+
+  const auto statistics = chunk_ptr->get_statistics(_column_id);
+  const auto outcome = statistics ? statistics->classify(_scan_type, _search_value) : RangeOutcome::SomeRows;
+  if (outcome == RangeOutcome::NoRows) return nullptr;
+
+  auto matches = std::shared_ptr<const PosList>{};
+  if (outcome == RangeOutcome::AllRows) {
+    matches = all_matches(chunk_id, chunk_ptr->size());
+  } else {
+    matches = scan_chunk(chunk_ptr->get_segment(_column_id), chunk_id, data_type);
+  }
+  if (matches->empty()) return nullptr;
+  return subset_chunk(table_ptr, chunk_ptr, matches);
+}
+
+std::shared_ptr<const PosList> TableScan::scan_chunk(const std::shared_ptr<const AbstractSegment> segment_ptr,
+                                                    const ChunkID chunk_id, const std::string& data_type) const {
   // determine the set of rows that should be included in the scan output,
   // i.e. find the row indexes that match the filter condition.
 
-  // accumulate the indexes of the rows that should be included in the output in include_rows_ptr.
-  // The container is initialized later on when we perform the actual filtering.
+  // accumulate the positions of the rows that should be included in the output in matches.
+  // The PosList is created later on when we perform the actual filtering.
   // This declaration is needed so that we can pass the object outside of the
   // scope of the lambda below.
-  std::shared_ptr<std::vector<ChunkOffset>> include_rows_ptr;
+  std::shared_ptr<const PosList> matches;
 
-  // get segment that we want to filter on and cast it to the right type. Then,
+  // cast the segment that we want to filter on to the right type. Then,
   // perform a scan on the segment based on the segment type (value/dict/reference).
-  auto segment_ptr = chunk_ptr->get_segment(_column_id);
   resolve_data_type(data_type, [&](auto type) {
     using Type = typename decltype(type)::type;
     // case 1: segment is value segment
-    const auto typed_value_segment_ptr = std::dynamic_pointer_cast<ValueSegment<Type>>(segment_ptr);
+    const auto typed_value_segment_ptr = std::dynamic_pointer_cast<const ValueSegment<Type>>(segment_ptr);
     if (typed_value_segment_ptr) {
-      include_rows_ptr = scan_segment<Type>(typed_value_segment_ptr);
+      matches = scan_segment<Type>(typed_value_segment_ptr, chunk_id);
       return;
     }
     // case 2: segment is dictionary segment
-    const auto typed_dict_segment_ptr = std::dynamic_pointer_cast<DictionarySegment<Type>>(segment_ptr);
+    const auto typed_dict_segment_ptr = std::dynamic_pointer_cast<const DictionarySegment<Type>>(segment_ptr);
     if (typed_dict_segment_ptr) {
-      include_rows_ptr = scan_segment<Type>(typed_dict_segment_ptr);
+      matches = scan_segment<Type>(typed_dict_segment_ptr, chunk_id);
       return;
     }
-    // case 3: segment is reference segment
-    const auto ref_segment_ptr = std::dynamic_pointer_cast<ReferenceSegment>(segment_ptr);
+    // case 3: segment is front-coded dictionary segment, which only exists for strings
+    if constexpr (std::is_same_v<Type, std::string>) {
+      const auto typed_front_coded_segment_ptr =
+          std::dynamic_pointer_cast<const FrontCodedDictionarySegment<Type>>(segment_ptr);
+      if (typed_front_coded_segment_ptr) {
+        matches = scan_segment<Type>(typed_front_coded_segment_ptr, chunk_id);
+        return;
+      }
+    }
+    // case 4: segment is run-length segment
+    const auto typed_run_length_segment_ptr = std::dynamic_pointer_cast<const RunLengthSegment<Type>>(segment_ptr);
+    if (typed_run_length_segment_ptr) {
+      matches = scan_segment<Type>(typed_run_length_segment_ptr, chunk_id);
+      return;
+    }
+    // case 5: segment is frame-of-reference segment, which only exists for integral types
+    if constexpr (std::is_integral_v<Type>) {
+      const auto typed_for_segment_ptr = std::dynamic_pointer_cast<const FrameOfReferenceSegment<Type>>(segment_ptr);
+      if (typed_for_segment_ptr) {
+        matches = scan_segment<Type>(typed_for_segment_ptr, chunk_id);
+        return;
+      }
+    }
+    // case 6: segment is reference segment
+    const auto ref_segment_ptr = std::dynamic_pointer_cast<const ReferenceSegment>(segment_ptr);
     if (ref_segment_ptr) {
-      include_rows_ptr = scan_segment<Type>(ref_segment_ptr);
+      matches = scan_segment<Type>(ref_segment_ptr, chunk_id);
       return;
     }
 
-    // we do not support any segment types beyond value, dict, and reference segments
+    // we do not support any segment types beyond the ones above
     throw std::runtime_error("unrecognized segment class at chunk id " + std::to_string(chunk_id) + " and column id " +
                              std::to_string(_column_id));
   });
 
-  include_rows_ptr->shrink_to_fit();
-  return include_rows_ptr;
+  return matches;
+}
+
+std::shared_ptr<Chunk> TableScan::scan_bitmap_chunk(const std::shared_ptr<const Chunk> chunk_ptr,
+                                                    const std::shared_ptr<const PosList>& bitmap_pos_list,
+                                                    const std::string& data_type) const {
+  // all segments of the chunk reference the rows of the same chunk that are
+  // set in the bitmap. Instead of gathering the referenced values, the
+  // whole referenced segment is scanned like a segment of a base table, and
+  // its matches are combined with the bitmap. The output segments reference
+  // the same chunk, so no offsets are materialized if many rows match.
+  const auto scanned_segment_ptr = std::static_pointer_cast<const ReferenceSegment>(chunk_ptr->get_segment(_column_id));
+  const auto referenced_chunk_id = bitmap_pos_list->common_chunk_id();
+  const auto referenced_column_id = scanned_segment_ptr->referenced_column_id();
+  const auto referenced_chunk_ptr = scanned_segment_ptr->referenced_table()->get_chunk(referenced_chunk_id);
+  const auto& bitmap = bitmap_pos_list->bitmap();
+
+  auto matches = std::shared_ptr<const PosList>{};
+  const auto statistics = referenced_chunk_ptr->get_statistics(referenced_column_id);
+  const auto outcome = statistics ? statistics->classify(_scan_type, _search_value) : RangeOutcome::SomeRows;
+  if (outcome == RangeOutcome::NoRows) return nullptr;
+  if (outcome == RangeOutcome::AllRows) {
+    matches = bitmap_pos_list;
+  } else {
+    const auto referenced_matches =
+        scan_chunk(referenced_chunk_ptr->get_segment(referenced_column_id), referenced_chunk_id, data_type);
+    if (referenced_matches->is_bitmap()) {
+      auto bitmask = referenced_matches->bitmap();
+      for (auto word_index = size_t{0}; word_index < bitmask.size(); ++word_index) {
+        bitmask[word_index] &= word_index < bitmap.size() ? bitmap[word_index] : uint64_t{0};
+      }
+      matches = matches_from_bitmask(referenced_chunk_id, std::move(bitmask), referenced_chunk_ptr->size());
+    } else {
+      // few rows match, so the bitmap is only probed for these rows.
+      auto offsets = referenced_matches->chunk_offsets();
+      const auto is_set = [&](const ChunkOffset offset) {
+        return offset / 64 < bitmap.size() && (bitmap[offset / 64] >> (offset % 64) & 1) != 0;
+      };
+      offsets.erase(std::remove_if(offsets.begin(), offsets.end(), [&](const auto offset) { return !is_set(offset); }),
+                    offsets.end());
+      matches = matches_from_offsets(referenced_chunk_id, std::move(offsets), referenced_chunk_ptr->size());
+    }
+  }
+  if (matches->empty()) return nullptr;
+
+  auto out_chunk_ptr = std::make_shared<Chunk>();
+  const auto n_segments = chunk_ptr->column_count();
+  for (auto column_id = ColumnID{0}; column_id < n_segments; ++column_id) {
+    const auto segment_ptr = std::static_pointer_cast<const ReferenceSegment>(chunk_ptr->get_segment(column_id));
+    out_chunk_ptr->add_segment(std::make_shared<ReferenceSegment>(segment_ptr->referenced_table(),
+                                                                  segment_ptr->referenced_column_id(), matches));
+  }
+  return out_chunk_ptr;
+}
+
+std::shared_ptr<const PosList> TableScan::matches_from_bitmask(const ChunkID chunk_id, std::vector<uint64_t>&& bitmask,
+                                                               const size_t n_rows) {
+  auto n_matches = size_t{0};
+  for (const auto word : bitmask) {
+    n_matches += std::popcount(word);
+  }
+  if (static_cast<double>(n_matches) >= MIN_BITMAP_SELECTIVITY * static_cast<double>(n_rows)) {
+    return std::make_shared<PosList>(chunk_id, std::move(bitmask));
+  }
+
+  auto offsets = std::vector<ChunkOffset>{};
+  offsets.reserve(n_matches);
+  append_matching_offsets(bitmask.data(), n_rows, offsets);
+  return std::make_shared<PosList>(chunk_id, std::move(offsets));
 }
 
-const std::shared_ptr<Chunk> TableScan::subset_chunk(
-    const std::shared_ptr<const Table> table_ptr, const std::shared_ptr<const Chunk> chunk_ptr, const ChunkID chunk_id,
-    const std::shared_ptr<std::vector<ChunkOffset>>& include_rows_ptr) const {
+std::shared_ptr<const PosList> TableScan::matches_from_offsets(const ChunkID chunk_id,
+                                                               std::vector<ChunkOffset>&& offsets,
+                                                               const size_t n_rows) {
+  if (static_cast<double>(offsets.size()) < MIN_BITMAP_SELECTIVITY * static_cast<double>(n_rows)) {
+    offsets.shrink_to_fit();
+    return std::make_shared<PosList>(chunk_id, std::move(offsets));
+  }
+
+  // the offsets are ascending, so the bitmap represents the same positions.
+  auto bitmask = std::vector<uint64_t>(bitmask_word_count(n_rows));
+  for (const auto offset : offsets) {
+    bitmask[offset / 64] |= uint64_t{1} << (offset % 64);
+  }
+  return std::make_shared<PosList>(chunk_id, std::move(bitmask));
+}
+
+std::shared_ptr<Chunk> TableScan::subset_chunk(const std::shared_ptr<const Table> table_ptr,
+                                              const std::shared_ptr<const Chunk> chunk_ptr,
+                                              const std::shared_ptr<const PosList>& matches) {
   // create a chunk that consists of reference segments that point
   // only to the values that we want to include in the output table.
-  // The values that we want to include are given in include_rows_ptr.
+  // The positions of the rows that we want to include are given in matches.
 
   // accumulate the new reference segments in this chunk.
   auto out_chunk_ptr = std::make_shared<Chunk>();
 
+  // the offsets of the matching rows in the input chunk. They are only
+  // needed, and decoded from a bitmap if necessary, if there are reference
+  // segments to filter.
+  auto match_offsets = std::vector<ChunkOffset>{};
+
+  // reference segments of the same input chunk usually share their position
+  // list. Each of them is filtered only once, and the output reference
+  // segments share the filtered position list again.
+  auto filtered_pos_lists = std::unordered_map<const PosList*, std::shared_ptr<const PosList>>{};
+
   // we convert each segment to a reference segment independently
   auto n_segments = chunk_ptr->column_count();
   for (auto col_id = ColumnID{0}; col_id < n_segments; ++col_id) {
     auto segment_ptr = chunk_ptr->get_segment(col_id);
-    auto data_type = table_ptr->column_type(col_id);
-    resolve_data_type(data_type, [&](auto type) {
-      using Type = typename decltype(type)::type;
 
-      // case 1: segment is value segment or dictionary segment
-      // the new reference segment can point directly to the existing segment. We
-      // just need to create a new reference segments with the indexes of the
-      // rows that we want to keep (i.e. the values in include_rows_ptr).
-      const auto typed_value_segment_ptr = std::dynamic_pointer_cast<ValueSegment<Type>>(segment_ptr);
-      const auto typed_dict_segment_ptr = std::dynamic_pointer_cast<DictionarySegment<Type>>(segment_ptr);
-      if (typed_value_segment_ptr || typed_dict_segment_ptr) {
-        auto pos_list = std::make_shared<PosList>();
-        for (const auto& pos : *include_rows_ptr) {
-          pos_list->emplace_back(RowID{chunk_id, pos});
-        }
-        auto new_segment = std::make_shared<ReferenceSegment>(table_ptr, col_id, pos_list);
-        out_chunk_ptr->add_segment(new_segment);
-        return;
-      }
+    // case 1: segment is reference segment
+    // In this case we need to create a new reference segment that points to the table
+    // that the existing reference segment points to. This is needed to keep the number
+    // of indirections low.
+    const auto ref_segment_ptr = std::dynamic_pointer_cast<ReferenceSegment>(segment_ptr);
+    if (ref_segment_ptr) {
+      auto referenced_table = ref_segment_ptr->referenced_table();
+      auto referenced_column_id = ref_segment_ptr->referenced_column_id();
+      const auto& pos_list = *ref_segment_ptr->pos_list();
+      auto& filtered_pos_list = filtered_pos_lists[&pos_list];
+      if (!filtered_pos_list) {
+        if (match_offsets.empty()) match_offsets = matches->materialize_chunk_offsets();
 
-      // case 2: segment is reference segment
-      // In this case we need to create a new reference segment that points to the table
-      // that the existing reference segment points to. This is needed to keep the number
-      // of indirections low.
-      const auto ref_segment_ptr = std::dynamic_pointer_cast<ReferenceSegment>(segment_ptr);
-      if (ref_segment_ptr) {
-        auto referenced_table = ref_segment_ptr->referenced_table();
-        auto referenced_column_id = ref_segment_ptr->referenced_column_id();
-        auto pos_list = ref_segment_ptr->pos_list();
-        auto filtered_pos_list = std::make_shared<PosList>();
-        for (const auto& pos : *include_rows_ptr) {
-          filtered_pos_list->emplace_back((*pos_list)[pos]);
+        // if the input positions point to a single chunk, so do the filtered ones.
+        if (pos_list.references_single_chunk()) {
+          const auto bitmap_chunk_offsets =
+              pos_list.is_bitmap() ? pos_list.materialize_chunk_offsets() : std::vector<ChunkOffset>{};
+          const auto& chunk_offsets = pos_list.is_bitmap() ? bitmap_chunk_offsets : pos_list.chunk_offsets();
+          auto filtered_chunk_offsets = std::vector<ChunkOffset>(match_offsets.size());
+          std::transform(match_offsets.cbegin(), match_offsets.cend(), filtered_chunk_offsets.begin(),
+                         [&](const auto pos) { return chunk_offsets[pos]; });
+          filtered_pos_list = std::make_shared<PosList>(pos_list.common_chunk_id(), std::move(filtered_chunk_offsets));
+        } else {
+          const auto& row_ids = pos_list.row_ids();
+          auto filtered_row_ids = std::vector<RowID>(match_offsets.size());
+          std::transform(match_offsets.cbegin(), match_offsets.cend(), filtered_row_ids.begin(),
+                         [&](const auto pos) { return row_ids[pos]; });
+          filtered_pos_list = std::make_shared<PosList>(std::move(filtered_row_ids));
         }
-        auto new_segment =
-            std::make_shared<ReferenceSegment>(referenced_table, referenced_column_id, filtered_pos_list);
-        out_chunk_ptr->add_segment(new_segment);
-        return;
       }
+      auto new_segment = std::make_shared<ReferenceSegment>(referenced_table, referenced_column_id, filtered_pos_list);
+      out_chunk_ptr->add_segment(new_segment);
+      continue;
+    }
 
-      // we do not support any segment types beyond value, dict, and reference segments
-      throw std::runtime_error("unrecognized segment class at chunk id " + std::to_string(chunk_id) +
-                               " and column id " + std::to_string(_column_id));
-    });
+    // case 2: segment holds its values itself (e.g., a value, dictionary, or run-length segment)
+    // the new reference segment can point directly to the existing segment
+    // with the positions of the rows that we want to keep. All of these
+    // reference segments share the positions.
+    auto new_segment = std::make_shared<ReferenceSegment>(table_ptr, col_id, matches);
+    out_chunk_ptr->add_segment(new_segment);
   }
   return out_chunk_ptr;
 }
 
 template <typename T>
-std::shared_ptr<std::vector<ChunkOffset>> TableScan::scan_segment(
-    const std::shared_ptr<const ValueSegment<T>> segment_ptr) const {
+std::shared_ptr<const PosList> TableScan::scan_segment(const std::shared_ptr<const ValueSegment<T>> segment_ptr,
+                                                      const ChunkID chunk_id) const {
   // determine which values match the filter condition in a
-  // value segment.
-  auto include_rows_ptr = std::make_shared<std::vector<ChunkOffset>>();
-  auto values = segment_ptr->values();
-  auto n_values = values.size();
-  for (auto offset = ChunkOffset{0}; offset < n_values; ++offset) {
-    auto value = values[offset];
-    if (matches_search_value<T>(value)) {
-      include_rows_ptr->emplace_back(offset);
-    }
+  // value segment. The scan type is resolved once for the whole
+  // segment so that the inner loop is instantiated for the concrete
+  // comparator.
+  const auto n_values = segment_ptr->size();
+  if constexpr (std::is_arithmetic_v<T>) {
+    // numeric values are compared using the SIMD kernels.
+    auto bitmask = std::vector<uint64_t>(bitmask_word_count(n_values));
+    scan_range(*segment_ptr, ChunkOffset{0}, n_values, bitmask.data());
+    return matches_from_bitmask(chunk_id, std::move(bitmask), n_values);
+  } else {
+    const auto search_value = type_cast<T>(_search_value);
+    auto offsets = std::vector<ChunkOffset>{};
+    with_comparator(_scan_type, [&](const auto& comparator) {
+      scan_values(segment_ptr->values().data(), n_values, search_value, comparator, offsets);
+    });
+    return matches_from_offsets(chunk_id, std::move(offsets), n_values);
+  }
+}
+
+template <typename T>
+void TableScan::scan_range(const ValueSegment<T>& segment, const ChunkOffset begin, const ChunkOffset end,
+                           uint64_t* bitmask) const {
+  const auto* values = segment.values().data() + begin;
+  const auto n_values = size_t{end - begin};
+  const auto search_value = type_cast<T>(_search_value);
+  if constexpr (std::is_arithmetic_v<T>) {
+    compare_to_bitmask(values, n_values, _scan_type, search_value, bitmask);
+  } else {
+    std::fill_n(bitmask, bitmask_word_count(n_values), uint64_t{0});
+    with_comparator(_scan_type, [&](const auto& comparator) {
+      for (auto offset = size_t{0}; offset < n_values; ++offset) {
+        bitmask[offset / 64] |= static_cast<uint64_t>(comparator(values[offset], search_value)) << (offset % 64);
+      }
+    });
   }
-  return include_rows_ptr;
 }
 
 template <typename T>
-std::shared_ptr<std::vector<ChunkOffset>> TableScan::scan_segment(
-    const std::shared_ptr<const DictionarySegment<T>> segment_ptr) const {
+std::shared_ptr<const PosList> TableScan::scan_segment(const std::shared_ptr<const DictionarySegment<T>> segment_ptr,
+                                                      const ChunkID chunk_id) const {
+  return scan_dictionary_segment(*segment_ptr, chunk_id);
+}
+
+template <typename T>
+std::shared_ptr<const PosList> TableScan::scan_segment(
+    const std::shared_ptr<const FrontCodedDictionarySegment<T>> segment_ptr, const ChunkID chunk_id) const {
+  // the front-coded dictionary is only accessed for the translation into value id space.
+  return scan_dictionary_segment(*segment_ptr, chunk_id);
+}
+
+template <typename DictionarySegmentType>
+std::shared_ptr<const PosList> TableScan::scan_dictionary_segment(const DictionarySegmentType& segment,
+                                                                 const ChunkID chunk_id) const {
   // determine which values match the filter condition in a
   // dictionary segment.
-  // The current implementation uses an unoptimized approach where
-  // we unpack each value in the dictionary segment and check the
-  // condition. We could improve performance by making use of the
-  // ordered dictionary directly.
-  auto include_rows_ptr = std::make_shared<std::vector<ChunkOffset>>();
-  auto dictionary = segment_ptr->dictionary();
-  auto attribute_vector_ptr = segment_ptr->attribute_vector();
-  auto n_values = attribute_vector_ptr->size();
-  for (auto offset = ChunkOffset{0}; offset < n_values; ++offset) {
-    auto value = dictionary[attribute_vector_ptr->get(offset)];
-    if (matches_search_value<T>(value)) {
-      include_rows_ptr->emplace_back(offset);
-    }
+  // Because the dictionary is sorted, the filter condition can be
+  // translated into a condition on value ids once per segment. We then
+  // compare the codes in the attribute vector directly and never look
+  // up a value in the dictionary.
+  auto attribute_vector_ptr = segment.attribute_vector();
+  auto n_values = static_cast<ChunkOffset>(attribute_vector_ptr->size());
+
+  const auto value_id_predicate = translate_to_value_id_predicate(segment);
+  if (value_id_predicate.outcome == ValueIDPredicate::Outcome::NoRows) {
+    return std::make_shared<PosList>(chunk_id, std::vector<ChunkOffset>{});
   }
-  return include_rows_ptr;
+
+  if (value_id_predicate.outcome == ValueIDPredicate::Outcome::AllRows) {
+    return all_matches(chunk_id, n_values);
+  }
+
+  auto bitmask = std::vector<uint64_t>(bitmask_word_count(n_values));
+  scan_value_id_range(*attribute_vector_ptr, value_id_predicate, ChunkOffset{0}, n_values, bitmask.data());
+  return matches_from_bitmask(chunk_id, std::move(bitmask), n_values);
 }
 
 template <typename T>
-std::shared_ptr<std::vector<ChunkOffset>> TableScan::scan_segment(
-    const std::shared_ptr<const ReferenceSegment> segment_ptr) const {
-  // determine which values match the filter condition in a
-  // reference segment.
-  // We cannot determine if a row matches the filter condition
-  // based just on the information in the reference segment. We
-  // need to go to the table that the reference segment points to
-  // in order to retrieve the actual values and perform the filtering.
-  // We need to treat the reference segment differently based on whether
-  // it points to a value segment or a dictionary segment.
-
-  auto include_rows_ptr = std::make_shared<std::vector<ChunkOffset>>();
-  auto referenced_table_ptr = segment_ptr->referenced_table();
-  auto referenced_column_id = segment_ptr->referenced_column_id();
-  auto pos_list_ptr = segment_ptr->pos_list();
-  auto n_values = pos_list_ptr->size();
-
-  // iterate over all rows in the reference segment. Retrieve the
-  // segment that the reference segment points to and get the actual
-  // value from that segment.
-  for (auto offset = ChunkOffset{0}; offset < n_values; ++offset) {
-    auto row_id = (*pos_list_ptr)[offset];
-    auto chunk_id = row_id.chunk_id;
-    auto chunk_offset = row_id.chunk_offset;
-    auto referenced_segment_ptr = referenced_table_ptr->get_chunk(chunk_id)->get_segment(referenced_column_id);
-
-    // referenced segment is ValueSegment
-    const auto typed_value_segment_ptr = std::dynamic_pointer_cast<ValueSegment<T>>(referenced_segment_ptr);
-    if (typed_value_segment_ptr) {
-      auto value = (typed_value_segment_ptr->values())[chunk_offset];
-      if (matches_search_value<T>(value)) {
-        include_rows_ptr->emplace_back(offset);
+void TableScan::scan_range(const DictionarySegment<T>& segment, const ChunkOffset begin, const ChunkOffset end,
+                           uint64_t* bitmask) const {
+  scan_dictionary_range(segment, begin, end, bitmask);
+}
+
+template <typename T>
+void TableScan::scan_range(const FrontCodedDictionarySegment<T>& segment, const ChunkOffset begin,
+                           const ChunkOffset end, uint64_t* bitmask) const {
+  scan_dictionary_range(segment, begin, end, bitmask);
+}
+
+template <typename DictionarySegmentType>
+void TableScan::scan_dictionary_range(const DictionarySegmentType& segment, const ChunkOffset begin,
+                                      const ChunkOffset end, uint64_t* bitmask) const {
+  const auto n_values = size_t{end - begin};
+  const auto value_id_predicate = translate_to_value_id_predicate(segment);
+  if (value_id_predicate.outcome == ValueIDPredicate::Outcome::NoRows) {
+    std::fill_n(bitmask, bitmask_word_count(n_values), uint64_t{0});
+  } else if (value_id_predicate.outcome == ValueIDPredicate::Outcome::AllRows) {
+    set_leading_bits(bitmask, n_values);
+  } else {
+    scan_value_id_range(*segment.attribute_vector(), value_id_predicate, begin, end, bitmask);
+  }
+}
+
+void TableScan::scan_value_id_range(const AbstractAttributeVector& attribute_vector,
+                                    const ValueIDPredicate& value_id_predicate, const ChunkOffset begin,
+                                    const ChunkOffset end, uint64_t* bitmask) {
+  // the codes are compared using the SIMD kernels. The attribute vector type is
+  // resolved once, so no virtual call is made per row.
+  const auto search_value_id = static_cast<ValueID::base_type>(value_id_predicate.value_id);
+  resolve_attribute_vector_type(attribute_vector, [&](const auto& typed_attribute_vector) {
+    using AttributeVectorType = std::decay_t<decltype(typed_attribute_vector)>;
+    if constexpr (std::is_same_v<AttributeVectorType, BitPackedVector>) {
+      // bit-packed codes are unpacked block by block into a buffer that stays in
+      // the L1 cache, and each block is compared using the SIMD kernels. As begin
+      // is a multiple of 64, so is the position of each block in the range.
+      constexpr auto BLOCK_SIZE = BitPackedVector::BLOCK_SIZE;
+      static_assert(BLOCK_SIZE % 64 == 0, "Blocks must fill whole bitmask words");
+      auto codes = std::array<ValueID::base_type, BLOCK_SIZE>{};
+      for (auto block_index = size_t{begin / BLOCK_SIZE}; block_index * BLOCK_SIZE < end; ++block_index) {
+        typed_attribute_vector.decode_block(block_index, codes.data());
+        const auto block_begin = block_index * BLOCK_SIZE;
+        const auto piece_begin = std::max(block_begin, size_t{begin});
+        const auto piece_end = std::min(block_begin + BLOCK_SIZE, size_t{end});
+        compare_to_bitmask(codes.data() + (piece_begin - block_begin), piece_end - piece_begin,
+                           value_id_predicate.scan_type, search_value_id, bitmask + (piece_begin - begin) / 64);
       }
-      continue;
+    } else {
+      // fixed-width codes are compared in place.
+      const auto& codes = typed_attribute_vector.data();
+      using CodeType = typename std::decay_t<decltype(codes)>::value_type;
+      compare_to_bitmask(codes.data() + begin, size_t{end - begin}, value_id_predicate.scan_type,
+                         static_cast<CodeType>(search_value_id), bitmask);
     }
+  });
+}
 
-    // referenced segment is DictionarySegment
-    const auto typed_dict_segment_ptr = std::dynamic_pointer_cast<DictionarySegment<T>>(referenced_segment_ptr);
-    if (typed_dict_segment_ptr) {
-      auto dictionary = typed_dict_segment_ptr->dictionary();
-      auto attribute_vector_ptr = typed_dict_segment_ptr->attribute_vector();
-      auto value = dictionary[attribute_vector_ptr->get(chunk_offset)];
-      if (matches_search_value<T>(value)) {
-        include_rows_ptr->emplace_back(offset);
-      }
-      continue;
+template <typename T>
+std::shared_ptr<const PosList> TableScan::scan_segment(const std::shared_ptr<const RunLengthSegment<T>> segment_ptr,
+                                                      const ChunkID chunk_id) const {
+  // determine which values match the filter condition in a
+  // run-length segment. The predicate is evaluated once per run, and
+  // the offsets of all rows of a matching run are emitted at once.
+  const auto& values = segment_ptr->values();
+  const auto& end_positions = segment_ptr->end_positions();
+  const auto n_runs = values.size();
+  const auto search_value = type_cast<T>(_search_value);
+
+  // determine the matching runs first so that the output can be
+  // allocated at once.
+  auto run_matches = std::vector<bool>(n_runs);
+  auto n_matching_rows = size_t{0};
+  with_comparator(_scan_type, [&](const auto& comparator) {
+    auto run_begin = ChunkOffset{0};
+    for (auto run_index = size_t{0}; run_index < n_runs; ++run_index) {
+      run_matches[run_index] = comparator(values[run_index], search_value);
+      if (run_matches[run_index]) n_matching_rows += end_positions[run_index] - run_begin + 1;
+      run_begin = end_positions[run_index] + 1;
     }
+  });
 
-    // reference segments can only refer to value segments or dict segments
-    throw std::runtime_error("reference segment refers to invalid segment type");
+  auto offsets = std::vector<ChunkOffset>(n_matching_rows);
+  auto output_iter = offsets.begin();
+  auto run_begin = ChunkOffset{0};
+  for (auto run_index = size_t{0}; run_index < n_runs; ++run_index) {
+    const auto run_end = end_positions[run_index] + 1;
+    if (run_matches[run_index]) {
+      std::iota(output_iter, output_iter + (run_end - run_begin), run_begin);
+      output_iter += run_end - run_begin;
+    }
+    run_begin = run_end;
   }
+  return matches_from_offsets(chunk_id, std::move(offsets), segment_ptr->size());
+}
 
-  return include_rows_ptr;
+template <typename T>
+void TableScan::scan_range(const RunLengthSegment<T>& segment, const ChunkOffset begin, const ChunkOffset end,
+                           uint64_t* bitmask) const {
+  // the predicate is evaluated once per run that overlaps the range, and the
+  // bits of a matching run are set at once.
+  const auto& values = segment.values();
+  const auto& end_positions = segment.end_positions();
+  const auto search_value = type_cast<T>(_search_value);
+  std::fill_n(bitmask, bitmask_word_count(end - begin), uint64_t{0});
+  with_comparator(_scan_type, [&](const auto& comparator) {
+    auto run_index = static_cast<size_t>(std::lower_bound(end_positions.cbegin(), end_positions.cend(), begin) -
+                                         end_positions.cbegin());
+    for (auto run_begin = begin; run_begin < end; ++run_index) {
+      const auto run_end = std::min(static_cast<ChunkOffset>(end_positions[run_index] + 1), end);
+      if (comparator(values[run_index], search_value)) set_bit_range(bitmask, run_begin - begin, run_end - begin);
+      run_begin = run_end;
+    }
+  });
+}
+
+template <typename T>
+std::shared_ptr<const PosList> TableScan::scan_segment(
+    const std::shared_ptr<const FrameOfReferenceSegment<T>> segment_ptr, const ChunkID chunk_id) const {
+  const auto n_values = segment_ptr->size();
+  auto bitmask = std::vector<uint64_t>(bitmask_word_count(n_values));
+  scan_range(*segment_ptr, ChunkOffset{0}, n_values, bitmask.data());
+  return matches_from_bitmask(chunk_id, std::move(bitmask), n_values);
 }
 
 template <typename T>
-bool TableScan::matches_search_value(T value) const {
-  auto search_value = type_cast<T>(_search_value);
+void TableScan::scan_range(const FrameOfReferenceSegment<T>& segment, const ChunkOffset begin, const ChunkOffset end,
+                           uint64_t* bitmask) const {
+  // determine which values match the filter condition in a
+  // frame-of-reference segment. The minimum and maximum of each block
+  // often decide the predicate for the whole block, which is then not
+  // decoded at all. For the remaining blocks, the predicate is rewritten
+  // relative to the block minimum, so the packed offsets can be compared
+  // without adding the minimum to every value first. As begin is a multiple
+  // of 64, so is the position of each block in the range.
+  using UnsignedT = std::make_unsigned_t<T>;
+  constexpr auto BLOCK_SIZE = FrameOfReferenceSegment<T>::BLOCK_SIZE;
+  static_assert(BLOCK_SIZE % 64 == 0, "Blocks must fill whole bitmask words");
+  const auto search_value = type_cast<T>(_search_value);
+
+  auto offsets = std::vector<uint32_t>{};
+  auto values = std::vector<T>{};
+  for (auto block_index = size_t{begin / BLOCK_SIZE}; block_index * BLOCK_SIZE < end; ++block_index) {
+    const auto block_begin = block_index * BLOCK_SIZE;
+    const auto piece_begin = std::max(block_begin, size_t{begin});
+    const auto piece_value_count = std::min(block_begin + BLOCK_SIZE, size_t{end}) - piece_begin;
+    auto* piece_bitmask = bitmask + (piece_begin - begin) / 64;
+    const auto minimum = segment.block_minimum(block_index);
+    const auto maximum = segment.block_maximum(block_index);
+
+    const auto outcome = classify_range(_scan_type, search_value, minimum, maximum);
+    if (outcome == RangeOutcome::NoRows) {
+      std::fill_n(piece_bitmask, bitmask_word_count(piece_value_count), uint64_t{0});
+      continue;
+    }
+    if (outcome == RangeOutcome::AllRows) {
+      set_leading_bits(piece_bitmask, piece_value_count);
+      continue;
+    }
+
+    // offsets of int64 blocks with a very large range do not fit into 32 bits.
+    // These blocks are compared on the decoded values instead.
+    const auto block_range = static_cast<UnsignedT>(static_cast<UnsignedT>(maximum) - static_cast<UnsignedT>(minimum));
+    if (block_range <= std::numeric_limits<uint32_t>::max()) {
+      const auto search_offset =
+          static_cast<uint32_t>(static_cast<UnsignedT>(search_value) - static_cast<UnsignedT>(minimum));
+      offsets.resize(BLOCK_SIZE);
+      segment.decode_block_offsets(block_index, offsets.data());
+      compare_to_bitmask(offsets.data() + (piece_begin - block_begin), piece_value_count, _scan_type, search_offset,
+                         piece_bitmask);
+    } else {
+      values.resize(BLOCK_SIZE);
+      segment.decode_block(block_index, values.data());
+      compare_to_bitmask(values.data() + (piece_begin - block_begin), piece_value_count, _scan_type, search_value,
+                         piece_bitmask);
+    }
+  }
+}
+
+template <typename DictionarySegmentType>
+TableScan::ValueIDPredicate TableScan::translate_to_value_id_predicate(const DictionarySegmentType& segment) const {
+  // lower_bound and upper_bound return INVALID_VALUE_ID if all values in the
+  // dictionary are smaller than the search value. For the translation, we treat
+  // this as "one past the last value id".
+  const auto n_unique_values = ValueID{segment.unique_values_count()};
+  auto lower_bound = segment.lower_bound(_search_value);
+  auto upper_bound = segment.upper_bound(_search_value);
+  if (lower_bound == INVALID_VALUE_ID) lower_bound = n_unique_values;
+  if (upper_bound == INVALID_VALUE_ID) upper_bound = n_unique_values;
+  const auto search_value_found = lower_bound != upper_bound;
+
+  using Outcome = ValueIDPredicate::Outcome;
+  const auto all_rows = ValueIDPredicate{Outcome::AllRows, _scan_type, ValueID{0}};
+  const auto no_rows = ValueIDPredicate{Outcome::NoRows, _scan_type, ValueID{0}};
+
+  // A predicate "value_id < x" matches all rows if x is one past the last value id
+  // and no rows if x is 0. A predicate "value_id >= x" behaves the other way round.
+  const auto less_than = [&](const ValueID value_id) {
+    if (value_id == ValueID{0}) return no_rows;
+    if (value_id == n_unique_values) return all_rows;
+    return ValueIDPredicate{Outcome::SomeRows, ScanType::OpLessThan, value_id};
+  };
+  const auto greater_than_equals = [&](const ValueID value_id) {
+    if (value_id == n_unique_values) return no_rows;
+    if (value_id == ValueID{0}) return all_rows;
+    return ValueIDPredicate{Outcome::SomeRows, ScanType::OpGreaterThanEquals, value_id};
+  };
+
   switch (_scan_type) {
     case ScanType::OpEquals:
-      return search_value == value;
+      if (!search_value_found) return no_rows;
+      if (n_unique_values == ValueID{1}) return all_rows;
+      return ValueIDPredicate{Outcome::SomeRows, ScanType::OpEquals, lower_bound};
     case ScanType::OpNotEquals:
-      return search_value != value;
+      if (!search_value_found) return all_rows;
+      if (n_unique_values == ValueID{1}) return no_rows;
+      return ValueIDPredicate{Outcome::SomeRows, ScanType::OpNotEquals, lower_bound};
     case ScanType::OpLessThan:
-      return value < search_value;
+      return less_than(lower_bound);
     case ScanType::OpLessThanEquals:
-      return value <= search_value;
+      return less_than(upper_bound);
     case ScanType::OpGreaterThan:
-      return value > search_value;
+      return greater_than_equals(upper_bound);
     case ScanType::OpGreaterThanEquals:
-      return value >= search_value;
+      return greater_than_equals(lower_bound);
     default:
       throw std::runtime_error("unknown search type");
   }
 }
 
+template <typename T>
+std::shared_ptr<const PosList> TableScan::scan_segment(const std::shared_ptr<const ReferenceSegment> segment_ptr,
+                                                      const ChunkID chunk_id) const {
+  // determine which values match the filter condition in a
+  // reference segment.
+  // We cannot determine if a row matches the filter condition
+  // based just on the information in the reference segment. We
+  // need to go to the table that the reference segment points to
+  // in order to retrieve the actual values and perform the filtering.
+  // The referenced segments may use any encoding.
+
+  auto offsets = std::vector<ChunkOffset>{};
+  const auto referenced_table_ptr = segment_ptr->referenced_table();
+  const auto referenced_column_id = segment_ptr->referenced_column_id();
+  const auto& pos_list = *segment_ptr->pos_list();
+  const auto n_rows = pos_list.size();
+
+  // the positions are processed in runs that point to the same referenced
+  // chunk. For each run, the referenced segment is resolved once and scanned
+  // with a kernel for its encoding that gathers the values at the chunk
+  // offsets of the run. The reference segments created by a TableScan point
+  // to a single chunk, which their PosList guarantees, so they consist of one
+  // run whose chunk offsets are stored in the PosList. Positions created by
+  // other operators, e.g., joins, may switch between chunks much more often.
+  // For such short runs, resolving the referenced segment and the predicate
+  // does not pay off, and the values are read through segment accessors
+  // instead.
+  const auto search_value = type_cast<T>(_search_value);
+  auto accessors = std::optional<ReferencedSegmentAccessors<T>>{};
+  const auto scan_run = [&](const ChunkID referenced_chunk_id, const ChunkOffset* chunk_offsets,
+                            const size_t run_length, const ChunkOffset first_offset) {
+    if (run_length < MIN_REFERENCED_RUN_LENGTH) {
+      if (!accessors) accessors.emplace(*segment_ptr);
+      const auto& accessor = accessors->get(referenced_chunk_id);
+      const auto value_of = [&](const size_t index) { return accessor.access(chunk_offsets[index]); };
+      scan_gathered_values(run_length, value_of, _scan_type, search_value, first_offset, offsets);
+      return;
+    }
+
+    // the statistics of the referenced chunk may rule out a run entirely.
+    const auto referenced_chunk_ptr = referenced_table_ptr->get_chunk(referenced_chunk_id);
+    const auto statistics = referenced_chunk_ptr->get_statistics(referenced_column_id);
+    const auto outcome = statistics ? statistics->classify(_scan_type, _search_value) : RangeOutcome::SomeRows;
+    if (outcome == RangeOutcome::NoRows) return;
+    if (outcome == RangeOutcome::AllRows) {
+      append_offset_range(first_offset, run_length, offsets);
+      return;
+    }
+
+    const auto referenced_segment_ptr = referenced_chunk_ptr->get_segment(referenced_column_id);
+    resolve_segment_type<T>(*referenced_segment_ptr, [&](const auto& typed_segment) {
+      using SegmentType = std::decay_t<decltype(typed_segment)>;
+      if constexpr (std::is_same_v<SegmentType, ReferenceSegment>) {
+        throw std::runtime_error("reference segment refers to another reference segment");
+      } else {
+        scan_referenced_rows(typed_segment, chunk_offsets, run_length, first_offset, offsets);
+      }
+    });
+  };
+
+  if (pos_list.references_single_chunk()) {
+    // a bitmap is only scanned here if its chunk is not scanned by scan_bitmap_chunk.
+    const auto bitmap_chunk_offsets =
+        pos_list.is_bitmap() ? pos_list.materialize_chunk_offsets() : std::vector<ChunkOffset>{};
+    const auto& chunk_offsets = pos_list.is_bitmap() ? bitmap_chunk_offsets : pos_list.chunk_offsets();
+    if (n_rows > 0) scan_run(pos_list.common_chunk_id(), chunk_offsets.data(), n_rows, ChunkOffset{0});
+    return matches_from_offsets(chunk_id, std::move(offsets), n_rows);
+  }
+
+  // the chunk offsets of each run are copied out of the RowIDs.
+  const auto& row_ids = pos_list.row_ids();
+  auto run_chunk_offsets = std::vector<ChunkOffset>{};
+  auto run_begin = size_t{0};
+  while (run_begin < n_rows) {
+    const auto referenced_chunk_id = row_ids[run_begin].chunk_id;
+    auto run_end = run_begin + 1;
+    while (run_end < n_rows && row_ids[run_end].chunk_id == referenced_chunk_id) ++run_end;
+
+    run_chunk_offsets.resize(run_end - run_begin);
+    for (auto index = run_begin; index < run_end; ++index) {
+      run_chunk_offsets[index - run_begin] = row_ids[index].chunk_offset;
+    }
+    scan_run(referenced_chunk_id, run_chunk_offsets.data(), run_end - run_begin, static_cast<ChunkOffset>(run_begin));
+    run_begin = run_end;
+  }
+
+  return matches_from_offsets(chunk_id, std::move(offsets), n_rows);
+}
+
+template <typename T>
+void TableScan::scan_referenced_rows(const ValueSegment<T>& segment, const ChunkOffset* chunk_offsets,
+                                     const size_t n_rows, const ChunkOffset first_offset,
+                                     std::vector<ChunkOffset>& matches) const {
+  const auto& values = segment.values();
+  const auto search_value = type_cast<T>(_search_value);
+  const auto value_of = [&](const size_t index) -> const T& { return values[chunk_offsets[index]]; };
+  scan_gathered_values(n_rows, value_of, _scan_type, search_value, first_offset, matches);
+}
+
+template <typename T>
+void TableScan::scan_referenced_rows(const DictionarySegment<T>& segment, const ChunkOffset* chunk_offsets,
+                                     const size_t n_rows, const ChunkOffset first_offset,
+                                     std::vector<ChunkOffset>& matches) const {
+  scan_referenced_dictionary_rows(segment, chunk_offsets, n_rows, first_offset, matches);
+}
+
+template <typename T>
+void TableScan::scan_referenced_rows(const FrontCodedDictionarySegment<T>& segment, const ChunkOffset* chunk_offsets,
+                                     const size_t n_rows, const ChunkOffset first_offset,
+                                     std::vector<ChunkOffset>& matches) const {
+  scan_referenced_dictionary_rows(segment, chunk_offsets, n_rows, first_offset, matches);
+}
+
+template <typename DictionarySegmentType>
+void TableScan::scan_referenced_dictionary_rows(const DictionarySegmentType& segment, const ChunkOffset* chunk_offsets,
+                                                const size_t n_rows, const ChunkOffset first_offset,
+                                                std::vector<ChunkOffset>& matches) const {
+  // like for base segments, the predicate is translated into value id space
+  // once, and only the value ids of the referenced rows are gathered.
+  const auto value_id_predicate = translate_to_value_id_predicate(segment);
+  if (value_id_predicate.outcome == ValueIDPredicate::Outcome::NoRows) return;
+  if (value_id_predicate.outcome == ValueIDPredicate::Outcome::AllRows) {
+    append_offset_range(first_offset, n_rows, matches);
+    return;
+  }
+
+  const auto search_value_id = static_cast<ValueID::base_type>(value_id_predicate.value_id);
+  resolve_attribute_vector_type(*segment.attribute_vector(), [&](const auto& attribute_vector) {
+    const auto value_of = [&](const size_t index) {
+      return static_cast<ValueID::base_type>(attribute_vector[chunk_offsets[index]]);
+    };
+    scan_gathered_values(n_rows, value_of, value_id_predicate.scan_type, search_value_id, first_offset, matches);
+  });
+}
+
+template <typename T>
+void TableScan::scan_referenced_rows(const RunLengthSegment<T>& segment, const ChunkOffset* chunk_offsets,
+                                     const size_t n_rows, const ChunkOffset first_offset,
+                                     std::vector<ChunkOffset>& matches) const {
+  // the predicate is evaluated once per run of the referenced segment. The
+  // run of each referenced row is then found with a binary search, which
+  // starts at the run of the previous row if the rows are ascending.
+  const auto& values = segment.values();
+  const auto& end_positions = segment.end_positions();
+  const auto search_value = type_cast<T>(_search_value);
+  auto run_matches = std::vector<uint8_t>(values.size());
+  with_comparator(_scan_type, [&](const auto& comparator) {
+    for (auto run_index = size_t{0}; run_index < values.size(); ++run_index) {
+      run_matches[run_index] = comparator(values[run_index], search_value);
+    }
+  });
+
+  auto run_iter = end_positions.cbegin();
+  auto previous_chunk_offset = ChunkOffset{0};
+  const auto value_of = [&](const size_t index) {
+    const auto chunk_offset = chunk_offsets[index];
+    const auto search_begin = chunk_offset >= previous_chunk_offset ? run_iter : end_positions.cbegin();
+    run_iter = std::lower_bound(search_begin, end_positions.cend(), chunk_offset);
+    previous_chunk_offset = chunk_offset;
+    return run_matches[run_iter - end_positions.cbegin()];
+  };
+  scan_gathered_values(n_rows, value_of, ScanType::OpEquals, uint8_t{1}, first_offset, matches);
+}
+
+template <typename T>
+void TableScan::scan_referenced_rows(const FrameOfReferenceSegment<T>& segment, const ChunkOffset* chunk_offsets,
+                                     const size_t n_rows, const ChunkOffset first_offset,
+                                     std::vector<ChunkOffset>& matches) const {
+  // the rows are processed in groups that fall into the same block of the
+  // referenced segment. The block minimum and maximum may decide the whole
+  // group. Otherwise, blocks with many referenced rows are decoded at once,
+  // while single values are read from blocks with few referenced rows.
+  constexpr auto BLOCK_SIZE = FrameOfReferenceSegment<T>::BLOCK_SIZE;
+  constexpr auto MIN_ROWS_TO_DECODE_BLOCK = BLOCK_SIZE / 32;
+  const auto search_value = type_cast<T>(_search_value);
+  auto block_values = std::vector<T>{};
+
+  auto group_begin = size_t{0};
+  while (group_begin < n_rows) {
+    const auto block_index = chunk_offsets[group_begin] / BLOCK_SIZE;
+    auto group_end = group_begin + 1;
+    while (group_end < n_rows && chunk_offsets[group_end] / BLOCK_SIZE == block_index) ++group_end;
+    const auto group_size = group_end - group_begin;
+    const auto* group_chunk_offsets = chunk_offsets + group_begin;
+    const auto group_first_offset = static_cast<ChunkOffset>(first_offset + group_begin);
+    group_begin = group_end;
+
+    const auto outcome = classify_range(_scan_type, search_value, segment.block_minimum(block_index),
+                                        segment.block_maximum(block_index));
+    if (outcome == RangeOutcome::NoRows) continue;
+    if (outcome == RangeOutcome::AllRows) {
+      append_offset_range(group_first_offset, group_size, matches);
+      continue;
+    }
+
+    if (group_size >= MIN_ROWS_TO_DECODE_BLOCK) {
+      block_values.resize(BLOCK_SIZE);
+      segment.decode_block(block_index, block_values.data());
+      const auto value_of = [&](const size_t index) {
+        return block_values[group_chunk_offsets[index] % BLOCK_SIZE];
+      };
+      scan_gathered_values(group_size, value_of, _scan_type, search_value, group_first_offset, matches);
+    } else {
+      const auto value_of = [&](const size_t index) { return segment.get(group_chunk_offsets[index]); };
+      scan_gathered_values(group_size, value_of, _scan_type, search_value, group_first_offset, matches);
+    }
+  }
+}
+
 }  // namespace opossum
@@ -5,10 +5,14 @@
 #include <string>
 #include <vector>
 
-#include "abstract_operator.hpp"
+#include "abstract_pipeline_operator.hpp"
 #include "all_type_variant.hpp"
 #include "storage/dictionary_segment.hpp"
+#include "storage/frame_of_reference_segment.hpp"
+#include "storage/front_coded_dictionary_segment.hpp"
+#include "storage/pos_list.hpp"
 #include "storage/reference_segment.hpp"
+#include "storage/run_length_segment.hpp"
 #include "storage/value_segment.hpp"
 #include "types.hpp"
 #include "utils/assert.hpp"
@@ -18,44 +22,177 @@ namespace opossum {
 class BaseTableScanImpl;
 class Table;
 
-class TableScan : public AbstractOperator {
+class TableScan : public AbstractPipelineOperator {
  public:
+  // The chunks of the input table are independent of each other. With ChunkParallel, they are scanned on the workers
+  // of the WorkerPool. In both modes, the output chunks are in the order of the input chunks.
+  enum class ExecutionMode { Sequential, ChunkParallel };
+
   TableScan(const std::shared_ptr<const AbstractOperator>& in, const ColumnID column_id, const ScanType scan_type,
-            const AllTypeVariant search_value);
+            const AllTypeVariant search_value, const ExecutionMode execution_mode = ExecutionMode::ChunkParallel);
 
   ColumnID column_id() const;
   ScanType scan_type() const;
   const AllTypeVariant& search_value() const;
+  ExecutionMode execution_mode() const;
+
+  // Clears the bits of the rows of the morsel that do not satisfy the predicate. The execution mode does not apply to
+  // morsels.
+  void process_morsel(const std::shared_ptr<const Table>& table, Morsel& morsel) const override;
+
+  // Removes the rows that do not satisfy the predicate from the selection of the batch. While many rows are selected,
+  // base segments are scanned like morsels, on their encoded values. Otherwise, the selected values are decoded into
+  // the batch.
+  void process_batch(Batch& batch) const override;
+
+  // Creates a chunk of reference segments to the rows of chunk_ptr (of table_ptr) at the given positions. Reference
+  // segments in the chunk are resolved, so that the output references the same tables. Also used by the Pipeline.
+  static std::shared_ptr<Chunk> subset_chunk(const std::shared_ptr<const Table> table_ptr,
+                                             const std::shared_ptr<const Chunk> chunk_ptr,
+                                             const std::shared_ptr<const PosList>& matches);
+
+  // Return the matching rows of a chunk with n_rows rows, stored as offsets or as a bitmap, whichever is smaller (see
+  // MIN_BITMAP_SELECTIVITY). The offsets must be ascending. Also used by the Pipeline.
+  static std::shared_ptr<const PosList> matches_from_bitmask(const ChunkID chunk_id, std::vector<uint64_t>&& bitmask,
+                                                             const size_t n_rows);
+  static std::shared_ptr<const PosList> matches_from_offsets(const ChunkID chunk_id,
+                                                             std::vector<ChunkOffset>&& offsets, const size_t n_rows);
 
  protected:
   std::shared_ptr<const Table> _on_execute() override;
 
-  const std::shared_ptr<std::vector<ChunkOffset>> scan_chunk(const std::shared_ptr<const Chunk> chunk_ptr,
-                                                             const ChunkID chunk_id, const std::string data_type) const;
+  // Returns the output chunk for the input chunk chunk_id, or nullptr if no row of the chunk matches.
+  std::shared_ptr<Chunk> scan_input_chunk(const std::shared_ptr<const Table>& table_ptr, const ChunkID chunk_id,
+                                          const std::string& data_type) const;
+
+  // Returns the positions of the rows of the segment in the chunk chunk_id that match the predicate.
+  std::shared_ptr<const PosList> scan_chunk(const std::shared_ptr<const AbstractSegment> segment_ptr,
+                                            const ChunkID chunk_id, const std::string& data_type) const;
+
+  // Scans a chunk whose segments all reference the same bitmap. Returns nullptr if no row matches.
+  std::shared_ptr<Chunk> scan_bitmap_chunk(const std::shared_ptr<const Chunk> chunk_ptr,
+                                           const std::shared_ptr<const PosList>& bitmap_pos_list,
+                                           const std::string& data_type) const;
+
+  // The matching rows of a chunk with n_rows rows are kept as a bitmap if at least this share of the rows matches.
+  // Otherwise, the offsets take less memory, and later scans only have to look at the matching rows.
+  static constexpr auto MIN_BITMAP_SELECTIVITY = 0.125;
+
+  // Write the bitmask of the rows [begin, end) of a segment that match the predicate, i.e., bitmask_word_count(end -
+  // begin) words, to bitmask. Bit 0 stands for the row begin, which must be a multiple of 64. They are used for whole
+  // segments and for the morsels of a Pipeline.
+  template <typename T>
+  void scan_range(const ValueSegment<T>& segment, const ChunkOffset begin, const ChunkOffset end,
+                  uint64_t* bitmask) const;
+
+  template <typename T>
+  void scan_range(const DictionarySegment<T>& segment, const ChunkOffset begin, const ChunkOffset end,
+                  uint64_t* bitmask) const;
+
+  template <typename T>
+  void scan_range(const FrontCodedDictionarySegment<T>& segment, const ChunkOffset begin, const ChunkOffset end,
+                  uint64_t* bitmask) const;
+
+  template <typename T>
+  void scan_range(const RunLengthSegment<T>& segment, const ChunkOffset begin, const ChunkOffset end,
+                  uint64_t* bitmask) const;
 
-  const std::shared_ptr<Chunk> subset_chunk(const std::shared_ptr<const Table> table_ptr,
-                                            const std::shared_ptr<const Chunk> chunk_ptr, const ChunkID chunk_id,
-                                            const std::shared_ptr<std::vector<ChunkOffset>>& include_rows) const;
+  template <typename T>
+  void scan_range(const FrameOfReferenceSegment<T>& segment, const ChunkOffset begin, const ChunkOffset end,
+                  uint64_t* bitmask) const;
 
   template <typename T>
-  std::shared_ptr<std::vector<ChunkOffset>> scan_segment(
-      const std::shared_ptr<const ValueSegment<T>> segment_ptr) const;
+  std::shared_ptr<const PosList> scan_segment(const std::shared_ptr<const ValueSegment<T>> segment_ptr,
+                                              const ChunkID chunk_id) const;
 
   template <typename T>
-  std::shared_ptr<std::vector<ChunkOffset>> scan_segment(
-      const std::shared_ptr<const DictionarySegment<T>> segment_ptr) const;
+  std::shared_ptr<const PosList> scan_segment(const std::shared_ptr<const DictionarySegment<T>> segment_ptr,
+                                              const ChunkID chunk_id) const;
 
   template <typename T>
-  std::shared_ptr<std::vector<ChunkOffset>> scan_segment(
-      const std::shared_ptr<const ReferenceSegment> segment_ptr) const;
+  std::shared_ptr<const PosList> scan_segment(const std::shared_ptr<const FrontCodedDictionarySegment<T>> segment_ptr,
+                                              const ChunkID chunk_id) const;
 
   template <typename T>
-  bool matches_search_value(T value) const;
+  std::shared_ptr<const PosList> scan_segment(const std::shared_ptr<const RunLengthSegment<T>> segment_ptr,
+                                              const ChunkID chunk_id) const;
+
+  template <typename T>
+  std::shared_ptr<const PosList> scan_segment(const std::shared_ptr<const FrameOfReferenceSegment<T>> segment_ptr,
+                                              const ChunkID chunk_id) const;
+
+  template <typename T>
+  std::shared_ptr<const PosList> scan_segment(const std::shared_ptr<const ReferenceSegment> segment_ptr,
+                                              const ChunkID chunk_id) const;
+
+  // Scans the n_rows rows of a reference segment starting at first_offset, which all point to the given segment of the
+  // same referenced chunk at the given chunk_offsets, and appends the offsets of the matching rows to matches.
+  template <typename T>
+  void scan_referenced_rows(const ValueSegment<T>& segment, const ChunkOffset* chunk_offsets, const size_t n_rows,
+                            const ChunkOffset first_offset, std::vector<ChunkOffset>& matches) const;
+
+  template <typename T>
+  void scan_referenced_rows(const DictionarySegment<T>& segment, const ChunkOffset* chunk_offsets, const size_t n_rows,
+                            const ChunkOffset first_offset, std::vector<ChunkOffset>& matches) const;
+
+  template <typename T>
+  void scan_referenced_rows(const FrontCodedDictionarySegment<T>& segment, const ChunkOffset* chunk_offsets,
+                            const size_t n_rows, const ChunkOffset first_offset,
+                            std::vector<ChunkOffset>& matches) const;
+
+  template <typename T>
+  void scan_referenced_rows(const RunLengthSegment<T>& segment, const ChunkOffset* chunk_offsets, const size_t n_rows,
+                            const ChunkOffset first_offset, std::vector<ChunkOffset>& matches) const;
+
+  template <typename T>
+  void scan_referenced_rows(const FrameOfReferenceSegment<T>& segment, const ChunkOffset* chunk_offsets,
+                            const size_t n_rows, const ChunkOffset first_offset,
+                            std::vector<ChunkOffset>& matches) const;
+
+  template <typename DictionarySegmentType>
+  void scan_referenced_dictionary_rows(const DictionarySegmentType& segment, const ChunkOffset* chunk_offsets,
+                                       const size_t n_rows, const ChunkOffset first_offset,
+                                       std::vector<ChunkOffset>& matches) const;
+
+  // Runs of positions of a reference segment that point to the same referenced chunk are scanned with the kernels
+  // above if they have at least this many rows. Shorter runs are read through segment accessors.
+  static constexpr auto MIN_REFERENCED_RUN_LENGTH = size_t{16};
+
+  // The scan predicate translated into the value id space of a dictionary segment. If the dictionary shows that all
+  // or no rows match, the attribute vector does not have to be scanned at all. Otherwise, a row matches if its value id
+  // compares to value_id according to scan_type (one of OpEquals, OpNotEquals, OpLessThan, or OpGreaterThanEquals).
+  struct ValueIDPredicate {
+    enum class Outcome { AllRows, NoRows, SomeRows };
+
+    Outcome outcome;
+    ScanType scan_type;
+    ValueID value_id;
+  };
+
+  // Translates the scan predicate using lower_bound and upper_bound of a DictionarySegment or
+  // FrontCodedDictionarySegment.
+  template <typename DictionarySegmentType>
+  ValueIDPredicate translate_to_value_id_predicate(const DictionarySegmentType& segment) const;
+
+  template <typename DictionarySegmentType>
+  void scan_dictionary_range(const DictionarySegmentType& segment, const ChunkOffset begin, const ChunkOffset end,
+                             uint64_t* bitmask) const;
+
+  // Writes the bitmask of the value ids in [begin, end) of the attribute vector that satisfy a value id predicate with
+  // the outcome SomeRows, like scan_range.
+  static void scan_value_id_range(const AbstractAttributeVector& attribute_vector,
+                                  const ValueIDPredicate& value_id_predicate, const ChunkOffset begin,
+                                  const ChunkOffset end, uint64_t* bitmask);
+
+  // Scans the attribute vector of a DictionarySegment or FrontCodedDictionarySegment in value id space.
+  template <typename DictionarySegmentType>
+  std::shared_ptr<const PosList> scan_dictionary_segment(const DictionarySegmentType& segment,
+                                                         const ChunkID chunk_id) const;
 
-  std::shared_ptr<const AbstractOperator> _in;
   ColumnID _column_id;
   ScanType _scan_type;
   AllTypeVariant _search_value;
+  ExecutionMode _execution_mode;
 };
 
 }  // namespace opossum
@@ -0,0 +1,152 @@
+#include "top_k.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "normalized_keys.hpp"
+#include "resolve_type.hpp"
+#include "scheduler/worker_pool.hpp"
+#include "storage/pos_list.hpp"
+#include "storage/segment_statistics.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+namespace {
+
+// A row that is among the best k rows of a job so far. Rows with equal keys are ordered by their position in the
+// input, i.e., by row, the index of the row in the order of the chunks.
+struct TopKEntry {
+  std::string key;
+  size_t row;
+  RowID row_id;
+};
+
+bool operator<(const TopKEntry& lhs, const TopKEntry& rhs) {
+  const auto comparison = lhs.key.compare(rhs.key);
+  if (comparison != 0) return comparison < 0;
+  return lhs.row < rhs.row;
+}
+
+// Returns the normalized key of the best value of the first sort column in the chunk, i.e., of its minimum for an
+// ascending column and of its maximum for a descending one. Returns std::nullopt if the chunk has no statistics for
+// the column, e.g., for reference segments.
+std::optional<std::string> best_first_key(const Table& table, const Chunk& chunk,
+                                          const SortColumnDefinition& definition) {
+  auto key = std::optional<std::string>{};
+  resolve_data_type(table.column_type(definition.column_id), [&](auto type) {
+    using Type = typename decltype(type)::type;
+    const auto statistics =
+        std::dynamic_pointer_cast<const MinMaxStatistics<Type>>(chunk.get_statistics(definition.column_id));
+    if (!statistics) return;
+    const auto& best_value =
+        definition.sort_mode == SortMode::Ascending ? statistics->minimum() : statistics->maximum();
+    key = normalized_key(best_value, definition.sort_mode);
+  });
+  return key;
+}
+
+}  // namespace
+
+TopK::TopK(const std::shared_ptr<const AbstractOperator>& input,
+           const std::vector<SortColumnDefinition>& sort_definitions, const size_t k)
+    : AbstractOperator{input}, _sort_definitions{sort_definitions}, _k{k} {
+  Assert(!sort_definitions.empty(), "At least one sort column is needed");
+}
+
+const std::vector<SortColumnDefinition>& TopK::sort_definitions() const { return _sort_definitions; }
+
+size_t TopK::k() const { return _k; }
+
+std::shared_ptr<const Table> TopK::_on_execute() {
+  const auto input_table = _left_input_table();
+  for (const auto& definition : _sort_definitions) {
+    Assert(definition.column_id < input_table->column_count(), "Sort column does not exist");
+  }
+
+  auto column_definitions = std::make_shared<Table>();
+  for (auto column_id = ColumnID{0}; column_id < input_table->column_count(); ++column_id) {
+    column_definitions->add_column_definition(input_table->column_name(column_id),
+                                              input_table->column_type(column_id));
+  }
+
+  const auto n_chunks = input_table->chunk_count();
+  auto chunk_row_begins = std::vector<size_t>(n_chunks + 1);
+  for (auto chunk_id = ChunkID{0}; chunk_id < n_chunks; ++chunk_id) {
+    chunk_row_begins[chunk_id + 1] = chunk_row_begins[chunk_id] + input_table->get_chunk(chunk_id)->size();
+  }
+  if (_k == 0 || chunk_row_begins.back() == 0) return std::make_shared<Table>(column_definitions);
+
+  // chunks without statistics cannot be skipped and come first, the others
+  // in the order of their best values.
+  auto best_keys = std::vector<std::optional<std::string>>(n_chunks);
+  WorkerPool::get().parallel_for(n_chunks, [&](const size_t chunk_index) {
+    const auto chunk = input_table->get_chunk(static_cast<ChunkID>(chunk_index));
+    if (chunk->size() == 0) return;
+    best_keys[chunk_index] = best_first_key(*input_table, *chunk, _sort_definitions.front());
+  });
+  auto chunk_order = std::vector<ChunkID>{};
+  for (auto chunk_id = ChunkID{0}; chunk_id < n_chunks; ++chunk_id) {
+    if (input_table->get_chunk(chunk_id)->size() > 0) chunk_order.push_back(chunk_id);
+  }
+  std::stable_sort(chunk_order.begin(), chunk_order.end(), [&](const ChunkID lhs, const ChunkID rhs) {
+    return best_keys[lhs] < best_keys[rhs];
+  });
+
+  // the chunks are dealt out to the jobs, so that the chunks of each job are
+  // in the same order.
+  const auto n_jobs = std::min(WorkerPool::get().worker_count(), chunk_order.size());
+  auto heaps = std::vector<std::vector<TopKEntry>>(n_jobs);
+  WorkerPool::get().parallel_for(n_jobs, [&](const size_t job_index) {
+    auto& heap = heaps[job_index];
+    heap.reserve(std::min(_k, chunk_row_begins.back()));
+    for (auto order_index = job_index; order_index < chunk_order.size(); order_index += n_jobs) {
+      const auto chunk_id = chunk_order[order_index];
+      const auto& best_key = best_keys[chunk_id];
+      // the first sort column of the k-th row is better than all values of
+      // this chunk and of all chunks after it.
+      if (heap.size() == _k && best_key &&
+          std::string_view{heap.front().key}.substr(0, best_key->size()) < *best_key) {
+        break;
+      }
+
+      const auto keys = encode_normalized_keys(*input_table, *input_table->get_chunk(chunk_id), _sort_definitions);
+      const auto chunk_size = keys.key_offsets.size() - 1;
+      for (auto chunk_offset = size_t{0}; chunk_offset < chunk_size; ++chunk_offset) {
+        const auto key =
+            std::string_view{reinterpret_cast<const char*>(keys.key_data.data()) + keys.key_offsets[chunk_offset],
+                             keys.key_offsets[chunk_offset + 1] - keys.key_offsets[chunk_offset]};
+        const auto row = chunk_row_begins[chunk_id] + chunk_offset;
+        if (heap.size() == _k) {
+          const auto comparison = key.compare(heap.front().key);
+          if (comparison > 0 || (comparison == 0 && row > heap.front().row)) continue;
+          std::pop_heap(heap.begin(), heap.end());
+          heap.pop_back();
+        }
+        heap.push_back(TopKEntry{std::string{key}, row, RowID{chunk_id, static_cast<ChunkOffset>(chunk_offset)}});
+        std::push_heap(heap.begin(), heap.end());
+      }
+    }
+  });
+
+  auto entries = std::vector<TopKEntry>{};
+  for (auto& heap : heaps) {
+    std::move(heap.begin(), heap.end(), std::back_inserter(entries));
+  }
+  std::sort(entries.begin(), entries.end());
+  entries.resize(std::min(entries.size(), _k));
+
+  auto row_ids = std::vector<RowID>(entries.size());
+  std::transform(entries.cbegin(), entries.cend(), row_ids.begin(), [](const auto& entry) { return entry.row_id; });
+  auto output_chunks = std::vector<std::shared_ptr<Chunk>>{std::make_shared<Chunk>()};
+  _append_reference_segments(input_table, {std::make_shared<PosList>(std::move(row_ids))}, output_chunks);
+  return std::make_shared<Table>(output_chunks, column_definitions);
+}
+
+}  // namespace opossum
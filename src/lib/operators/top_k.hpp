@@ -0,0 +1,38 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "abstract_operator.hpp"
+#include "sort.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+// Returns the first k rows of its input in the order of the sort columns, like SELECT * FROM input ORDER BY <sort
+// columns> LIMIT k. The output is the same as the first k rows of the output of Sort, including the order of rows with
+// equal values, and consists of a single chunk of ReferenceSegments.
+//
+// Instead of sorting all rows, each job keeps the best k rows that it has seen so far in a max-heap of their
+// normalized keys (see normalized_keys.hpp), and a row only enters the heap if its key is smaller than the largest key
+// in it. The chunks are split among the jobs, which run on the WorkerPool. Chunks are further skipped as a whole if
+// their statistics (zone maps, which are read from the dictionaries of dictionary segments) show that even their best
+// value of the first sort column is worse than that of the k-th row of the heap. Each job processes its chunks in the
+// order of these best values, so that its heap fills with good rows early and it can stop at the first skipped chunk.
+// Finally, the heaps of all jobs are merged.
+class TopK : public AbstractOperator {
+ public:
+  TopK(const std::shared_ptr<const AbstractOperator>& input, const std::vector<SortColumnDefinition>& sort_definitions,
+       const size_t k);
+
+  const std::vector<SortColumnDefinition>& sort_definitions() const;
+  size_t k() const;
+
+ protected:
+  std::shared_ptr<const Table> _on_execute() override;
+
+  const std::vector<SortColumnDefinition> _sort_definitions;
+  const size_t _k;
+};
+
+}  // namespace opossum
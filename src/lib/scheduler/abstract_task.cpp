@@ -0,0 +1,76 @@
+#include "abstract_task.hpp"
+
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "utils/assert.hpp"
+#include "worker_pool.hpp"
+
+namespace opossum {
+
+namespace {
+
+auto next_task_id = std::atomic<TaskID>{0};
+
+}  // namespace
+
+AbstractTask::AbstractTask() : _id{next_task_id++} {}
+
+TaskID AbstractTask::id() const { return _id; }
+
+void AbstractTask::set_as_predecessor_of(const std::shared_ptr<AbstractTask>& successor) {
+  Assert(!is_scheduled() && !successor->is_scheduled(), "Dependencies cannot be added to scheduled tasks");
+  _successors.emplace_back(successor);
+  successor->_predecessors.emplace_back(weak_from_this());
+  ++successor->_pending_count;
+}
+
+const std::vector<std::weak_ptr<AbstractTask>>& AbstractTask::predecessors() const { return _predecessors; }
+
+const std::vector<std::shared_ptr<AbstractTask>>& AbstractTask::successors() const { return _successors; }
+
+bool AbstractTask::is_scheduled() const { return _is_scheduled; }
+
+bool AbstractTask::is_done() const { return _is_done; }
+
+void AbstractTask::schedule() {
+  Assert(!_is_scheduled.exchange(true), "Task " + std::to_string(_id) + " was already scheduled");
+  _release();
+}
+
+void AbstractTask::join() { WorkerPool::get().wait_for_tasks({shared_from_this()}); }
+
+void AbstractTask::execute() {
+  DebugAssert(!_is_done, "Task " + std::to_string(_id) + " was already executed");
+  // _exception is only set at this point if a predecessor failed.
+  if (!_exception) {
+    try {
+      _on_execute();
+    } catch (...) {
+      _exception = std::current_exception();
+    }
+  }
+
+  _is_done = true;
+  WorkerPool::get()._notify_task_done();
+  for (const auto& successor : _successors) {
+    successor->_release(_exception);
+  }
+}
+
+std::exception_ptr AbstractTask::exception() const {
+  DebugAssert(_is_done, "Task " + std::to_string(_id) + " is not done yet");
+  return _exception;
+}
+
+void AbstractTask::_release(const std::exception_ptr& predecessor_exception) {
+  // the exception is stored before the decrement, so that it is visible to
+  // the worker that executes the task. Only the first one is kept.
+  if (predecessor_exception && !_has_predecessor_exception.exchange(true)) _exception = predecessor_exception;
+  if (--_pending_count == 0) WorkerPool::get()._enqueue(shared_from_this());
+}
+
+}  // namespace opossum
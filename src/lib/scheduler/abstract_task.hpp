@@ -0,0 +1,72 @@
+#pragma once
+
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <vector>
+
+#include "types.hpp"
+
+namespace opossum {
+
+// AbstractTask is the abstract super class of all units of work that the WorkerPool schedules, e.g., the execution of
+// an operator (OperatorTask) or an arbitrary function (JobTask). Tasks can depend on other tasks, so that a set of
+// tasks forms a directed acyclic graph. Their lifecycle has three phases:
+// 1. The task is constructed and its dependencies are declared with set_as_predecessor_of.
+// 2. schedule() hands the task over to the WorkerPool, which executes it on one of its workers as soon as all its
+// predecessors are done. Tasks are scheduled exactly once and dependencies can no longer be changed afterwards.
+// 3. Once the task is done, its successors become ready. Callers wait for a task with join() or with
+// WorkerPool::wait_for_tasks, which also executes other tasks while waiting.
+//
+// If a task throws, the exception is stored and passed on to the successors instead of executing them. join()
+// rethrows it.
+class AbstractTask : public std::enable_shared_from_this<AbstractTask>, private Noncopyable {
+ public:
+  AbstractTask();
+  virtual ~AbstractTask() = default;
+
+  TaskID id() const;
+
+  // The successor is only executed after this task is done. Neither task may have been scheduled yet.
+  void set_as_predecessor_of(const std::shared_ptr<AbstractTask>& successor);
+
+  const std::vector<std::weak_ptr<AbstractTask>>& predecessors() const;
+  const std::vector<std::shared_ptr<AbstractTask>>& successors() const;
+
+  bool is_scheduled() const;
+  bool is_done() const;
+
+  // Hands the task over to the WorkerPool.
+  void schedule();
+
+  // Waits until the task is done and rethrows its exception, if any. See WorkerPool::wait_for_tasks.
+  void join();
+
+  // Runs the task on the calling thread. Only called by the WorkerPool once all predecessors are done.
+  void execute();
+
+  std::exception_ptr exception() const;
+
+ protected:
+  virtual void _on_execute() = 0;
+
+ private:
+  // Called by schedule() and by each predecessor when it is done, with the exception of the predecessor, if any. The
+  // last call passes the task to the WorkerPool.
+  void _release(const std::exception_ptr& predecessor_exception = nullptr);
+
+  TaskID _id;
+  std::vector<std::weak_ptr<AbstractTask>> _predecessors;
+  std::vector<std::shared_ptr<AbstractTask>> _successors;
+
+  // The number of predecessors that are not done yet, plus one until the task is scheduled.
+  std::atomic<uint32_t> _pending_count{1};
+  std::atomic<bool> _is_scheduled{false};
+  std::atomic<bool> _is_done{false};
+
+  // Set by the first predecessor that passes on its exception, see _release.
+  std::atomic<bool> _has_predecessor_exception{false};
+  std::exception_ptr _exception;
+};
+
+}  // namespace opossum
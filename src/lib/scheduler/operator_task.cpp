@@ -0,0 +1,88 @@
+#include "operator_task.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "operators/abstract_pipeline_operator.hpp"
+#include "operators/pipeline.hpp"
+
+namespace opossum {
+
+namespace {
+
+using ConsumerCounts = std::unordered_map<const AbstractOperator*, size_t>;
+
+// Counts for the inputs of op and all their direct and indirect inputs how many operators consume their output.
+void count_consumers(const std::shared_ptr<const AbstractOperator>& op, ConsumerCounts& consumer_counts) {
+  for (const auto& input : {op->left_input(), op->right_input()}) {
+    if (input && consumer_counts[input.get()]++ == 0) count_consumers(input, consumer_counts);
+  }
+}
+
+// Returns the longest chain of pipeline operators that ends with op and whose inner operators have no other consumers,
+// starting with the first operator. The chain is empty if op is not a pipeline operator.
+std::vector<std::shared_ptr<AbstractPipelineOperator>> pipeline_ending_with(
+    const std::shared_ptr<const AbstractOperator>& op, const ConsumerCounts& consumer_counts) {
+  auto operators = std::vector<std::shared_ptr<AbstractPipelineOperator>>{};
+  auto current = std::dynamic_pointer_cast<AbstractPipelineOperator>(std::const_pointer_cast<AbstractOperator>(op));
+  while (current) {
+    operators.emplace_back(current);
+    const auto input = current->left_input();
+    if (!input || consumer_counts.at(input.get()) != 1) break;
+    current = std::dynamic_pointer_cast<AbstractPipelineOperator>(std::const_pointer_cast<AbstractOperator>(input));
+  }
+  std::reverse(operators.begin(), operators.end());
+  return operators;
+}
+
+// Adds the tasks of op and its inputs in topological order and returns the task of op.
+std::shared_ptr<AbstractTask> add_operator_tasks(
+    const std::shared_ptr<const AbstractOperator>& op, const OperatorTask::ExecutionMode execution_mode,
+    const ConsumerCounts& consumer_counts,
+    std::unordered_map<std::shared_ptr<const AbstractOperator>, std::shared_ptr<AbstractTask>>& task_by_operator,
+    std::vector<std::shared_ptr<AbstractTask>>& tasks) {
+  const auto task_iter = task_by_operator.find(op);
+  if (task_iter != task_by_operator.end()) return task_iter->second;
+
+  // Operators only expose their inputs as const, so that consumers cannot execute them. The task of an operator is the
+  // one place that executes it. In pipelined mode, the task of the last operator of a pipeline executes the whole
+  // pipeline, and the inputs of the pipeline are those of its first operator.
+  auto executed_operator = std::const_pointer_cast<AbstractOperator>(op);
+  if (execution_mode == OperatorTask::ExecutionMode::Pipelined) {
+    const auto pipeline_operators = pipeline_ending_with(op, consumer_counts);
+    if (pipeline_operators.size() >= 2) executed_operator = std::make_shared<Pipeline>(pipeline_operators);
+  }
+
+  auto task = std::make_shared<OperatorTask>(executed_operator);
+  for (const auto& input : {executed_operator->left_input(), executed_operator->right_input()}) {
+    if (input) {
+      add_operator_tasks(input, execution_mode, consumer_counts, task_by_operator, tasks)->set_as_predecessor_of(task);
+    }
+  }
+  task_by_operator.emplace(op, task);
+  tasks.emplace_back(task);
+  return task;
+}
+
+}  // namespace
+
+OperatorTask::OperatorTask(const std::shared_ptr<AbstractOperator>& op) : _operator{op} {}
+
+std::vector<std::shared_ptr<AbstractTask>> OperatorTask::make_tasks_from_operator(
+    const std::shared_ptr<AbstractOperator>& op, const ExecutionMode execution_mode) {
+  auto consumer_counts = ConsumerCounts{};
+  count_consumers(op, consumer_counts);
+
+  auto task_by_operator = std::unordered_map<std::shared_ptr<const AbstractOperator>, std::shared_ptr<AbstractTask>>{};
+  auto tasks = std::vector<std::shared_ptr<AbstractTask>>{};
+  add_operator_tasks(op, execution_mode, consumer_counts, task_by_operator, tasks);
+  return tasks;
+}
+
+const std::shared_ptr<AbstractOperator>& OperatorTask::get_operator() const { return _operator; }
+
+void OperatorTask::_on_execute() { _operator->execute(); }
+
+}  // namespace opossum
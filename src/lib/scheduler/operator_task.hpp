@@ -0,0 +1,34 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "abstract_task.hpp"
+#include "operators/abstract_operator.hpp"
+
+namespace opossum {
+
+// Executes an operator. The task of an operator is a successor of the tasks of its input operators, so that a query
+// plan can be scheduled as a whole and independent branches run concurrently.
+class OperatorTask : public AbstractTask {
+ public:
+  // With OperatorAtATime, every operator gets its own task and materializes its output. With Pipelined, chains of at
+  // least two pipeline operators whose inner operators have no other consumers are executed as a single Pipeline.
+  enum class ExecutionMode { OperatorAtATime, Pipelined };
+
+  explicit OperatorTask(const std::shared_ptr<AbstractOperator>& op);
+
+  // Creates the tasks for an operator and all its direct and indirect inputs, which must not have been executed yet.
+  // An operator that is the input of several operators gets a single task. The task of op is the last one.
+  static std::vector<std::shared_ptr<AbstractTask>> make_tasks_from_operator(
+      const std::shared_ptr<AbstractOperator>& op, const ExecutionMode execution_mode = ExecutionMode::OperatorAtATime);
+
+  const std::shared_ptr<AbstractOperator>& get_operator() const;
+
+ protected:
+  void _on_execute() override;
+
+  std::shared_ptr<AbstractOperator> _operator;
+};
+
+}  // namespace opossum
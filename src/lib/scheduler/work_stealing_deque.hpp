@@ -0,0 +1,125 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "types.hpp"
+
+namespace opossum {
+
+// A lock-free double-ended queue of pointers as described by Chase and Lev ("Dynamic Circular Work-Stealing Deque")
+// with the memory orderings of Lê et al. ("Correct and Efficient Work-Stealing for Weak Memory Models"). Only the
+// owning thread may push and take elements at the bottom, which it does without synchronization in the common case.
+// Any thread may steal elements from the top. Thus, a worker processes its own tasks in LIFO order, which keeps their
+// data in its caches, while idle workers take the oldest tasks of other workers.
+//
+// The deque does not own the elements. When it runs full, the owner replaces the buffer with one of twice the size.
+// The old buffers are kept until the deque is destroyed because concurrent thieves may still read from them.
+template <typename T>
+class WorkStealingDeque : private Noncopyable {
+ public:
+  explicit WorkStealingDeque(const size_t initial_capacity = 64) {
+    _buffers.emplace_back(std::make_unique<Buffer>(initial_capacity));
+    _buffer.store(_buffers.back().get(), std::memory_order_relaxed);
+  }
+
+  // Only called by the owner.
+  void push(T* element) {
+    const auto bottom = _bottom.load(std::memory_order_relaxed);
+    const auto top = _top.load(std::memory_order_acquire);
+    auto* buffer = _buffer.load(std::memory_order_relaxed);
+    if (bottom - top > static_cast<int64_t>(buffer->capacity()) - 1) {
+      buffer = _grow(buffer, top, bottom);
+    }
+    buffer->store(bottom, element);
+    std::atomic_thread_fence(std::memory_order_release);
+    _bottom.store(bottom + 1, std::memory_order_relaxed);
+  }
+
+  // Only called by the owner. Returns the most recently pushed element or nullptr if the deque is empty.
+  T* take() {
+    const auto bottom = _bottom.load(std::memory_order_relaxed) - 1;
+    auto* buffer = _buffer.load(std::memory_order_relaxed);
+    _bottom.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    auto top = _top.load(std::memory_order_relaxed);
+
+    if (top > bottom) {
+      _bottom.store(bottom + 1, std::memory_order_relaxed);
+      return nullptr;
+    }
+
+    auto* element = buffer->load(bottom);
+    if (top == bottom) {
+      // the last element, which a thief may try to steal at the same time.
+      if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+        element = nullptr;
+      }
+      _bottom.store(bottom + 1, std::memory_order_relaxed);
+    }
+    return element;
+  }
+
+  // Called by any thread. Returns the oldest element or nullptr if the deque is empty or another thread took the
+  // element at the same time.
+  T* steal() {
+    auto top = _top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const auto bottom = _bottom.load(std::memory_order_acquire);
+    if (top >= bottom) return nullptr;
+
+    auto* element = _buffer.load(std::memory_order_acquire)->load(top);
+    if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+      return nullptr;
+    }
+    return element;
+  }
+
+  // Only a snapshot if other threads access the deque at the same time.
+  bool empty() const {
+    return _top.load(std::memory_order_relaxed) >= _bottom.load(std::memory_order_relaxed);
+  }
+
+ protected:
+  // A circular buffer whose capacity is a power of two, so that positions can be mapped to slots with a mask.
+  class Buffer {
+   public:
+    explicit Buffer(const size_t capacity) : _slots(std::bit_ceil(capacity)) {}
+
+    size_t capacity() const { return _slots.size(); }
+
+    T* load(const int64_t position) const {
+      return _slots[static_cast<size_t>(position) & (_slots.size() - 1)].load(std::memory_order_relaxed);
+    }
+
+    void store(const int64_t position, T* element) {
+      _slots[static_cast<size_t>(position) & (_slots.size() - 1)].store(element, std::memory_order_relaxed);
+    }
+
+   private:
+    std::vector<std::atomic<T*>> _slots;
+  };
+
+  Buffer* _grow(const Buffer* buffer, const int64_t top, const int64_t bottom) {
+    _buffers.emplace_back(std::make_unique<Buffer>(buffer->capacity() * 2));
+    auto* new_buffer = _buffers.back().get();
+    for (auto position = top; position < bottom; ++position) {
+      new_buffer->store(position, buffer->load(position));
+    }
+    _buffer.store(new_buffer, std::memory_order_release);
+    return new_buffer;
+  }
+
+  // top and bottom only grow (apart from the temporary decrement in take), so they cannot overflow in practice.
+  std::atomic<int64_t> _top{0};
+  std::atomic<int64_t> _bottom{0};
+  std::atomic<Buffer*> _buffer;
+  // Only accessed by the owner.
+  std::vector<std::unique_ptr<Buffer>> _buffers;
+};
+
+}  // namespace opossum
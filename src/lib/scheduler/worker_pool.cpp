@@ -0,0 +1,214 @@
+#include "worker_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "job_task.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+namespace {
+
+// The pool and the id of the worker that runs on the current thread. Other threads push tasks to the shared queue.
+thread_local WorkerPool* current_pool = nullptr;
+thread_local WorkerID current_worker_id = 0;
+
+// Shared by the calling thread and the jobs that help with a parallel_for. Jobs that only start after all indices have
+// been handed out return immediately, so the state has to outlive the parallel_for call.
+struct ParallelForState {
+  ParallelForState(const size_t init_job_count, const std::function<void(size_t)>& init_job)
+      : job_count{init_job_count}, job{&init_job} {}
+
+  void process_jobs() {
+    while (true) {
+      const auto index = next_index.fetch_add(1);
+      if (index >= job_count) return;
+
+      try {
+        (*job)(index);
+      } catch (...) {
+        const auto lock = std::lock_guard{mutex};
+        if (!exception) exception = std::current_exception();
+      }
+
+      const auto lock = std::lock_guard{mutex};
+      if (++finished_count == job_count) finished_condition.notify_all();
+    }
+  }
+
+  const size_t job_count;
+  // Only dereferenced for indices that have not been processed yet, i.e., while parallel_for is still waiting.
+  const std::function<void(size_t)>* job;
+  std::atomic<size_t> next_index{0};
+
+  std::mutex mutex;
+  std::condition_variable finished_condition;
+  size_t finished_count{0};
+  std::exception_ptr exception;
+};
+
+}  // namespace
+
+WorkerPool& WorkerPool::get() {
+  // hardware_concurrency may return 0 if the number of hardware threads is unknown.
+  static auto instance = WorkerPool{std::max(std::thread::hardware_concurrency(), 1u)};
+  return instance;
+}
+
+WorkerPool::WorkerPool(const size_t worker_count) {
+  _deques.reserve(worker_count);
+  for (auto worker_id = WorkerID{0}; worker_id < worker_count; ++worker_id) {
+    _deques.emplace_back(std::make_unique<TaskDeque>());
+  }
+  _workers.reserve(worker_count);
+  for (auto worker_id = WorkerID{0}; worker_id < worker_count; ++worker_id) {
+    _workers.emplace_back([this, worker_id] { _work(worker_id); });
+  }
+}
+
+WorkerPool::~WorkerPool() {
+  {
+    const auto lock = std::lock_guard{_mutex};
+    _shutdown = true;
+  }
+  _wake_condition.notify_all();
+  for (auto& worker : _workers) {
+    worker.join();
+  }
+}
+
+size_t WorkerPool::worker_count() const { return _workers.size(); }
+
+void WorkerPool::parallel_for(const size_t job_count, const std::function<void(size_t)>& job) {
+  if (job_count == 0) return;
+  if (job_count == 1) {
+    job(0);
+    return;
+  }
+
+  const auto state = std::make_shared<ParallelForState>(job_count, job);
+  const auto helper_count = std::min(_workers.size(), job_count - 1);
+  for (auto helper_index = size_t{0}; helper_index < helper_count; ++helper_index) {
+    std::make_shared<JobTask>([state] { state->process_jobs(); })->schedule();
+  }
+
+  state->process_jobs();
+
+  auto lock = std::unique_lock{state->mutex};
+  state->finished_condition.wait(lock, [&] { return state->finished_count == job_count; });
+  if (state->exception) std::rethrow_exception(state->exception);
+}
+
+void WorkerPool::wait_for_tasks(const std::vector<std::shared_ptr<AbstractTask>>& tasks) {
+  for (const auto& task : tasks) {
+    Assert(task->is_scheduled(), "Task " + std::to_string(task->id()) + " has to be scheduled before waiting for it");
+    while (!task->is_done()) {
+      if (_try_execute_task()) continue;
+
+      auto lock = std::unique_lock{_mutex};
+      ++_sleeping_thread_count;
+      _wake_condition.wait(lock, [&] { return task->is_done() || _queued_task_count > 0; });
+      --_sleeping_thread_count;
+    }
+  }
+
+  for (const auto& task : tasks) {
+    if (task->exception()) std::rethrow_exception(task->exception());
+  }
+}
+
+void WorkerPool::schedule_and_wait_for_tasks(const std::vector<std::shared_ptr<AbstractTask>>& tasks) {
+  for (const auto& task : tasks) {
+    task->schedule();
+  }
+  wait_for_tasks(tasks);
+}
+
+void WorkerPool::_enqueue(std::shared_ptr<AbstractTask> task) {
+  // The counter is increased first, so that it never drops below zero when another thread takes the task right away.
+  ++_queued_task_count;
+  if (current_pool == this) {
+    _deques[current_worker_id]->push(new std::shared_ptr<AbstractTask>{std::move(task)});
+  } else {
+    const auto lock = std::lock_guard{_mutex};
+    _shared_queue.emplace_back(std::move(task));
+  }
+
+  // Threads increase _sleeping_thread_count before they check _queued_task_count and go to sleep. Thus, if no thread
+  // is counted here, none of them can miss the new task. Otherwise, taking the mutex ensures that the sleeping threads
+  // either see the task or are already waiting for the notification.
+  if (_sleeping_thread_count > 0) {
+    _mutex.lock();
+    _mutex.unlock();
+    _wake_condition.notify_one();
+  }
+}
+
+void WorkerPool::_notify_task_done() {
+  if (_sleeping_thread_count > 0) {
+    _mutex.lock();
+    _mutex.unlock();
+    _wake_condition.notify_all();
+  }
+}
+
+bool WorkerPool::_try_execute_task() {
+  auto task = std::shared_ptr<AbstractTask>{};
+  const auto take_task = [&](std::shared_ptr<AbstractTask>* entry) {
+    if (!entry) return false;
+    task = std::move(*entry);
+    delete entry;
+    return true;
+  };
+
+  const auto is_worker = current_pool == this;
+  auto found_task = is_worker && take_task(_deques[current_worker_id]->take());
+  if (!found_task) {
+    const auto lock = std::lock_guard{_mutex};
+    if (!_shared_queue.empty()) {
+      task = std::move(_shared_queue.front());
+      _shared_queue.pop_front();
+      found_task = true;
+    }
+  }
+
+  // Steal from the other workers, starting with the next one so that not all thieves go for the same deque.
+  const auto deque_count = _deques.size();
+  const auto first_deque_index = is_worker ? current_worker_id + 1 : 0;
+  for (auto deque_offset = size_t{0}; !found_task && deque_offset < deque_count; ++deque_offset) {
+    const auto deque_index = (first_deque_index + deque_offset) % deque_count;
+    if (is_worker && deque_index == current_worker_id) continue;
+    found_task = take_task(_deques[deque_index]->steal());
+  }
+
+  if (!found_task) return false;
+  --_queued_task_count;
+  task->execute();
+  return true;
+}
+
+void WorkerPool::_work(const WorkerID worker_id) {
+  current_pool = this;
+  current_worker_id = worker_id;
+  while (true) {
+    if (_try_execute_task()) continue;
+
+    auto lock = std::unique_lock{_mutex};
+    ++_sleeping_thread_count;
+    _wake_condition.wait(lock, [&] { return _shutdown || _queued_task_count > 0; });
+    --_sleeping_thread_count;
+    if (_shutdown && _queued_task_count == 0) return;
+  }
+}
+
+}  // namespace opossum
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "abstract_task.hpp"
+#include "types.hpp"
+#include "work_stealing_deque.hpp"
+
+namespace opossum {
+
+// The WorkerPool is a singleton that owns one worker thread per hardware thread and executes the tasks that are
+// scheduled (see AbstractTask). Operators and storage functions use it to process independent pieces of work in
+// parallel, e.g., the chunks of a table, and whole query plans are submitted as graphs of OperatorTasks. As all
+// parallel work shares the same workers, concurrent queries do not oversubscribe the hardware threads.
+//
+// Each worker has its own WorkStealingDeque. Tasks that become ready on a worker, e.g., the successors of a task or
+// the jobs of an operator, are pushed to its deque and taken from there in LIFO order. Idle workers steal from the
+// other deques. Tasks that become ready on other threads are put into a shared queue. Workers only sleep if no task
+// is queued anywhere.
+class WorkerPool : private Noncopyable {
+ public:
+  static WorkerPool& get();
+
+  size_t worker_count() const;
+
+  // Calls job(index) for every index in [0, job_count) and returns once all calls have finished. The indices are
+  // handed out one by one to the workers and to the calling thread, which also processes indices while it waits.
+  // Thus, jobs may call parallel_for themselves without running out of workers. If a job throws, the remaining
+  // indices are still processed and the first exception is rethrown to the caller.
+  void parallel_for(const size_t job_count, const std::function<void(size_t)>& job);
+
+  // Returns once all tasks are done and rethrows the first exception of the tasks, if any. While waiting, the calling
+  // thread executes queued tasks, so that waiting on a worker does not reduce the number of threads doing work.
+  void wait_for_tasks(const std::vector<std::shared_ptr<AbstractTask>>& tasks);
+
+  void schedule_and_wait_for_tasks(const std::vector<std::shared_ptr<AbstractTask>>& tasks);
+
+  WorkerPool(WorkerPool&&) = delete;
+  ~WorkerPool();
+
+ protected:
+  friend class AbstractTask;
+
+  explicit WorkerPool(const size_t worker_count);  // make constructor non-public
+
+  // Called by AbstractTask once a scheduled task is ready.
+  void _enqueue(std::shared_ptr<AbstractTask> task);
+  // Called by AbstractTask once a task is done, wakes up the threads in wait_for_tasks.
+  void _notify_task_done();
+
+  // Executes one queued task if there is any. Returns false otherwise.
+  bool _try_execute_task();
+
+  void _work(const WorkerID worker_id);
+
+  // The deques hold heap-allocated shared pointers, which the thread that removes them from the deque deletes.
+  using TaskDeque = WorkStealingDeque<std::shared_ptr<AbstractTask>>;
+
+  std::vector<std::unique_ptr<TaskDeque>> _deques;
+  std::vector<std::thread> _workers;
+
+  // Protects the shared queue and is used to put threads to sleep.
+  std::mutex _mutex;
+  std::condition_variable _wake_condition;
+  std::deque<std::shared_ptr<AbstractTask>> _shared_queue;
+
+  // The number of tasks in all queues.
+  std::atomic<size_t> _queued_task_count{0};
+  // The number of threads that wait on _wake_condition.
+  std::atomic<size_t> _sleeping_thread_count{0};
+  bool _shutdown{false};
+};
+
+}  // namespace opossum
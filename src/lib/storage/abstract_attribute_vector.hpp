@@ -19,6 +19,10 @@ class AbstractAttributeVector : private Noncopyable {
   // returns the value id at a given position
   virtual ValueID get(const size_t index) const = 0;
 
+  // writes the value ids at the positions [begin, end) to output, which must have room for end - begin values. Loops
+  // over many value ids should use this or resolve_attribute_vector_type instead of calling get for every position.
+  virtual void decode(const size_t begin, const size_t end, ValueID::base_type* output) const = 0;
+
   // sets the value id at a given position
   virtual void set(const size_t index, const ValueID value_id) = 0;
 
@@ -27,6 +31,9 @@ class AbstractAttributeVector : private Noncopyable {
 
   // returns the width of biggest value id in bytes
   virtual AttributeVectorWidth width() const = 0;
+
+  // returns the calculated memory usage
+  virtual size_t estimate_memory_usage() const = 0;
 };
 
 }  // namespace opossum
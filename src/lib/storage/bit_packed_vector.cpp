@@ -0,0 +1,150 @@
+#include "bit_packed_vector.hpp"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <string>
+#include <utility>
+
+#include "types.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+namespace {
+
+constexpr auto LANE_COUNT = BitPackedVector::LANE_COUNT;
+constexpr auto VALUES_PER_LANE = BitPackedVector::BLOCK_SIZE / LANE_COUNT;
+
+// Unpacks one block. The bit width is a template parameter so that the loop can be fully unrolled with constant
+// shifts for every width.
+template <uint8_t bit_width>
+void unpack_block(const uint32_t* block_words, uint32_t* output) {
+  constexpr auto MASK = static_cast<uint32_t>((uint64_t{1} << bit_width) - 1);
+#if defined(__SSE2__)
+  // SSE2 is part of x86-64, so no runtime dispatch is needed here.
+  const auto* input = reinterpret_cast<const __m128i*>(block_words);
+  const auto mask = _mm_set1_epi32(static_cast<int32_t>(MASK));
+  for (auto lane_position = size_t{0}; lane_position < VALUES_PER_LANE; ++lane_position) {
+    const auto bit_offset = lane_position * bit_width;
+    const auto word_index = bit_offset / 32;
+    const auto shift = static_cast<int32_t>(bit_offset % 32);
+    auto values = _mm_srl_epi32(_mm_loadu_si128(input + word_index), _mm_cvtsi32_si128(shift));
+    if (shift + bit_width > 32) {
+      const auto spilled_values = _mm_loadu_si128(input + word_index + 1);
+      values = _mm_or_si128(values, _mm_sll_epi32(spilled_values, _mm_cvtsi32_si128(32 - shift)));
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(output + LANE_COUNT * lane_position), _mm_and_si128(values, mask));
+  }
+#else
+  for (auto lane_position = size_t{0}; lane_position < VALUES_PER_LANE; ++lane_position) {
+    const auto bit_offset = lane_position * bit_width;
+    const auto word_index = bit_offset / 32;
+    const auto shift = bit_offset % 32;
+    for (auto lane = size_t{0}; lane < LANE_COUNT; ++lane) {
+      auto value = uint64_t{block_words[LANE_COUNT * word_index + lane]} >> shift;
+      if (shift + bit_width > 32) {
+        value |= uint64_t{block_words[LANE_COUNT * (word_index + 1) + lane]} << (32 - shift);
+      }
+      output[LANE_COUNT * lane_position + lane] = static_cast<uint32_t>(value) & MASK;
+    }
+  }
+#endif
+}
+
+using UnpackFunction = void (*)(const uint32_t*, uint32_t*);
+
+template <size_t... bit_widths>
+constexpr auto make_unpack_functions(std::index_sequence<bit_widths...>) {
+  // Index 0 is unused, bit widths start at 1.
+  return std::array<UnpackFunction, sizeof...(bit_widths) + 1>{nullptr,
+                                                               &unpack_block<static_cast<uint8_t>(bit_widths + 1)>...};
+}
+
+constexpr auto UNPACK_FUNCTIONS = make_unpack_functions(std::make_index_sequence<32>{});
+
+}  // namespace
+
+BitPackedVector::BitPackedVector(const size_t size, const uint8_t bit_width) : _size{size}, _bit_width{bit_width} {
+  Assert(bit_width >= 1 && bit_width <= 32, "Bit width must be in [1, 32], got " + std::to_string(bit_width));
+  _words.resize(block_count() * LANE_COUNT * _bit_width);
+}
+
+ValueID BitPackedVector::get(const size_t index) const {
+  DebugAssert(index < _size, "index " + std::to_string(index) + " out of bounds for BitPackedVector with size " +
+                                 std::to_string(_size));
+  return (*this)[index];
+}
+
+void BitPackedVector::decode(const size_t begin, const size_t end, ValueID::base_type* output) const {
+  DebugAssert(begin <= end && end <= _size, "range [" + std::to_string(begin) + ", " + std::to_string(end) +
+                                                ") out of bounds for BitPackedVector with size " +
+                                                std::to_string(_size));
+  // Full blocks are unpacked directly into the output. Partially requested blocks at the borders of the range go
+  // through a buffer because unpacking always writes BLOCK_SIZE values.
+  auto block_buffer = std::array<ValueID::base_type, BLOCK_SIZE>{};
+  auto index = begin;
+  while (index < end) {
+    const auto block_index = index / BLOCK_SIZE;
+    const auto block_begin = block_index * BLOCK_SIZE;
+    const auto range_end = std::min(block_begin + BLOCK_SIZE, end);
+    if (index == block_begin && range_end == block_begin + BLOCK_SIZE) {
+      decode_block(block_index, output);
+    } else {
+      decode_block(block_index, block_buffer.data());
+      std::copy(block_buffer.cbegin() + (index - block_begin), block_buffer.cbegin() + (range_end - block_begin),
+                output);
+    }
+    output += range_end - index;
+    index = range_end;
+  }
+}
+
+void BitPackedVector::set(const size_t index, const ValueID value_id) {
+  DebugAssert(index < _size, "index " + std::to_string(index) + " out of bounds for BitPackedVector with size " +
+                                 std::to_string(_size));
+  const auto mask = (uint64_t{1} << _bit_width) - 1;
+  DebugAssert(value_id <= mask, "value id " + std::to_string(value_id) + " does not fit into " +
+                                    std::to_string(_bit_width) + " bits");
+
+  const auto index_in_block = index % BLOCK_SIZE;
+  const auto lane = index_in_block % LANE_COUNT;
+  const auto bit_offset = (index_in_block / LANE_COUNT) * _bit_width;
+  const auto word_index = bit_offset / 32;
+  const auto shift = bit_offset % 32;
+  auto* block_words = _words.data() + (index / BLOCK_SIZE) * LANE_COUNT * _bit_width;
+  const auto value = uint64_t{value_id};
+
+  auto& word = block_words[LANE_COUNT * word_index + lane];
+  word = static_cast<uint32_t>((word & ~(mask << shift)) | (value << shift));
+  if (shift + _bit_width > 32) {
+    auto& spilled_word = block_words[LANE_COUNT * (word_index + 1) + lane];
+    spilled_word = static_cast<uint32_t>((spilled_word & ~(mask >> (32 - shift))) | (value >> (32 - shift)));
+  }
+}
+
+size_t BitPackedVector::size() const { return _size; }
+
+AttributeVectorWidth BitPackedVector::width() const { return static_cast<AttributeVectorWidth>((_bit_width + 7) / 8); }
+
+size_t BitPackedVector::estimate_memory_usage() const { return sizeof(uint32_t) * _words.size(); }
+
+uint8_t BitPackedVector::bit_width() const { return _bit_width; }
+
+uint8_t BitPackedVector::required_bit_width(const ValueID::base_type max_value_id) {
+  const auto minimal_bit_width = static_cast<uint8_t>(std::bit_width(max_value_id));
+  return std::max(uint8_t{1}, minimal_bit_width);
+}
+
+void BitPackedVector::decode_block(const size_t block_index, ValueID::base_type* output) const {
+  DebugAssert(block_index < block_count(), "block index " + std::to_string(block_index) + " out of bounds");
+  UNPACK_FUNCTIONS[_bit_width](_words.data() + block_index * LANE_COUNT * _bit_width, output);
+}
+
+size_t BitPackedVector::block_count() const { return (_size + BLOCK_SIZE - 1) / BLOCK_SIZE; }
+
+}  // namespace opossum
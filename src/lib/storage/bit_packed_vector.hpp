@@ -0,0 +1,69 @@
+#pragma once
+
+#include <vector>
+
+#include "abstract_attribute_vector.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+// BitPackedVector stores value ids with the minimal number of bits (1 to 32) that is needed for the largest value id.
+//
+// Values are packed in blocks of 128 in the vertical layout of BP128: Value i of a block belongs to lane i % 4. Each
+// lane packs its 32 values into bit_width consecutive 32-bit words, and the words of the four lanes are interleaved.
+// This way, a block can be unpacked with 128-bit SIMD registers that hold the same word of all four lanes, shifting
+// and masking four values at once. The last block is padded with zeros.
+class BitPackedVector : public AbstractAttributeVector {
+ public:
+  static constexpr auto BLOCK_SIZE = size_t{128};
+  static constexpr auto LANE_COUNT = size_t{4};
+
+  // Creates a vector of the given size with all value ids set to 0. bit_width must be in [1, 32].
+  BitPackedVector(const size_t size, const uint8_t bit_width);
+
+  ValueID get(const size_t index) const override;
+  void decode(const size_t begin, const size_t end, ValueID::base_type* output) const override;
+  void set(const size_t index, const ValueID value_id) override;
+  size_t size() const override;
+
+  // Returns the number of bytes needed to hold a value id without packing, i.e., the bit width rounded up to bytes.
+  AttributeVectorWidth width() const override;
+
+  size_t estimate_memory_usage() const override;
+
+  // Returns the number of bits used per value id.
+  uint8_t bit_width() const;
+
+  // Returns the minimal bit width that can represent max_value_id (at least 1).
+  static uint8_t required_bit_width(const ValueID::base_type max_value_id);
+
+  // Unpacks the BLOCK_SIZE value ids of the given block into output, which must have room for BLOCK_SIZE values.
+  // For the last block, the values after size() are 0.
+  void decode_block(const size_t block_index, ValueID::base_type* output) const;
+
+  size_t block_count() const;
+
+  // Returns the value id at the given position without bounds checking. Unlike get, this is not virtual and can be
+  // inlined into the loops of operators that obtained the concrete vector via resolve_attribute_vector_type. When
+  // reading all values in order, decode_block is considerably faster.
+  ValueID operator[](const size_t index) const {
+    const auto index_in_block = index % BLOCK_SIZE;
+    const auto lane = index_in_block % LANE_COUNT;
+    const auto bit_offset = (index_in_block / LANE_COUNT) * _bit_width;
+    const auto word_index = bit_offset / 32;
+    const auto shift = bit_offset % 32;
+    const auto* block_words = _words.data() + (index / BLOCK_SIZE) * LANE_COUNT * _bit_width;
+
+    auto value = uint64_t{block_words[LANE_COUNT * word_index + lane]} >> shift;
+    if (shift + _bit_width > 32) value |= uint64_t{block_words[LANE_COUNT * (word_index + 1) + lane]} << (32 - shift);
+    const auto mask = (uint64_t{1} << _bit_width) - 1;
+    return ValueID{static_cast<ValueID::base_type>(value & mask)};
+  }
+
+ protected:
+  size_t _size;
+  uint8_t _bit_width;
+  std::vector<uint32_t> _words{};
+};
+
+}  // namespace opossum
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include "types.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+/**
+ * Builds a sorted dictionary of the distinct values and determines the value id of every value. This is used for
+ * constructing dictionary-encoded segments and runs in linear time plus sorting the distinct values:
+ *
+ *   1. Each value is looked up in an open-addressing hash table with linear probing. The table maps to an index into
+ *      the distinct values in the order of their first occurrence, which is recorded for every value.
+ *   2. Only the distinct values are sorted, which yields the value id of each first-occurrence index.
+ *   3. The value id of every value is looked up via its first-occurrence index.
+ *
+ * For columns with few distinct values, this is much faster than sorting all values or inserting them into a tree.
+ */
+template <typename T>
+void build_dictionary(const std::vector<T>& values, std::vector<T>& dictionary,
+                      std::vector<ValueID::base_type>& value_ids) {
+  constexpr auto EMPTY_SLOT = std::numeric_limits<uint32_t>::max();
+  Assert(values.size() < EMPTY_SLOT, "Too many values for a dictionary");
+
+  // step 1: determine the distinct values in the order of their first occurrence.
+  auto distinct_values = std::vector<T>{};
+  auto first_occurrence_indexes = std::vector<uint32_t>(values.size());
+  auto slot_bits = 6;
+  auto slots = std::vector<uint32_t>(size_t{1} << slot_bits, EMPTY_SLOT);
+
+  // the multiplication spreads hash values (which are the values themselves for integers) over the upper bits.
+  const auto slot_of = [&](const T& value) {
+    return static_cast<size_t>((std::hash<T>{}(value) * 0x9E3779B97F4A7C15ull) >> (64 - slot_bits));
+  };
+  const auto find_slot = [&](const T& value) {
+    auto slot = slot_of(value);
+    while (slots[slot] != EMPTY_SLOT && !(distinct_values[slots[slot]] == value)) {
+      slot = (slot + 1) & (slots.size() - 1);
+    }
+    return slot;
+  };
+
+  for (auto index = size_t{0}; index < values.size(); ++index) {
+    const auto slot = find_slot(values[index]);
+    if (slots[slot] != EMPTY_SLOT) {
+      first_occurrence_indexes[index] = slots[slot];
+      continue;
+    }
+
+    const auto first_occurrence_index = static_cast<uint32_t>(distinct_values.size());
+    slots[slot] = first_occurrence_index;
+    distinct_values.push_back(values[index]);
+    first_occurrence_indexes[index] = first_occurrence_index;
+
+    // keep the load factor at or below 1/2 so that probe sequences stay short.
+    if (distinct_values.size() * 2 > slots.size()) {
+      ++slot_bits;
+      slots.assign(size_t{1} << slot_bits, EMPTY_SLOT);
+      for (auto distinct_index = uint32_t{0}; distinct_index < distinct_values.size(); ++distinct_index) {
+        slots[find_slot(distinct_values[distinct_index])] = distinct_index;
+      }
+    }
+  }
+
+  // step 2: sort the distinct values indirectly to learn the value id of each first-occurrence index.
+  auto sorted_order = std::vector<uint32_t>(distinct_values.size());
+  std::iota(sorted_order.begin(), sorted_order.end(), uint32_t{0});
+  std::sort(sorted_order.begin(), sorted_order.end(),
+            [&](const uint32_t lhs, const uint32_t rhs) { return distinct_values[lhs] < distinct_values[rhs]; });
+
+  dictionary.clear();
+  dictionary.reserve(distinct_values.size());
+  auto value_ids_by_first_occurrence = std::vector<ValueID::base_type>(distinct_values.size());
+  for (auto value_id = uint32_t{0}; value_id < sorted_order.size(); ++value_id) {
+    dictionary.push_back(std::move(distinct_values[sorted_order[value_id]]));
+    value_ids_by_first_occurrence[sorted_order[value_id]] = value_id;
+  }
+
+  // step 3: translate the first-occurrence indexes into value ids.
+  value_ids.resize(values.size());
+  for (auto index = size_t{0}; index < values.size(); ++index) {
+    value_ids[index] = value_ids_by_first_occurrence[first_occurrence_indexes[index]];
+  }
+}
+
+}  // namespace opossum
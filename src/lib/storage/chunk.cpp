@@ -3,6 +3,7 @@
 #include <limits>
 #include <memory>
 #include <mutex>
+#include <shared_mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -10,6 +11,7 @@
 #include "abstract_segment.hpp"
 #include "chunk.hpp"
 #include "resolve_type.hpp"
+#include "segment_statistics.hpp"
 
 #include "utils/assert.hpp"
 
@@ -24,6 +26,9 @@ void Chunk::add_segment(const std::shared_ptr<AbstractSegment> segment) { _segme
 void Chunk::insert_segment_at(const std::shared_ptr<AbstractSegment> segment, const ColumnID position) {
   DebugAssert(position < column_count(), "Can only substitute segments at existing indexes");
   _segments[position] = segment;
+
+  const auto lock = std::unique_lock{_statistics_mutex};
+  if (position < _statistics.size()) _statistics[position] = nullptr;
 }
 
 void Chunk::append(const std::vector<AllTypeVariant>& values) {
@@ -36,6 +41,31 @@ void Chunk::append(const std::vector<AllTypeVariant>& values) {
 
 std::shared_ptr<AbstractSegment> Chunk::get_segment(const ColumnID column_id) const { return _segments.at(column_id); }
 
+std::shared_ptr<const AbstractSegmentStatistics> Chunk::get_statistics(const ColumnID column_id) const {
+  const auto& segment = _segments.at(column_id);
+  const auto is_up_to_date = [&](const auto& statistics) {
+    return statistics && statistics->row_count() == segment->size();
+  };
+
+  {
+    const auto lock = std::shared_lock{_statistics_mutex};
+    if (column_id < _statistics.size() && is_up_to_date(_statistics[column_id])) return _statistics[column_id];
+  }
+
+  // Segments without statistics (e.g., reference segments) end up here on every call. This only costs a few failed
+  // casts in create_segment_statistics.
+  auto statistics = create_segment_statistics(segment);
+  const auto lock = std::unique_lock{_statistics_mutex};
+  if (_statistics.size() < _segments.size()) _statistics.resize(_segments.size());
+  _statistics[column_id] = statistics;
+  return statistics;
+}
+
+bool Chunk::can_prune(const ColumnID column_id, const ScanType scan_type, const AllTypeVariant& search_value) const {
+  const auto statistics = get_statistics(column_id);
+  return statistics && statistics->can_prune(scan_type, search_value);
+}
+
 ColumnCount Chunk::column_count() const { return static_cast<ColumnCount>(_segments.size()); }
 
 ChunkOffset Chunk::size() const { return _segments.size() ? _segments[0]->size() : 0; }
@@ -15,6 +15,7 @@ namespace opossum {
 
 class BaseIndex;
 class AbstractSegment;
+class AbstractSegmentStatistics;
 
 // A chunk is a horizontal partition of a table.
 // For each column in the table, it holds one segment. The segments across all chunks constitute the column.
@@ -50,9 +51,23 @@ class Chunk : private Noncopyable {
   // Returns the segment at a given position.
   std::shared_ptr<AbstractSegment> get_segment(ColumnID column_id) const;
 
+  // Returns the min/max statistics (zone map) of the segment at a given position, or nullptr if the segment has none
+  // (see create_segment_statistics). The statistics are computed on first use and cached. For immutable segments,
+  // this happens once, e.g., when Table::compress_chunk builds the chunk. The statistics of a ValueSegment are
+  // recomputed when values have been appended since.
+  std::shared_ptr<const AbstractSegmentStatistics> get_statistics(ColumnID column_id) const;
+
+  // Returns true if the statistics of the given column prove that no row satisfies value <scan_type> search_value.
+  bool can_prune(ColumnID column_id, const ScanType scan_type, const AllTypeVariant& search_value) const;
+
  protected:
   // Implementation goes here
   std::vector<std::shared_ptr<AbstractSegment>> _segments{};
+
+  // Cached statistics per column. They are computed lazily from const methods, so concurrent readers synchronize via
+  // the mutex.
+  mutable std::vector<std::shared_ptr<const AbstractSegmentStatistics>> _statistics{};
+  mutable std::shared_mutex _statistics_mutex{};
 };
 
 }  // namespace opossum
@@ -0,0 +1,29 @@
+#include "create_attribute_vector.hpp"
+
+#include <limits>
+#include <memory>
+
+#include "bit_packed_vector.hpp"
+#include "fixed_width_integer_vector.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+std::shared_ptr<AbstractAttributeVector> create_attribute_vector(const size_t size, const size_t unique_values_count,
+                                                                 const VectorCompressionType vector_compression_type) {
+  Assert(unique_values_count <= std::numeric_limits<uint32_t>::max(), "Too many unique values");
+  if (vector_compression_type == VectorCompressionType::BitPacking) {
+    const auto max_value_id = static_cast<ValueID::base_type>(unique_values_count > 0 ? unique_values_count - 1 : 0);
+    const auto bit_width = BitPackedVector::required_bit_width(max_value_id);
+    return std::make_shared<BitPackedVector>(size, bit_width);
+  }
+  if (unique_values_count <= std::numeric_limits<uint8_t>::max()) {
+    return std::make_shared<FixedWidthIntegerVector<uint8_t>>(size);
+  }
+  if (unique_values_count <= std::numeric_limits<uint16_t>::max()) {
+    return std::make_shared<FixedWidthIntegerVector<uint16_t>>(size);
+  }
+  return std::make_shared<FixedWidthIntegerVector<uint32_t>>(size);
+}
+
+}  // namespace opossum
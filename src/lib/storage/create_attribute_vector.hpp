@@ -0,0 +1,16 @@
+#pragma once
+
+#include <memory>
+
+#include "abstract_attribute_vector.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+// Creates an attribute vector for size value ids that refer to a dictionary with unique_values_count entries. By
+// default, value ids are stored with the smallest of 8, 16, or 32 bits. With VectorCompressionType::BitPacking, they
+// are stored with the minimal number of bits instead.
+std::shared_ptr<AbstractAttributeVector> create_attribute_vector(const size_t size, const size_t unique_values_count,
+                                                                 const VectorCompressionType vector_compression_type);
+
+}  // namespace opossum
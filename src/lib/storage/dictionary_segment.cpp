@@ -1,50 +1,48 @@
+#include <algorithm>
 #include <limits>
-#include <set>
-#include <unordered_map>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
 
+#include "build_dictionary.hpp"
+#include "create_attribute_vector.hpp"
 #include "dictionary_segment.hpp"
-#include "fixed_width_integer_vector.hpp"
 #include "type_cast.hpp"
 #include "types.hpp"
 #include "utils/assert.hpp"
+#include "utils/string_utils.hpp"
+#include "value_segment.hpp"
 
 namespace opossum {
 
 template <typename T>
-DictionarySegment<T>::DictionarySegment(const std::shared_ptr<AbstractSegment>& abstract_segment) {
-  // determine unique values and store in sorted set
-  auto dict_values = std::set<T>{};
-  auto segment_size = abstract_segment->size();
-  for (auto value_index = ChunkOffset{0}; value_index < segment_size; ++value_index) {
-    dict_values.emplace(type_cast<T>((*abstract_segment)[value_index]));
+DictionarySegment<T>::DictionarySegment(const std::shared_ptr<AbstractSegment>& abstract_segment,
+                                        const VectorCompressionType vector_compression_type) {
+  // read typed values directly from value segments. Other segments are
+  // materialized once using the generic interface.
+  const auto segment_size = abstract_segment->size();
+  const auto value_segment = std::dynamic_pointer_cast<const ValueSegment<T>>(abstract_segment);
+  auto materialized_values = std::vector<T>{};
+  if (!value_segment) {
+    materialized_values.reserve(segment_size);
+    for (auto value_index = ChunkOffset{0}; value_index < segment_size; ++value_index) {
+      materialized_values.push_back(type_cast<T>((*abstract_segment)[value_index]));
+    }
   }
+  const auto& values = value_segment ? value_segment->values() : materialized_values;
 
-  // select the right attribute vector integer type
-  auto n_unique_values = dict_values.size();
-  Assert(n_unique_values <= std::numeric_limits<uint32_t>::max(), "Too many unique values");
-  if (n_unique_values <= std::numeric_limits<uint8_t>::max()) {
-    _attribute_vector = std::make_shared<FixedWidthIntegerVector<uint8_t>>(segment_size);
-  } else if (n_unique_values <= std::numeric_limits<uint16_t>::max()) {
-    _attribute_vector = std::make_shared<FixedWidthIntegerVector<uint16_t>>(segment_size);
-  } else {
-    _attribute_vector = std::make_shared<FixedWidthIntegerVector<uint32_t>>(segment_size);
-  }
+  // build the dictionary and determine the value id of every value.
+  auto value_ids = std::vector<ValueID::base_type>{};
+  build_dictionary(values, _dictionary, value_ids);
+  _dictionary.shrink_to_fit();
 
-  // build dictionary and store dictionary indexes in hash map for quick lookup during encoding
-  auto dict_indexes = std::unordered_map<T, ValueID>{};
-  dict_indexes.reserve(n_unique_values);
-  _dictionary.reserve(n_unique_values);
-  auto cur_dict_index = ValueID{0};
-  for (const auto& value : dict_values) {
-    _dictionary.push_back(value);
-    dict_indexes[value] = cur_dict_index;
-    cur_dict_index++;
-  }
+  // select the right attribute vector integer type
+  _attribute_vector = create_attribute_vector(segment_size, _dictionary.size(), vector_compression_type);
 
   // apply dictionary encoding to input segment
   for (auto value_index = ChunkOffset{0}; value_index < segment_size; ++value_index) {
-    auto cur_value = type_cast<T>((*abstract_segment)[value_index]);
-    _attribute_vector->set(value_index, dict_indexes[cur_value]);
+    _attribute_vector->set(value_index, ValueID{value_ids[value_index]});
   }
 }
 
@@ -119,7 +117,13 @@ ChunkOffset DictionarySegment<T>::size() const {
 template <typename T>
 size_t DictionarySegment<T>::estimate_memory_usage() const {
   auto dict_size = sizeof(T) * dictionary().size();
-  auto att_vec_size = attribute_vector()->width() * attribute_vector()->size();
+  if constexpr (std::is_same_v<T, std::string>) {
+    // long strings additionally allocate their characters on the heap.
+    for (const auto& value : _dictionary) {
+      dict_size += string_heap_size(value);
+    }
+  }
+  auto att_vec_size = attribute_vector()->estimate_memory_usage();
   return dict_size + att_vec_size;
 }
 
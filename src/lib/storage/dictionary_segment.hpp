@@ -22,9 +22,12 @@ template <typename T>
 class DictionarySegment : public AbstractSegment {
  public:
   /**
-   * Creates a Dictionary segment from a given value segment.
+   * Creates a Dictionary segment from a given value segment. By default, value ids are stored with the smallest of 8,
+   * 16, or 32 bits. With VectorCompressionType::BitPacking, they are stored with the minimal number of bits instead.
    */
-  explicit DictionarySegment(const std::shared_ptr<AbstractSegment>& abstract_segment);
+  explicit DictionarySegment(
+      const std::shared_ptr<AbstractSegment>& abstract_segment,
+      const VectorCompressionType vector_compression_type = VectorCompressionType::FixedWidthInteger);
 
   // Return the value at a certain position. If you want to write efficient operators, back off!
   AllTypeVariant operator[](const ChunkOffset chunk_offset) const override;
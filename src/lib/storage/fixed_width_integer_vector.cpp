@@ -1,5 +1,8 @@
 #include "fixed_width_integer_vector.hpp"
 
+#include <algorithm>
+#include <string>
+
 #include "types.hpp"
 #include "utils/assert.hpp"
 
@@ -14,6 +17,14 @@ ValueID FixedWidthIntegerVector<uintX_t>::get(const size_t index) const {
   return static_cast<ValueID>(_vector.at(index));
 }
 
+template <typename uintX_t>
+void FixedWidthIntegerVector<uintX_t>::decode(const size_t begin, const size_t end, ValueID::base_type* output) const {
+  DebugAssert(begin <= end && end <= size(), "range [" + std::to_string(begin) + ", " + std::to_string(end) +
+                                                 ") out of bounds for FixedWidthIntegerVector with size " +
+                                                 std::to_string(size()));
+  std::copy(_vector.cbegin() + begin, _vector.cbegin() + end, output);
+}
+
 template <typename uintX_t>
 void FixedWidthIntegerVector<uintX_t>::set(const size_t index, const ValueID value_id) {
   DebugAssert(index < size(), "index " + std::to_string(index) +
@@ -31,6 +42,16 @@ AttributeVectorWidth FixedWidthIntegerVector<uintX_t>::width() const {
   return static_cast<AttributeVectorWidth>(sizeof(uintX_t));
 }
 
+template <typename uintX_t>
+size_t FixedWidthIntegerVector<uintX_t>::estimate_memory_usage() const {
+  return sizeof(uintX_t) * _vector.size();
+}
+
+template <typename uintX_t>
+const std::vector<uintX_t>& FixedWidthIntegerVector<uintX_t>::data() const {
+  return _vector;
+}
+
 template class FixedWidthIntegerVector<uint8_t>;
 template class FixedWidthIntegerVector<uint16_t>;
 template class FixedWidthIntegerVector<uint32_t>;
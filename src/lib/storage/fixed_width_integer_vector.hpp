@@ -12,9 +12,18 @@ class FixedWidthIntegerVector : public AbstractAttributeVector {
  public:
   explicit FixedWidthIntegerVector(const size_t capacity);
   ValueID get(const size_t index) const override;
+  void decode(const size_t begin, const size_t end, ValueID::base_type* output) const override;
   void set(const size_t index, const ValueID value_id) override;
   size_t size() const override;
   AttributeVectorWidth width() const override;
+  size_t estimate_memory_usage() const override;
+
+  // Returns the value id at the given position without bounds checking. Unlike get, this is not virtual and can be
+  // inlined into the loops of operators that obtained the concrete vector via resolve_attribute_vector_type.
+  ValueID operator[](const size_t index) const { return ValueID{_vector[index]}; }
+
+  // Returns the underlying codes, e.g., for scanning them with the SIMD kernels.
+  const std::vector<uintX_t>& data() const;
 
  protected:
   std::vector<uintX_t> _vector{};
@@ -0,0 +1,211 @@
+#include "frame_of_reference_segment.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "type_cast.hpp"
+#include "utils/assert.hpp"
+#include "value_segment.hpp"
+
+namespace opossum {
+
+namespace {
+
+// Values are packed horizontally into 64-bit words, i.e., value i of a block occupies the bit_width bits starting at
+// bit i * bit_width. A value may span two words.
+void pack_values(const std::vector<uint64_t>& values, const uint8_t bit_width, std::vector<uint64_t>& words) {
+  if (bit_width == 0) return;
+  const auto first_word_index = words.size();
+  words.resize(first_word_index + (values.size() * bit_width + 63) / 64);
+  for (auto index = size_t{0}; index < values.size(); ++index) {
+    const auto bit_offset = index * bit_width;
+    const auto word_index = first_word_index + bit_offset / 64;
+    const auto shift = bit_offset % 64;
+    words[word_index] |= values[index] << shift;
+    if (shift + bit_width > 64) words[word_index + 1] |= values[index] >> (64 - shift);
+  }
+}
+
+// Reads the value at the given index. The second word is always read so that the function is free of branches. The
+// shift is split in two to be well-defined for shift == 0. Reading past the last block is safe because the segment
+// stores padding words after it.
+uint64_t unpack_value(const uint64_t* words, const uint8_t bit_width, const size_t index) {
+  const auto bit_offset = index * bit_width;
+  const auto word_index = bit_offset / 64;
+  const auto shift = bit_offset % 64;
+  const auto mask = bit_width == 64 ? ~uint64_t{0} : (uint64_t{1} << bit_width) - 1;
+  return ((words[word_index] >> shift) | ((words[word_index + 1] << 1) << (63 - shift))) & mask;
+}
+
+}  // namespace
+
+template <typename T>
+FrameOfReferenceSegment<T>::FrameOfReferenceSegment(const std::shared_ptr<AbstractSegment>& abstract_segment,
+                                                    const bool use_delta_encoding)
+    : _size{abstract_segment->size()}, _use_delta_encoding{use_delta_encoding} {
+  using UnsignedT = std::make_unsigned_t<T>;
+
+  // read typed values directly from value segments and materialize them using the generic interface otherwise.
+  const auto value_segment = std::dynamic_pointer_cast<const ValueSegment<T>>(abstract_segment);
+  auto materialized_values = std::vector<T>{};
+  if (!value_segment) {
+    materialized_values.reserve(_size);
+    for (auto chunk_offset = ChunkOffset{0}; chunk_offset < _size; ++chunk_offset) {
+      materialized_values.push_back(type_cast<T>((*abstract_segment)[chunk_offset]));
+    }
+  }
+  const auto& values = value_segment ? value_segment->values() : materialized_values;
+
+  const auto n_blocks = block_count();
+  _block_minima.reserve(n_blocks);
+  _block_maxima.reserve(n_blocks);
+  _block_bit_widths.reserve(n_blocks);
+  _block_uses_delta.reserve(n_blocks);
+  _block_word_offsets.reserve(n_blocks);
+
+  auto packed_values = std::vector<uint64_t>{};
+  for (auto block_index = size_t{0}; block_index < n_blocks; ++block_index) {
+    const auto block_begin = values.cbegin() + block_index * BLOCK_SIZE;
+    const auto block_end = values.cbegin() + std::min(size_t{_size}, (block_index + 1) * BLOCK_SIZE);
+    const auto [minimum_iter, maximum_iter] = std::minmax_element(block_begin, block_end);
+    const auto minimum = *minimum_iter;
+    const auto block_uses_delta = use_delta_encoding && std::is_sorted(block_begin, block_end);
+
+    // the differences are computed on the unsigned type, where they cannot overflow.
+    packed_values.resize(std::distance(block_begin, block_end));
+    for (auto value_iter = block_begin; value_iter != block_end; ++value_iter) {
+      const auto reference = block_uses_delta && value_iter != block_begin ? *(value_iter - 1) : minimum;
+      packed_values[std::distance(block_begin, value_iter)] =
+          static_cast<UnsignedT>(static_cast<UnsignedT>(*value_iter) - static_cast<UnsignedT>(reference));
+    }
+    const auto bit_width =
+        static_cast<uint8_t>(std::bit_width(*std::max_element(packed_values.cbegin(), packed_values.cend())));
+
+    _block_minima.push_back(minimum);
+    _block_maxima.push_back(*maximum_iter);
+    _block_bit_widths.push_back(bit_width);
+    _block_uses_delta.push_back(block_uses_delta);
+    _block_word_offsets.push_back(_words.size());
+    pack_values(packed_values, bit_width, _words);
+  }
+
+  // padding for the branch-free unpacking, which reads up to two words after the start of the last block if its bit
+  // width is 0.
+  _words.resize(_words.size() + 2);
+  _words.shrink_to_fit();
+}
+
+template <typename T>
+AllTypeVariant FrameOfReferenceSegment<T>::operator[](const ChunkOffset chunk_offset) const {
+  return AllTypeVariant{get(chunk_offset)};
+}
+
+template <typename T>
+T FrameOfReferenceSegment<T>::get(const ChunkOffset chunk_offset) const {
+  Assert(chunk_offset < _size, "chunk offset " + std::to_string(chunk_offset) +
+                                   " out of bounds for FrameOfReferenceSegment with size " + std::to_string(_size));
+  using UnsignedT = std::make_unsigned_t<T>;
+  const auto block_index = chunk_offset / BLOCK_SIZE;
+  const auto index_in_block = chunk_offset % BLOCK_SIZE;
+  const auto* block_words = _words.data() + _block_word_offsets[block_index];
+  const auto bit_width = _block_bit_widths[block_index];
+
+  auto offset = UnsignedT{0};
+  if (_block_uses_delta[block_index]) {
+    // sum up the differences from the start of the block.
+    for (auto index = size_t{0}; index <= index_in_block; ++index) {
+      offset += static_cast<UnsignedT>(unpack_value(block_words, bit_width, index));
+    }
+  } else {
+    offset = static_cast<UnsignedT>(unpack_value(block_words, bit_width, index_in_block));
+  }
+  return static_cast<T>(static_cast<UnsignedT>(_block_minima[block_index]) + offset);
+}
+
+template <typename T>
+void FrameOfReferenceSegment<T>::append(const AllTypeVariant& value) {
+  Fail("Frame-of-reference segments are immutable, i.e., values cannot be appended.");
+}
+
+template <typename T>
+ChunkOffset FrameOfReferenceSegment<T>::size() const {
+  return _size;
+}
+
+template <typename T>
+size_t FrameOfReferenceSegment<T>::estimate_memory_usage() const {
+  const auto n_blocks = block_count();
+  const auto block_header_size = 2 * sizeof(T) + sizeof(uint8_t) + sizeof(size_t);
+  return n_blocks * block_header_size + (n_blocks + 7) / 8 + sizeof(uint64_t) * _words.size();
+}
+
+template <typename T>
+bool FrameOfReferenceSegment<T>::uses_delta_encoding() const {
+  return _use_delta_encoding;
+}
+
+template <typename T>
+size_t FrameOfReferenceSegment<T>::block_count() const {
+  return (size_t{_size} + BLOCK_SIZE - 1) / BLOCK_SIZE;
+}
+
+template <typename T>
+T FrameOfReferenceSegment<T>::block_minimum(const size_t block_index) const {
+  return _block_minima.at(block_index);
+}
+
+template <typename T>
+T FrameOfReferenceSegment<T>::block_maximum(const size_t block_index) const {
+  return _block_maxima.at(block_index);
+}
+
+template <typename T>
+void FrameOfReferenceSegment<T>::decode_block(const size_t block_index, T* output) const {
+  // signed and unsigned integers of the same size may alias each other. Adding the minimum on the unsigned type wraps
+  // around to the original value without overflowing.
+  using UnsignedT = std::make_unsigned_t<T>;
+  auto* offsets = reinterpret_cast<UnsignedT*>(output);
+  _decode_block_offsets(block_index, offsets);
+
+  const auto value_count = std::min(BLOCK_SIZE, size_t{_size} - block_index * BLOCK_SIZE);
+  const auto minimum = static_cast<UnsignedT>(_block_minima[block_index]);
+  for (auto index = size_t{0}; index < value_count; ++index) {
+    offsets[index] += minimum;
+  }
+}
+
+template <typename T>
+void FrameOfReferenceSegment<T>::decode_block_offsets(const size_t block_index, uint32_t* output) const {
+  DebugAssert(static_cast<uint64_t>(_block_maxima[block_index]) - static_cast<uint64_t>(_block_minima[block_index]) <=
+                  std::numeric_limits<uint32_t>::max(),
+              "Offsets of block " + std::to_string(block_index) + " do not fit into 32 bits");
+  _decode_block_offsets(block_index, output);
+}
+
+template <typename T>
+template <typename OffsetType>
+void FrameOfReferenceSegment<T>::_decode_block_offsets(const size_t block_index, OffsetType* output) const {
+  DebugAssert(block_index < block_count(), "block index " + std::to_string(block_index) + " out of bounds");
+  const auto value_count = std::min(BLOCK_SIZE, size_t{_size} - block_index * BLOCK_SIZE);
+  const auto* block_words = _words.data() + _block_word_offsets[block_index];
+  const auto bit_width = _block_bit_widths[block_index];
+  for (auto index = size_t{0}; index < value_count; ++index) {
+    output[index] = static_cast<OffsetType>(unpack_value(block_words, bit_width, index));
+  }
+
+  // in delta blocks, the offset of a value to the minimum is the sum of the preceding differences. As the block is
+  // sorted, the sums never exceed the difference between maximum and minimum.
+  if (_block_uses_delta[block_index]) std::partial_sum(output, output + value_count, output);
+}
+
+// Frame-of-reference encoding only applies to the integral types of data_types_macro.
+template class FrameOfReferenceSegment<int32_t>;
+template class FrameOfReferenceSegment<int64_t>;
+
+}  // namespace opossum
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "abstract_segment.hpp"
+#include "all_type_variant.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+// FrameOfReferenceSegment is a specific segment type for integer columns. Values are split into blocks of BLOCK_SIZE,
+// and each block stores its minimum (the frame of reference) and its maximum. The values are stored as offsets to the
+// minimum, bit-packed with the number of bits needed for the largest offset of the block.
+//
+// In delta mode, which is meant for monotonically increasing keys, a block stores the differences between consecutive
+// values instead. These are usually much smaller than the offsets to the minimum, but random access has to sum up the
+// differences from the start of the block. Blocks that are not sorted fall back to offsets to the minimum.
+template <typename T>
+class FrameOfReferenceSegment : public AbstractSegment {
+  static_assert(std::is_integral_v<T>, "FrameOfReferenceSegment only supports integral types");
+
+ public:
+  static constexpr auto BLOCK_SIZE = size_t{2048};
+
+  // Creates a frame-of-reference segment from a given value segment.
+  explicit FrameOfReferenceSegment(const std::shared_ptr<AbstractSegment>& abstract_segment,
+                                   const bool use_delta_encoding = false);
+
+  // Return the value at a certain position. If you want to write efficient operators, back off!
+  AllTypeVariant operator[](const ChunkOffset chunk_offset) const override;
+
+  // Return the value at a certain position.
+  T get(const ChunkOffset chunk_offset) const;
+
+  // Frame-of-reference segments are immutable.
+  void append(const AllTypeVariant& value) override;
+
+  // Return the number of entries.
+  ChunkOffset size() const override;
+
+  // Returns the calculated memory usage.
+  size_t estimate_memory_usage() const final;
+
+  bool uses_delta_encoding() const;
+
+  size_t block_count() const;
+
+  // Returns the smallest and the largest value of the given block.
+  T block_minimum(const size_t block_index) const;
+  T block_maximum(const size_t block_index) const;
+
+  // Writes the values of the given block to output, which must have room for BLOCK_SIZE values. Only the last block
+  // may hold fewer than BLOCK_SIZE values.
+  void decode_block(const size_t block_index, T* output) const;
+
+  // Writes the offsets of the values of the given block to the block minimum to output, which must have room for
+  // BLOCK_SIZE values. This allows comparing against a search value that was rewritten relative to the block minimum
+  // without adding the minimum to each value. The difference between block maximum and minimum must fit into 32 bits.
+  void decode_block_offsets(const size_t block_index, uint32_t* output) const;
+
+ protected:
+  template <typename OffsetType>
+  void _decode_block_offsets(const size_t block_index, OffsetType* output) const;
+
+  ChunkOffset _size{0};
+  bool _use_delta_encoding;
+  std::vector<T> _block_minima{};
+  std::vector<T> _block_maxima{};
+  std::vector<uint8_t> _block_bit_widths{};
+  std::vector<bool> _block_uses_delta{};
+  // Index of the first word of each block in _words.
+  std::vector<size_t> _block_word_offsets{};
+  std::vector<uint64_t> _words{};
+};
+
+}  // namespace opossum
@@ -0,0 +1,226 @@
+#include "front_coded_dictionary_segment.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "build_dictionary.hpp"
+#include "create_attribute_vector.hpp"
+#include "dictionary_segment.hpp"
+#include "type_cast.hpp"
+#include "utils/assert.hpp"
+#include "value_segment.hpp"
+
+namespace opossum {
+
+namespace {
+
+// Lengths are stored as variable-length integers with seven bits per byte. The highest bit of a byte is set if more
+// bytes follow. Most prefix and suffix lengths need a single byte.
+void append_varint(std::vector<char>& heap, size_t value) {
+  while (value >= 0x80) {
+    heap.push_back(static_cast<char>((value & 0x7F) | 0x80));
+    value >>= 7;
+  }
+  heap.push_back(static_cast<char>(value));
+}
+
+size_t read_varint(const char*& position) {
+  auto value = size_t{0};
+  auto shift = 0;
+  auto byte = uint8_t{0};
+  do {
+    byte = static_cast<uint8_t>(*position++);
+    value |= size_t{byte & 0x7Fu} << shift;
+    shift += 7;
+  } while (byte & 0x80);
+  return value;
+}
+
+}  // namespace
+
+template <typename T>
+FrontCodedDictionarySegment<T>::FrontCodedDictionarySegment(const std::shared_ptr<AbstractSegment>& abstract_segment,
+                                                            const VectorCompressionType vector_compression_type) {
+  // read typed values directly from value segments and materialize them using the generic interface otherwise.
+  const auto segment_size = abstract_segment->size();
+  const auto value_segment = std::dynamic_pointer_cast<const ValueSegment<T>>(abstract_segment);
+  auto materialized_values = std::vector<T>{};
+  if (!value_segment) {
+    materialized_values.reserve(segment_size);
+    for (auto chunk_offset = ChunkOffset{0}; chunk_offset < segment_size; ++chunk_offset) {
+      materialized_values.push_back(type_cast<T>((*abstract_segment)[chunk_offset]));
+    }
+  }
+  const auto& values = value_segment ? value_segment->values() : materialized_values;
+
+  // the uncompressed dictionary is only needed during construction.
+  auto dictionary = std::vector<T>{};
+  auto value_ids = std::vector<ValueID::base_type>{};
+  build_dictionary(values, dictionary, value_ids);
+  _unique_values_count = static_cast<ChunkOffset>(dictionary.size());
+
+  // front-code the dictionary block by block.
+  _block_offsets.reserve((dictionary.size() + BLOCK_SIZE - 1) / BLOCK_SIZE);
+  for (auto value_id = size_t{0}; value_id < dictionary.size(); ++value_id) {
+    const auto& value = dictionary[value_id];
+    if (value_id % BLOCK_SIZE == 0) {
+      Assert(_string_heap.size() <= std::numeric_limits<uint32_t>::max(), "String heap exceeds 4 GB");
+      _block_offsets.push_back(static_cast<uint32_t>(_string_heap.size()));
+      append_varint(_string_heap, value.size());
+      _string_heap.insert(_string_heap.end(), value.cbegin(), value.cend());
+      continue;
+    }
+
+    const auto& previous_value = dictionary[value_id - 1];
+    const auto max_prefix_length = std::min(value.size(), previous_value.size());
+    const auto prefix_length = static_cast<size_t>(
+        std::mismatch(value.cbegin(), value.cbegin() + max_prefix_length, previous_value.cbegin()).first -
+        value.cbegin());
+    append_varint(_string_heap, prefix_length);
+    append_varint(_string_heap, value.size() - prefix_length);
+    _string_heap.insert(_string_heap.end(), value.cbegin() + prefix_length, value.cend());
+  }
+  _string_heap.shrink_to_fit();
+
+  _attribute_vector = create_attribute_vector(segment_size, dictionary.size(), vector_compression_type);
+  for (auto chunk_offset = ChunkOffset{0}; chunk_offset < segment_size; ++chunk_offset) {
+    _attribute_vector->set(chunk_offset, ValueID{value_ids[chunk_offset]});
+  }
+}
+
+template <typename T>
+AllTypeVariant FrontCodedDictionarySegment<T>::operator[](const ChunkOffset chunk_offset) const {
+  return AllTypeVariant{get(chunk_offset)};
+}
+
+template <typename T>
+T FrontCodedDictionarySegment<T>::get(const ChunkOffset chunk_offset) const {
+  return value_of_value_id(_attribute_vector->get(chunk_offset));
+}
+
+template <typename T>
+void FrontCodedDictionarySegment<T>::append(const AllTypeVariant& value) {
+  Fail("Dictionary segments are immutable, i.e., values cannot be appended.");
+}
+
+template <typename T>
+std::shared_ptr<const AbstractAttributeVector> FrontCodedDictionarySegment<T>::attribute_vector() const {
+  return _attribute_vector;
+}
+
+template <typename T>
+T FrontCodedDictionarySegment<T>::value_of_value_id(const ValueID value_id) const {
+  Assert(value_id < _unique_values_count, "value id " + std::to_string(value_id) +
+                                              " out of bounds for dictionary with " +
+                                              std::to_string(_unique_values_count) + " entries");
+  auto result = T{};
+  _for_each_in_block(value_id / BLOCK_SIZE, [&](const ValueID current_value_id, const std::string& value) {
+    if (current_value_id < value_id) return true;
+    result = value;
+    return false;
+  });
+  return result;
+}
+
+template <typename T>
+ValueID FrontCodedDictionarySegment<T>::lower_bound(const T& value) const {
+  return _bound(value, false);
+}
+
+template <typename T>
+ValueID FrontCodedDictionarySegment<T>::lower_bound(const AllTypeVariant& value) const {
+  return lower_bound(type_cast<T>(value));
+}
+
+template <typename T>
+ValueID FrontCodedDictionarySegment<T>::upper_bound(const T& value) const {
+  return _bound(value, true);
+}
+
+template <typename T>
+ValueID FrontCodedDictionarySegment<T>::upper_bound(const AllTypeVariant& value) const {
+  return upper_bound(type_cast<T>(value));
+}
+
+template <typename T>
+ChunkOffset FrontCodedDictionarySegment<T>::unique_values_count() const {
+  return _unique_values_count;
+}
+
+template <typename T>
+ChunkOffset FrontCodedDictionarySegment<T>::size() const {
+  return static_cast<ChunkOffset>(_attribute_vector->size());
+}
+
+template <typename T>
+size_t FrontCodedDictionarySegment<T>::estimate_memory_usage() const {
+  return _string_heap.size() + sizeof(uint32_t) * _block_offsets.size() + _attribute_vector->estimate_memory_usage();
+}
+
+template <typename T>
+std::string_view FrontCodedDictionarySegment<T>::_block_header(const size_t block_index) const {
+  const auto* position = _string_heap.data() + _block_offsets[block_index];
+  const auto length = read_varint(position);
+  return std::string_view{position, length};
+}
+
+template <typename T>
+ValueID FrontCodedDictionarySegment<T>::_bound(const std::string_view value, const bool upper_bound) const {
+  const auto is_past_bound = [&](const std::string_view dictionary_value) {
+    return upper_bound ? dictionary_value > value : dictionary_value >= value;
+  };
+
+  // find the first block whose header is already past the bound. Only the block before it has to be decoded.
+  auto first_block = size_t{0};
+  auto block_count = _block_offsets.size();
+  while (block_count > 0) {
+    const auto step = block_count / 2;
+    if (!is_past_bound(_block_header(first_block + step))) {
+      first_block += step + 1;
+      block_count -= step + 1;
+    } else {
+      block_count = step;
+    }
+  }
+
+  auto result = static_cast<ValueID>(first_block * BLOCK_SIZE);
+  if (first_block > 0) {
+    _for_each_in_block(first_block - 1, [&](const ValueID value_id, const std::string& dictionary_value) {
+      if (!is_past_bound(dictionary_value)) return true;
+      result = value_id;
+      return false;
+    });
+  }
+  return result < _unique_values_count ? result : INVALID_VALUE_ID;
+}
+
+template <typename T>
+template <typename Functor>
+void FrontCodedDictionarySegment<T>::_for_each_in_block(const size_t block_index, const Functor& functor) const {
+  const auto block_begin = block_index * BLOCK_SIZE;
+  const auto block_end = std::min(block_begin + BLOCK_SIZE, size_t{_unique_values_count});
+
+  // each value is reconstructed from the prefix of its predecessor and its own suffix.
+  const auto header = _block_header(block_index);
+  auto value = std::string{header};
+  const auto* position = header.data() + header.size();
+  for (auto value_id = block_begin; value_id < block_end; ++value_id) {
+    if (value_id > block_begin) {
+      const auto prefix_length = read_varint(position);
+      const auto suffix_length = read_varint(position);
+      value.resize(prefix_length);
+      value.append(position, suffix_length);
+      position += suffix_length;
+    }
+    if (!functor(static_cast<ValueID>(value_id), value)) return;
+  }
+}
+
+// Front coding only applies to strings.
+template class FrontCodedDictionarySegment<std::string>;
+
+}  // namespace opossum
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "abstract_attribute_vector.hpp"
+#include "abstract_segment.hpp"
+#include "all_type_variant.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+// FrontCodedDictionarySegment is a dictionary segment for strings whose dictionary is compressed with front coding.
+// Sorted strings often share long prefixes with their predecessor (e.g., URLs), so each string only stores the length
+// of the prefix it shares with its predecessor and the remaining suffix.
+//
+// The dictionary is split into blocks of BLOCK_SIZE strings that are stored consecutively in a single string heap. The
+// first string of each block is stored completely, so lower_bound and upper_bound can binary search over the blocks
+// and only decode a single block. Value ids are the same as in a DictionarySegment, so scans work in value id space.
+template <typename T>
+class FrontCodedDictionarySegment : public AbstractSegment {
+  static_assert(std::is_same_v<T, std::string>, "FrontCodedDictionarySegment only supports strings");
+
+ public:
+  static constexpr auto BLOCK_SIZE = size_t{16};
+
+  // Creates a front-coded dictionary segment from a given value segment. See DictionarySegment for the vector
+  // compression types.
+  explicit FrontCodedDictionarySegment(
+      const std::shared_ptr<AbstractSegment>& abstract_segment,
+      const VectorCompressionType vector_compression_type = VectorCompressionType::FixedWidthInteger);
+
+  // Return the value at a certain position. If you want to write efficient operators, back off!
+  AllTypeVariant operator[](const ChunkOffset chunk_offset) const override;
+
+  // Return the value at a certain position. This decodes the dictionary block of the value.
+  T get(const ChunkOffset chunk_offset) const;
+
+  // Front-coded dictionary segments are immutable.
+  void append(const AllTypeVariant& value) override;
+
+  // Returns an underlying data structure.
+  std::shared_ptr<const AbstractAttributeVector> attribute_vector() const;
+
+  // Return the value represented by a given ValueID.
+  T value_of_value_id(const ValueID value_id) const;
+
+  // Returns the first value ID that refers to a value >= the search value. Returns INVALID_VALUE_ID if all values are
+  // smaller than the search value.
+  ValueID lower_bound(const T& value) const;
+
+  // Same as lower_bound(T), but accepts an AllTypeVariant.
+  ValueID lower_bound(const AllTypeVariant& value) const;
+
+  // Returns the first value ID that refers to a value > the search value. Returns INVALID_VALUE_ID if all values are
+  // smaller than or equal to the search value.
+  ValueID upper_bound(const T& value) const;
+
+  // Same as upper_bound(T), but accepts an AllTypeVariant.
+  ValueID upper_bound(const AllTypeVariant& value) const;
+
+  // Return the number of unique_values (dictionary entries).
+  ChunkOffset unique_values_count() const;
+
+  // Return the number of entries.
+  ChunkOffset size() const override;
+
+  // Returns the calculated memory usage.
+  size_t estimate_memory_usage() const final;
+
+ protected:
+  // Returns the first string of a block, which is stored without front coding.
+  std::string_view _block_header(const size_t block_index) const;
+
+  // Returns the first value ID whose value is >= (lower bound) or > (upper bound) the search value.
+  ValueID _bound(const std::string_view value, const bool upper_bound) const;
+
+  // Calls functor(value_id, value) for the values of a block in order until it returns false.
+  template <typename Functor>
+  void _for_each_in_block(const size_t block_index, const Functor& functor) const;
+
+  ChunkOffset _unique_values_count{0};
+  std::vector<char> _string_heap{};
+  // Position of each block in _string_heap.
+  std::vector<uint32_t> _block_offsets{};
+  std::shared_ptr<AbstractAttributeVector> _attribute_vector{};
+};
+
+}  // namespace opossum
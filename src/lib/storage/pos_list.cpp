@@ -0,0 +1,166 @@
+#include <algorithm>
+#include <bit>
+#include <initializer_list>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "pos_list.hpp"
+#include "types.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+PosList::PosList(std::initializer_list<RowID> row_ids) : _row_ids{row_ids} {}
+
+PosList::PosList(std::vector<RowID> row_ids) : _row_ids{std::move(row_ids)} {}
+
+PosList::PosList(const ChunkID chunk_id, std::vector<ChunkOffset> chunk_offsets)
+    : _representation{Representation::ChunkOffsets},
+      _common_chunk_id{chunk_id},
+      _chunk_offsets{std::move(chunk_offsets)} {}
+
+PosList::PosList(const ChunkID chunk_id, std::vector<uint64_t> bitmap)
+    : _representation{Representation::Bitmap}, _common_chunk_id{chunk_id}, _bitmap{std::move(bitmap)} {
+  _bitmap_ranks.reserve(_bitmap.size() / RANK_SAMPLE_WORDS + 1);
+  for (auto word_index = size_t{0}; word_index < _bitmap.size(); ++word_index) {
+    if (word_index % RANK_SAMPLE_WORDS == 0) _bitmap_ranks.push_back(static_cast<ChunkOffset>(_bitmap_size));
+    _bitmap_size += std::popcount(_bitmap[word_index]);
+  }
+}
+
+size_t PosList::size() const {
+  switch (_representation) {
+    case Representation::RowIDs:
+      return _row_ids.size();
+    case Representation::ChunkOffsets:
+      return _chunk_offsets.size();
+    case Representation::Bitmap:
+      return _bitmap_size;
+  }
+  Fail("Unknown representation");
+}
+
+bool PosList::empty() const { return size() == 0; }
+
+void PosList::reserve(const size_t capacity) {
+  if (_representation == Representation::RowIDs) {
+    _row_ids.reserve(capacity);
+  } else if (_representation == Representation::ChunkOffsets) {
+    _chunk_offsets.reserve(capacity);
+  }
+}
+
+void PosList::emplace_back(const RowID& row_id) {
+  if (_representation == Representation::RowIDs) {
+    _row_ids.emplace_back(row_id);
+    return;
+  }
+
+  if (_representation == Representation::Bitmap) {
+    const auto word_index = row_id.chunk_offset / 64;
+    const auto bit = uint64_t{1} << (row_id.chunk_offset % 64);
+    const auto follows_last_bit = _bitmap_size == 0 || row_id.chunk_offset > _bitmap_select(_bitmap_size - 1);
+    if (row_id.chunk_id == _common_chunk_id && follows_last_bit && word_index < _bitmap.size()) {
+      for (auto rank_index = word_index / RANK_SAMPLE_WORDS + 1; rank_index < _bitmap_ranks.size(); ++rank_index) {
+        ++_bitmap_ranks[rank_index];
+      }
+      _bitmap[word_index] |= bit;
+      ++_bitmap_size;
+      return;
+    }
+
+    _chunk_offsets = materialize_chunk_offsets();
+    _bitmap = std::vector<uint64_t>{};
+    _bitmap_ranks = std::vector<ChunkOffset>{};
+    _bitmap_size = 0;
+    _representation = Representation::ChunkOffsets;
+  }
+
+  if (row_id.chunk_id == _common_chunk_id) {
+    _chunk_offsets.emplace_back(row_id.chunk_offset);
+    return;
+  }
+
+  // the position points to another chunk, so the chunk ids have to be stored for each position.
+  _row_ids.reserve(std::max(_chunk_offsets.capacity(), _chunk_offsets.size() + 1));
+  for (const auto chunk_offset : _chunk_offsets) {
+    _row_ids.emplace_back(RowID{_common_chunk_id, chunk_offset});
+  }
+  _row_ids.emplace_back(row_id);
+  _chunk_offsets = std::vector<ChunkOffset>{};
+  _representation = Representation::RowIDs;
+}
+
+bool PosList::references_single_chunk() const { return _representation != Representation::RowIDs; }
+
+bool PosList::is_bitmap() const { return _representation == Representation::Bitmap; }
+
+ChunkID PosList::common_chunk_id() const {
+  DebugAssert(references_single_chunk(), "PosList does not reference a single chunk");
+  return _common_chunk_id;
+}
+
+std::vector<ChunkOffset> PosList::materialize_chunk_offsets() const {
+  DebugAssert(references_single_chunk(), "PosList does not reference a single chunk");
+  if (_representation == Representation::ChunkOffsets) return _chunk_offsets;
+
+  auto chunk_offsets = std::vector<ChunkOffset>(_bitmap_size);
+  auto output_index = size_t{0};
+  for (auto word_index = size_t{0}; word_index < _bitmap.size(); ++word_index) {
+    for (auto word = _bitmap[word_index]; word != 0; word &= word - 1) {
+      chunk_offsets[output_index++] = static_cast<ChunkOffset>(word_index * 64 + std::countr_zero(word));
+    }
+  }
+  return chunk_offsets;
+}
+
+const std::vector<ChunkOffset>& PosList::chunk_offsets() const {
+  DebugAssert(_representation == Representation::ChunkOffsets, "PosList does not store chunk offsets");
+  return _chunk_offsets;
+}
+
+const std::vector<uint64_t>& PosList::bitmap() const {
+  DebugAssert(_representation == Representation::Bitmap, "PosList is not a bitmap");
+  return _bitmap;
+}
+
+const std::vector<RowID>& PosList::row_ids() const {
+  DebugAssert(_representation == Representation::RowIDs, "PosList references a single chunk and does not store RowIDs");
+  return _row_ids;
+}
+
+PosList::ConstIterator PosList::begin() const { return ConstIterator{*this, 0}; }
+
+PosList::ConstIterator PosList::end() const { return ConstIterator{*this, size()}; }
+
+size_t PosList::memory_usage() const {
+  return sizeof(ChunkOffset) * (_chunk_offsets.capacity() + _bitmap_ranks.capacity()) +
+         sizeof(RowID) * _row_ids.capacity() + sizeof(uint64_t) * _bitmap.capacity();
+}
+
+bool PosList::operator==(const PosList& other) const {
+  return size() == other.size() && std::equal(begin(), end(), other.begin());
+}
+
+ChunkOffset PosList::_bitmap_select(const size_t index) const {
+  DebugAssert(index < _bitmap_size, "Position " + std::to_string(index) + " is out of range");
+  // find the last sample before the index-th set bit, then count the set bits of the following words.
+  const auto sample_iter = std::upper_bound(_bitmap_ranks.cbegin(), _bitmap_ranks.cend(), index) - 1;
+  auto word_index = static_cast<size_t>(sample_iter - _bitmap_ranks.cbegin()) * RANK_SAMPLE_WORDS;
+  auto remaining = index - *sample_iter;
+  while (true) {
+    const auto word_popcount = static_cast<size_t>(std::popcount(_bitmap[word_index]));
+    if (remaining < word_popcount) break;
+    remaining -= word_popcount;
+    ++word_index;
+  }
+
+  auto word = _bitmap[word_index];
+  for (; remaining > 0; --remaining) {
+    word &= word - 1;
+  }
+  return static_cast<ChunkOffset>(word_index * 64 + std::countr_zero(word));
+}
+
+}  // namespace opossum
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <vector>
+
+#include <boost/iterator/iterator_facade.hpp>
+
+#include "types.hpp"
+
+namespace opossum {
+
+// A list of positions, e.g., the rows that a ReferenceSegment points to. Operators often create positions that all
+// point to the same chunk, e.g., the TableScan for each input chunk. Such a PosList stores the common ChunkID once and
+// only a ChunkOffset per position, which halves its size. Consumers can check references_single_chunk() and read the
+// chunk_offsets() directly instead of the RowIDs.
+//
+// If a large share of the rows of a chunk is included, e.g., after a scan with a broad predicate, a bitmap with one
+// bit per row of the chunk is even smaller. Its positions are the set bits in ascending order. Consumers can combine
+// the bitmap() with other bitmaps directly. Accessing a single position has to find the index-th set bit, which is
+// supported by the number of set bits before every RANK_SAMPLE_WORDS-th word of the bitmap.
+class PosList {
+ public:
+  // Returns the RowIDs by value because a single-chunk PosList does not store them.
+  class ConstIterator
+      : public boost::iterator_facade<ConstIterator, RowID, std::random_access_iterator_tag, RowID, std::ptrdiff_t> {
+   public:
+    ConstIterator(const PosList& pos_list, const size_t index) : _pos_list{&pos_list}, _index{index} {}
+
+   private:
+    friend class boost::iterator_core_access;
+
+    RowID dereference() const { return (*_pos_list)[_index]; }
+    void increment() { ++_index; }
+    void decrement() { --_index; }
+    void advance(const std::ptrdiff_t distance) { _index += distance; }
+    bool equal(const ConstIterator& other) const { return _index == other._index; }
+    std::ptrdiff_t distance_to(const ConstIterator& other) const {
+      return static_cast<std::ptrdiff_t>(other._index) - static_cast<std::ptrdiff_t>(_index);
+    }
+
+    const PosList* _pos_list;
+    size_t _index;
+  };
+
+  // Creates an empty PosList that may point to any chunks.
+  PosList() = default;
+
+  PosList(std::initializer_list<RowID> row_ids);
+
+  explicit PosList(std::vector<RowID> row_ids);
+
+  // Creates a PosList whose positions all point to the given chunk.
+  PosList(const ChunkID chunk_id, std::vector<ChunkOffset> chunk_offsets);
+
+  // Creates a PosList whose positions are the set bits of the bitmap (see compare_to_bitmask for the layout).
+  PosList(const ChunkID chunk_id, std::vector<uint64_t> bitmap);
+
+  RowID operator[](const size_t index) const {
+    switch (_representation) {
+      case Representation::RowIDs:
+        return _row_ids[index];
+      case Representation::ChunkOffsets:
+        return RowID{_common_chunk_id, _chunk_offsets[index]};
+      case Representation::Bitmap:
+        return RowID{_common_chunk_id, _bitmap_select(index)};
+    }
+    return RowID{};
+  }
+
+  size_t size() const;
+  bool empty() const;
+  void reserve(const size_t capacity);
+
+  // Appends a position. If the position points to another chunk than a single-chunk PosList, the PosList stores the
+  // RowIDs of all its positions from then on. A bitmap turns into a list of chunk offsets unless the position follows
+  // its last set bit.
+  void emplace_back(const RowID& row_id);
+
+  // Returns true if all positions are guaranteed to point to common_chunk_id(), i.e., for chunk offsets and bitmaps. A
+  // PosList created from RowIDs returns false, even if its positions happen to point to the same chunk.
+  bool references_single_chunk() const;
+  bool is_bitmap() const;
+
+  // Only for single-chunk PosLists.
+  ChunkID common_chunk_id() const;
+
+  // Returns the chunk offsets of a single-chunk PosList, which are decoded from the bitmap if necessary.
+  std::vector<ChunkOffset> materialize_chunk_offsets() const;
+
+  // Only for single-chunk PosLists that are not bitmaps.
+  const std::vector<ChunkOffset>& chunk_offsets() const;
+
+  // Only for bitmaps.
+  const std::vector<uint64_t>& bitmap() const;
+
+  // Only for PosLists that are not single-chunk.
+  const std::vector<RowID>& row_ids() const;
+
+  ConstIterator begin() const;
+  ConstIterator end() const;
+
+  size_t memory_usage() const;
+
+  bool operator==(const PosList& other) const;
+
+ protected:
+  enum class Representation { RowIDs, ChunkOffsets, Bitmap };
+
+  static constexpr auto RANK_SAMPLE_WORDS = size_t{8};
+
+  ChunkOffset _bitmap_select(const size_t index) const;
+
+  Representation _representation{Representation::RowIDs};
+  ChunkID _common_chunk_id{0};
+  std::vector<ChunkOffset> _chunk_offsets;
+  std::vector<RowID> _row_ids;
+  std::vector<uint64_t> _bitmap;
+  // The number of set bits before each RANK_SAMPLE_WORDS-th word of the bitmap.
+  std::vector<ChunkOffset> _bitmap_ranks;
+  size_t _bitmap_size{0};
+};
+
+}  // namespace opossum
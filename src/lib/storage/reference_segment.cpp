@@ -7,6 +7,7 @@
 
 #include "abstract_segment.hpp"
 #include "dictionary_segment.hpp"
+#include "pos_list.hpp"
 #include "reference_segment.hpp"
 #include "table.hpp"
 #include "types.hpp"
@@ -22,7 +23,7 @@ ReferenceSegment::ReferenceSegment(const std::shared_ptr<const Table>& reference
 AllTypeVariant ReferenceSegment::operator[](const ChunkOffset chunk_offset) const {
   DebugAssert(chunk_offset < size(), "invalid chunk offset " + std::to_string(chunk_offset) +
                                          " for reference segment with " + std::to_string(size()) + " rows");
-  auto& row_id = (*_pos)[chunk_offset];
+  const auto row_id = (*_pos)[chunk_offset];
   auto segment = _referenced_table->get_chunk(row_id.chunk_id)->get_segment(_referenced_column_id);
   return (*segment)[row_id.chunk_offset];
 }
@@ -37,6 +38,6 @@ const std::shared_ptr<const Table> ReferenceSegment::referenced_table() const {
 
 ColumnID ReferenceSegment::referenced_column_id() const { return _referenced_column_id; }
 
-size_t ReferenceSegment::estimate_memory_usage() const { return sizeof(RowID) * pos_list()->capacity(); }
+size_t ReferenceSegment::estimate_memory_usage() const { return pos_list()->memory_usage(); }
 
 }  // namespace opossum
@@ -9,6 +9,7 @@
 
 #include "abstract_segment.hpp"
 #include "dictionary_segment.hpp"
+#include "pos_list.hpp"
 #include "table.hpp"
 #include "types.hpp"
 #include "utils/assert.hpp"
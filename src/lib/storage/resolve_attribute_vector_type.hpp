@@ -0,0 +1,40 @@
+#pragma once
+
+#include "abstract_attribute_vector.hpp"
+#include "bit_packed_vector.hpp"
+#include "fixed_width_integer_vector.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+/**
+ * Resolves the concrete type of an attribute vector and passes the typed vector on to a generic lambda. This is the
+ * standard way for operators and segment iterators to read value ids: the type is resolved once, and the loop in the
+ * lambda is compiled for each vector type without any virtual calls. The lambda is instantiated for all vector types,
+ * so type-specific code has to be guarded with if constexpr.
+ *
+ * Example:
+ *
+ *   resolve_attribute_vector_type(*segment->attribute_vector(), [&](const auto& attribute_vector) {
+ *     using AttributeVectorType = std::decay_t<decltype(attribute_vector)>;
+ *     for (auto index = size_t{0}; index < attribute_vector.size(); ++index) {
+ *       process_value_id(attribute_vector[index]);
+ *     }
+ *   });
+ */
+template <typename Functor>
+void resolve_attribute_vector_type(const AbstractAttributeVector& attribute_vector, const Functor& func) {
+  if (const auto* vector_8 = dynamic_cast<const FixedWidthIntegerVector<uint8_t>*>(&attribute_vector)) {
+    func(*vector_8);
+  } else if (const auto* vector_16 = dynamic_cast<const FixedWidthIntegerVector<uint16_t>*>(&attribute_vector)) {
+    func(*vector_16);
+  } else if (const auto* vector_32 = dynamic_cast<const FixedWidthIntegerVector<uint32_t>*>(&attribute_vector)) {
+    func(*vector_32);
+  } else if (const auto* bit_packed_vector = dynamic_cast<const BitPackedVector*>(&attribute_vector)) {
+    func(*bit_packed_vector);
+  } else {
+    Fail("Unknown attribute vector type");
+  }
+}
+
+}  // namespace opossum
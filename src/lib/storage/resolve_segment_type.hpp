@@ -0,0 +1,57 @@
+#pragma once
+
+#include <string>
+#include <type_traits>
+
+#include "abstract_segment.hpp"
+#include "dictionary_segment.hpp"
+#include "frame_of_reference_segment.hpp"
+#include "front_coded_dictionary_segment.hpp"
+#include "reference_segment.hpp"
+#include "run_length_segment.hpp"
+#include "utils/assert.hpp"
+#include "value_segment.hpp"
+
+namespace opossum {
+
+/**
+ * Resolves the concrete type of a segment with the data type T and passes the typed segment on to a generic lambda.
+ * Like resolve_attribute_vector_type, this replaces the dynamic_pointer_cast cascades in operators. The lambda is
+ * instantiated for all segment types that exist for T, i.e., FrameOfReferenceSegment only for integral types and
+ * FrontCodedDictionarySegment only for strings.
+ *
+ * Example:
+ *
+ *   resolve_segment_type<T>(*segment, [&](const auto& typed_segment) {
+ *     using SegmentType = std::decay_t<decltype(typed_segment)>;
+ *     if constexpr (std::is_same_v<SegmentType, ReferenceSegment>) { ... }
+ *   });
+ */
+template <typename T, typename Functor>
+void resolve_segment_type(const AbstractSegment& segment, const Functor& func) {
+  if (const auto* value_segment = dynamic_cast<const ValueSegment<T>*>(&segment)) {
+    func(*value_segment);
+  } else if (const auto* dictionary_segment = dynamic_cast<const DictionarySegment<T>*>(&segment)) {
+    func(*dictionary_segment);
+  } else if (const auto* run_length_segment = dynamic_cast<const RunLengthSegment<T>*>(&segment)) {
+    func(*run_length_segment);
+  } else if (const auto* reference_segment = dynamic_cast<const ReferenceSegment*>(&segment)) {
+    func(*reference_segment);
+  } else {
+    if constexpr (std::is_integral_v<T>) {
+      if (const auto* for_segment = dynamic_cast<const FrameOfReferenceSegment<T>*>(&segment)) {
+        func(*for_segment);
+        return;
+      }
+    }
+    if constexpr (std::is_same_v<T, std::string>) {
+      if (const auto* front_coded_segment = dynamic_cast<const FrontCodedDictionarySegment<T>*>(&segment)) {
+        func(*front_coded_segment);
+        return;
+      }
+    }
+    Fail("Unknown segment type");
+  }
+}
+
+}  // namespace opossum
@@ -0,0 +1,83 @@
+#include "run_length_segment.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "type_cast.hpp"
+#include "utils/assert.hpp"
+#include "value_segment.hpp"
+
+namespace opossum {
+
+template <typename T>
+RunLengthSegment<T>::RunLengthSegment(const std::shared_ptr<AbstractSegment>& abstract_segment) {
+  const auto append_value = [&](const T& value, const ChunkOffset chunk_offset) {
+    if (!_values.empty() && _values.back() == value) {
+      _end_positions.back() = chunk_offset;
+    } else {
+      _values.push_back(value);
+      _end_positions.push_back(chunk_offset);
+    }
+  };
+
+  // read typed values directly from value segments and fall back to the generic interface otherwise.
+  const auto segment_size = abstract_segment->size();
+  if (const auto value_segment = std::dynamic_pointer_cast<const ValueSegment<T>>(abstract_segment)) {
+    const auto& values = value_segment->values();
+    for (auto chunk_offset = ChunkOffset{0}; chunk_offset < segment_size; ++chunk_offset) {
+      append_value(values[chunk_offset], chunk_offset);
+    }
+  } else {
+    for (auto chunk_offset = ChunkOffset{0}; chunk_offset < segment_size; ++chunk_offset) {
+      append_value(type_cast<T>((*abstract_segment)[chunk_offset]), chunk_offset);
+    }
+  }
+
+  _values.shrink_to_fit();
+  _end_positions.shrink_to_fit();
+}
+
+template <typename T>
+AllTypeVariant RunLengthSegment<T>::operator[](const ChunkOffset chunk_offset) const {
+  return AllTypeVariant{get(chunk_offset)};
+}
+
+template <typename T>
+T RunLengthSegment<T>::get(const ChunkOffset chunk_offset) const {
+  Assert(chunk_offset < size(), "chunk offset " + std::to_string(chunk_offset) +
+                                    " out of bounds for RunLengthSegment with size " + std::to_string(size()));
+  // the run that contains chunk_offset is the first one that ends at or after it.
+  const auto run_iter = std::lower_bound(_end_positions.cbegin(), _end_positions.cend(), chunk_offset);
+  return _values[std::distance(_end_positions.cbegin(), run_iter)];
+}
+
+template <typename T>
+void RunLengthSegment<T>::append(const AllTypeVariant& value) {
+  Fail("Run-length segments are immutable, i.e., values cannot be appended.");
+}
+
+template <typename T>
+const std::vector<T>& RunLengthSegment<T>::values() const {
+  return _values;
+}
+
+template <typename T>
+const std::vector<ChunkOffset>& RunLengthSegment<T>::end_positions() const {
+  return _end_positions;
+}
+
+template <typename T>
+ChunkOffset RunLengthSegment<T>::size() const {
+  return _end_positions.empty() ? ChunkOffset{0} : _end_positions.back() + 1;
+}
+
+template <typename T>
+size_t RunLengthSegment<T>::estimate_memory_usage() const {
+  return sizeof(T) * _values.size() + sizeof(ChunkOffset) * _end_positions.size();
+}
+
+EXPLICITLY_INSTANTIATE_DATA_TYPES(RunLengthSegment);
+
+}  // namespace opossum
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "abstract_segment.hpp"
+#include "all_type_variant.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+// RunLengthSegment is a specific segment type that stores runs of identical values only once. For each run, it stores
+// the value and the chunk offset of the last row of the run. This pays off for columns that consist of long runs, e.g.,
+// status flags or dates that were loaded in order.
+template <typename T>
+class RunLengthSegment : public AbstractSegment {
+ public:
+  // Creates a run-length encoded segment from a given value segment.
+  explicit RunLengthSegment(const std::shared_ptr<AbstractSegment>& abstract_segment);
+
+  // Return the value at a certain position. If you want to write efficient operators, back off!
+  AllTypeVariant operator[](const ChunkOffset chunk_offset) const override;
+
+  // Return the value at a certain position. This requires a binary search over the runs.
+  T get(const ChunkOffset chunk_offset) const;
+
+  // Run-length segments are immutable.
+  void append(const AllTypeVariant& value) override;
+
+  // Returns the value of each run.
+  const std::vector<T>& values() const;
+
+  // Returns the chunk offset of the last row of each run. The offsets are sorted, and the last one is size() - 1.
+  const std::vector<ChunkOffset>& end_positions() const;
+
+  // Return the number of entries.
+  ChunkOffset size() const override;
+
+  // Returns the calculated memory usage.
+  size_t estimate_memory_usage() const final;
+
+ protected:
+  std::vector<T> _values{};
+  std::vector<ChunkOffset> _end_positions{};
+};
+
+}  // namespace opossum
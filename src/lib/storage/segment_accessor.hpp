@@ -0,0 +1,114 @@
+#pragma once
+
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "abstract_segment.hpp"
+#include "dictionary_segment.hpp"
+#include "reference_segment.hpp"
+#include "resolve_attribute_vector_type.hpp"
+#include "resolve_segment_type.hpp"
+#include "types.hpp"
+#include "utils/assert.hpp"
+#include "value_segment.hpp"
+
+namespace opossum {
+
+// Reads single values of a segment whose type was resolved when the accessor was created. Reference segments use
+// accessors to read the rows they point to: Each access costs one virtual call, but no dynamic casts or
+// AllTypeVariants.
+template <typename T>
+class AbstractSegmentAccessor {
+ public:
+  virtual ~AbstractSegmentAccessor() = default;
+
+  virtual T access(const ChunkOffset chunk_offset) const = 0;
+};
+
+// Accessor for segment types that provide a typed get(), e.g., RunLengthSegment or FrameOfReferenceSegment.
+template <typename T, typename SegmentType>
+class SegmentAccessor final : public AbstractSegmentAccessor<T> {
+ public:
+  explicit SegmentAccessor(const SegmentType& segment) : _segment{segment} {}
+
+  T access(const ChunkOffset chunk_offset) const final { return _segment.get(chunk_offset); }
+
+ protected:
+  const SegmentType& _segment;
+};
+
+template <typename T>
+class SegmentAccessor<T, ValueSegment<T>> final : public AbstractSegmentAccessor<T> {
+ public:
+  explicit SegmentAccessor(const ValueSegment<T>& segment) : _values{segment.values()} {}
+
+  T access(const ChunkOffset chunk_offset) const final { return _values[chunk_offset]; }
+
+ protected:
+  const std::vector<T>& _values;
+};
+
+// Reads the value id from the attribute vector of the resolved type without a virtual call.
+template <typename T, typename AttributeVectorType>
+class DictionarySegmentAccessor final : public AbstractSegmentAccessor<T> {
+ public:
+  DictionarySegmentAccessor(const DictionarySegment<T>& segment, const AttributeVectorType& attribute_vector)
+      : _dictionary{segment.dictionary()}, _attribute_vector{attribute_vector} {}
+
+  T access(const ChunkOffset chunk_offset) const final { return _dictionary[_attribute_vector[chunk_offset]]; }
+
+ protected:
+  const std::vector<T>& _dictionary;
+  const AttributeVectorType& _attribute_vector;
+};
+
+// Creates an accessor for a segment that is not a reference segment. The segment must outlive the accessor.
+template <typename T>
+std::unique_ptr<AbstractSegmentAccessor<T>> create_segment_accessor(const AbstractSegment& segment) {
+  auto accessor = std::unique_ptr<AbstractSegmentAccessor<T>>{};
+  resolve_segment_type<T>(segment, [&](const auto& typed_segment) {
+    using SegmentType = std::decay_t<decltype(typed_segment)>;
+    if constexpr (std::is_same_v<SegmentType, ReferenceSegment>) {
+      Fail("Reference segments cannot be accessed through an accessor");
+    } else if constexpr (std::is_same_v<SegmentType, DictionarySegment<T>>) {
+      resolve_attribute_vector_type(*typed_segment.attribute_vector(), [&](const auto& attribute_vector) {
+        using AttributeVectorType = std::decay_t<decltype(attribute_vector)>;
+        accessor = std::make_unique<DictionarySegmentAccessor<T, AttributeVectorType>>(typed_segment, attribute_vector);
+      });
+    } else {
+      accessor = std::make_unique<SegmentAccessor<T, SegmentType>>(typed_segment);
+    }
+  });
+  return accessor;
+}
+
+// Creates the accessors for the segments that a reference segment points to, one per referenced chunk. They are only
+// created when a chunk is first accessed. The referenced segments are kept alive, even if their chunk is replaced in
+// the meantime, e.g., by Table::compress_chunk.
+template <typename T>
+class ReferencedSegmentAccessors : private Noncopyable {
+ public:
+  explicit ReferencedSegmentAccessors(const ReferenceSegment& segment)
+      : _referenced_table{segment.referenced_table()},
+        _referenced_column_id{segment.referenced_column_id()},
+        _segments(_referenced_table->chunk_count()),
+        _accessors(_referenced_table->chunk_count()) {}
+
+  const AbstractSegmentAccessor<T>& get(const ChunkID chunk_id) {
+    auto& accessor = _accessors[chunk_id];
+    if (!accessor) {
+      _segments[chunk_id] = _referenced_table->get_chunk(chunk_id)->get_segment(_referenced_column_id);
+      accessor = create_segment_accessor<T>(*_segments[chunk_id]);
+    }
+    return *accessor;
+  }
+
+ protected:
+  const std::shared_ptr<const Table> _referenced_table;
+  const ColumnID _referenced_column_id;
+  std::vector<std::shared_ptr<const AbstractSegment>> _segments;
+  std::vector<std::unique_ptr<AbstractSegmentAccessor<T>>> _accessors;
+};
+
+}  // namespace opossum
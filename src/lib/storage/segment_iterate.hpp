@@ -0,0 +1,333 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <boost/iterator/iterator_facade.hpp>
+
+#include "abstract_attribute_vector.hpp"
+#include "abstract_segment.hpp"
+#include "resolve_attribute_vector_type.hpp"
+#include "resolve_segment_type.hpp"
+#include "segment_accessor.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+// A value of a segment together with its offset in the segment. Iterators over segments that hold their values in a
+// vector (value, dictionary, and run-length segments) use const T& as ValueType and do not copy the value. The other
+// iterators compute the value and store it in the position.
+template <typename ValueType>
+class SegmentPosition {
+ public:
+  SegmentPosition(ValueType value, const ChunkOffset chunk_offset)
+      : _value{std::forward<ValueType>(value)}, _chunk_offset{chunk_offset} {}
+
+  const std::decay_t<ValueType>& value() const { return _value; }
+  ChunkOffset chunk_offset() const { return _chunk_offset; }
+
+ private:
+  ValueType _value;
+  ChunkOffset _chunk_offset;
+};
+
+// Base class of all segment iterators. The iterators are random access iterators that return a SegmentPosition by
+// value. All their methods are defined in this header and are not virtual, so that the compiler can inline them into
+// the loops of operators. By default, an iterator is moved by changing its chunk offset.
+template <typename Derived, typename ValueType>
+class BaseSegmentIterator : public boost::iterator_facade<Derived, SegmentPosition<ValueType>,
+                                                          std::random_access_iterator_tag, SegmentPosition<ValueType>> {
+ public:
+  explicit BaseSegmentIterator(const ChunkOffset chunk_offset) : _chunk_offset{chunk_offset} {}
+
+ protected:
+  friend class boost::iterator_core_access;
+
+  void increment() { ++_chunk_offset; }
+  void decrement() { --_chunk_offset; }
+  void advance(const std::ptrdiff_t distance) { _chunk_offset = static_cast<ChunkOffset>(_chunk_offset + distance); }
+  bool equal(const Derived& other) const { return _chunk_offset == other._chunk_offset; }
+  std::ptrdiff_t distance_to(const Derived& other) const {
+    return static_cast<std::ptrdiff_t>(other._chunk_offset) - static_cast<std::ptrdiff_t>(_chunk_offset);
+  }
+
+  ChunkOffset _chunk_offset;
+};
+
+template <typename T>
+class ValueSegmentIterator : public BaseSegmentIterator<ValueSegmentIterator<T>, const T&> {
+ public:
+  ValueSegmentIterator(const T* values, const ChunkOffset chunk_offset)
+      : BaseSegmentIterator<ValueSegmentIterator<T>, const T&>{chunk_offset}, _values{values} {}
+
+ private:
+  friend class boost::iterator_core_access;
+
+  SegmentPosition<const T&> dereference() const { return {_values[this->_chunk_offset], this->_chunk_offset}; }
+
+  const T* _values;
+};
+
+// Iterates over a dictionary and an attribute vector whose type has been resolved.
+template <typename T, typename AttributeVectorType>
+class DictionarySegmentIterator
+    : public BaseSegmentIterator<DictionarySegmentIterator<T, AttributeVectorType>, const T&> {
+ public:
+  DictionarySegmentIterator(const T* dictionary, const AttributeVectorType& attribute_vector,
+                            const ChunkOffset chunk_offset)
+      : BaseSegmentIterator<DictionarySegmentIterator<T, AttributeVectorType>, const T&>{chunk_offset},
+        _dictionary{dictionary},
+        _attribute_vector{&attribute_vector} {}
+
+ private:
+  friend class boost::iterator_core_access;
+
+  SegmentPosition<const T&> dereference() const {
+    return {_dictionary[(*_attribute_vector)[this->_chunk_offset]], this->_chunk_offset};
+  }
+
+  const T* _dictionary;
+  const AttributeVectorType* _attribute_vector;
+};
+
+// Iterates over the value ids of an attribute vector whose type has been resolved.
+template <typename AttributeVectorType>
+class AttributeVectorIterator : public BaseSegmentIterator<AttributeVectorIterator<AttributeVectorType>, ValueID> {
+ public:
+  AttributeVectorIterator(const AttributeVectorType& attribute_vector, const ChunkOffset chunk_offset)
+      : BaseSegmentIterator<AttributeVectorIterator<AttributeVectorType>, ValueID>{chunk_offset},
+        _attribute_vector{&attribute_vector} {}
+
+ private:
+  friend class boost::iterator_core_access;
+
+  SegmentPosition<ValueID> dereference() const {
+    return {(*_attribute_vector)[this->_chunk_offset], this->_chunk_offset};
+  }
+
+  const AttributeVectorType* _attribute_vector;
+};
+
+// Keeps track of the current run, so that moving to the next value does not require a binary search.
+template <typename T>
+class RunLengthSegmentIterator : public BaseSegmentIterator<RunLengthSegmentIterator<T>, const T&> {
+ public:
+  RunLengthSegmentIterator(const RunLengthSegment<T>& segment, const ChunkOffset chunk_offset)
+      : BaseSegmentIterator<RunLengthSegmentIterator<T>, const T&>{chunk_offset},
+        _values{segment.values().data()},
+        _end_positions{segment.end_positions().data()},
+        _run_count{segment.end_positions().size()} {
+    _find_run();
+  }
+
+ private:
+  friend class boost::iterator_core_access;
+
+  SegmentPosition<const T&> dereference() const { return {_values[_run_index], this->_chunk_offset}; }
+
+  void increment() {
+    ++this->_chunk_offset;
+    if (this->_chunk_offset > _end_positions[_run_index]) ++_run_index;
+  }
+
+  void decrement() {
+    --this->_chunk_offset;
+    if (_run_index > 0 && this->_chunk_offset <= _end_positions[_run_index - 1]) --_run_index;
+  }
+
+  void advance(const std::ptrdiff_t distance) {
+    this->_chunk_offset = static_cast<ChunkOffset>(this->_chunk_offset + distance);
+    _find_run();
+  }
+
+  // The run of an offset is the first one that ends at or after the offset. For the end iterator, this is _run_count.
+  void _find_run() {
+    const auto* run_end = std::lower_bound(_end_positions, _end_positions + _run_count, this->_chunk_offset);
+    _run_index = static_cast<size_t>(run_end - _end_positions);
+  }
+
+  const T* _values;
+  const ChunkOffset* _end_positions;
+  size_t _run_count;
+  size_t _run_index{0};
+};
+
+// The values of a frame-of-reference block are unpacked together, which is much cheaper than unpacking them one by
+// one, especially for delta-encoded blocks. Iterators created by the same segment_with_iterators call share the
+// buffer of the last decoded block.
+template <typename T>
+class FrameOfReferenceSegmentIterator : public BaseSegmentIterator<FrameOfReferenceSegmentIterator<T>, T> {
+ public:
+  struct DecodedBlock {
+    size_t block_index{std::numeric_limits<size_t>::max()};
+    std::vector<T> values = std::vector<T>(FrameOfReferenceSegment<T>::BLOCK_SIZE);
+  };
+
+  FrameOfReferenceSegmentIterator(const FrameOfReferenceSegment<T>& segment, DecodedBlock& decoded_block,
+                                  const ChunkOffset chunk_offset)
+      : BaseSegmentIterator<FrameOfReferenceSegmentIterator<T>, T>{chunk_offset},
+        _segment{&segment},
+        _decoded_block{&decoded_block} {}
+
+ private:
+  friend class boost::iterator_core_access;
+
+  SegmentPosition<T> dereference() const {
+    constexpr auto BLOCK_SIZE = FrameOfReferenceSegment<T>::BLOCK_SIZE;
+    const auto block_index = this->_chunk_offset / BLOCK_SIZE;
+    if (_decoded_block->block_index != block_index) {
+      _segment->decode_block(block_index, _decoded_block->values.data());
+      _decoded_block->block_index = block_index;
+    }
+    return {_decoded_block->values[this->_chunk_offset % BLOCK_SIZE], this->_chunk_offset};
+  }
+
+  const FrameOfReferenceSegment<T>* _segment;
+  DecodedBlock* _decoded_block;
+};
+
+// Reads the referenced values through one accessor per referenced chunk. The chunk offsets of the positions are
+// those of the reference segment, not those of the referenced segments.
+template <typename T>
+class ReferenceSegmentIterator : public BaseSegmentIterator<ReferenceSegmentIterator<T>, T> {
+ public:
+  ReferenceSegmentIterator(const RowID* row_ids, ReferencedSegmentAccessors<T>& accessors,
+                           const ChunkOffset chunk_offset)
+      : BaseSegmentIterator<ReferenceSegmentIterator<T>, T>{chunk_offset}, _row_ids{row_ids}, _accessors{&accessors} {}
+
+ private:
+  friend class boost::iterator_core_access;
+
+  SegmentPosition<T> dereference() const {
+    const auto& row_id = _row_ids[this->_chunk_offset];
+    return {_accessors->get(row_id.chunk_id).access(row_id.chunk_offset), this->_chunk_offset};
+  }
+
+  const RowID* _row_ids;
+  ReferencedSegmentAccessors<T>* _accessors;
+};
+
+// Reads the values of a reference segment whose positions all point to the same chunk through a single accessor.
+template <typename T>
+class SingleChunkReferenceSegmentIterator : public BaseSegmentIterator<SingleChunkReferenceSegmentIterator<T>, T> {
+ public:
+  SingleChunkReferenceSegmentIterator(const ChunkOffset* referenced_chunk_offsets,
+                                      const AbstractSegmentAccessor<T>& accessor, const ChunkOffset chunk_offset)
+      : BaseSegmentIterator<SingleChunkReferenceSegmentIterator<T>, T>{chunk_offset},
+        _referenced_chunk_offsets{referenced_chunk_offsets},
+        _accessor{&accessor} {}
+
+ private:
+  friend class boost::iterator_core_access;
+
+  SegmentPosition<T> dereference() const {
+    return {_accessor->access(_referenced_chunk_offsets[this->_chunk_offset]), this->_chunk_offset};
+  }
+
+  const ChunkOffset* _referenced_chunk_offsets;
+  const AbstractSegmentAccessor<T>* _accessor;
+};
+
+/**
+ * Calls functor(begin, end) with iterators over the values of a segment with the data type T. The segment can be
+ * passed as an AbstractSegment, in which case its type is resolved once, or as a concrete segment type, which only
+ * instantiates the functor for that type. The functor is a generic lambda that is instantiated for each iterator
+ * type, so that it does not need to know the encoding of the segment and still runs without virtual calls per value
+ * (except for reference segments, which need one per value).
+ *
+ * The iterators are only valid during the call of the functor.
+ *
+ * Example:
+ *
+ *   segment_with_iterators<T>(*segment, [&](auto iterator, const auto end) {
+ *     for (; iterator != end; ++iterator) {
+ *       const auto position = *iterator;
+ *       process(position.value(), position.chunk_offset());
+ *     }
+ *   });
+ */
+template <typename T, typename SegmentType, typename Functor>
+void segment_with_iterators(const SegmentType& segment, const Functor& functor) {
+  if constexpr (std::is_same_v<SegmentType, AbstractSegment>) {
+    resolve_segment_type<T>(segment,
+                            [&](const auto& typed_segment) { segment_with_iterators<T>(typed_segment, functor); });
+  } else {
+    const auto size = segment.size();
+    if constexpr (std::is_same_v<SegmentType, ValueSegment<T>>) {
+      const auto* values = segment.values().data();
+      functor(ValueSegmentIterator<T>{values, ChunkOffset{0}}, ValueSegmentIterator<T>{values, size});
+    } else if constexpr (std::is_same_v<SegmentType, DictionarySegment<T>>) {
+      resolve_attribute_vector_type(*segment.attribute_vector(), [&](const auto& attribute_vector) {
+        using Iterator = DictionarySegmentIterator<T, std::decay_t<decltype(attribute_vector)>>;
+        const auto* dictionary = segment.dictionary().data();
+        functor(Iterator{dictionary, attribute_vector, ChunkOffset{0}}, Iterator{dictionary, attribute_vector, size});
+      });
+    } else if constexpr (std::is_same_v<SegmentType, FrontCodedDictionarySegment<T>>) {
+      // Looking up a value id decodes its block of the front-coded dictionary. The dictionary is decoded once instead,
+      // which is cheaper as soon as there are more rows than distinct values.
+      auto dictionary = std::vector<T>(segment.unique_values_count());
+      for (auto value_id = ValueID{0}; value_id < dictionary.size(); ++value_id) {
+        dictionary[value_id] = segment.value_of_value_id(value_id);
+      }
+      resolve_attribute_vector_type(*segment.attribute_vector(), [&](const auto& attribute_vector) {
+        using Iterator = DictionarySegmentIterator<T, std::decay_t<decltype(attribute_vector)>>;
+        functor(Iterator{dictionary.data(), attribute_vector, ChunkOffset{0}},
+                Iterator{dictionary.data(), attribute_vector, size});
+      });
+    } else if constexpr (std::is_same_v<SegmentType, RunLengthSegment<T>>) {
+      functor(RunLengthSegmentIterator<T>{segment, ChunkOffset{0}}, RunLengthSegmentIterator<T>{segment, size});
+    } else if constexpr (std::is_same_v<SegmentType, FrameOfReferenceSegment<T>>) {
+      auto decoded_block = typename FrameOfReferenceSegmentIterator<T>::DecodedBlock{};
+      functor(FrameOfReferenceSegmentIterator<T>{segment, decoded_block, ChunkOffset{0}},
+              FrameOfReferenceSegmentIterator<T>{segment, decoded_block, size});
+    } else if constexpr (std::is_same_v<SegmentType, ReferenceSegment>) {
+      auto accessors = ReferencedSegmentAccessors<T>{segment};
+      const auto& pos_list = *segment.pos_list();
+      if (pos_list.references_single_chunk()) {
+        // the positions of a bitmap are decoded for the duration of the call.
+        const auto bitmap_chunk_offsets =
+            pos_list.is_bitmap() ? pos_list.materialize_chunk_offsets() : std::vector<ChunkOffset>{};
+        const auto& accessor = accessors.get(pos_list.common_chunk_id());
+        const auto* chunk_offsets =
+            pos_list.is_bitmap() ? bitmap_chunk_offsets.data() : pos_list.chunk_offsets().data();
+        functor(SingleChunkReferenceSegmentIterator<T>{chunk_offsets, accessor, ChunkOffset{0}},
+                SingleChunkReferenceSegmentIterator<T>{chunk_offsets, accessor, size});
+      } else {
+        const auto* row_ids = pos_list.row_ids().data();
+        functor(ReferenceSegmentIterator<T>{row_ids, accessors, ChunkOffset{0}},
+                ReferenceSegmentIterator<T>{row_ids, accessors, size});
+      }
+    } else {
+      static_assert(!std::is_same_v<SegmentType, SegmentType>, "Unknown segment type");
+    }
+  }
+}
+
+// Calls functor(position) for each SegmentPosition of a segment, see segment_with_iterators.
+template <typename T, typename SegmentType, typename Functor>
+void segment_iterate(const SegmentType& segment, const Functor& functor) {
+  segment_with_iterators<T>(segment, [&](auto iterator, const auto end) {
+    for (; iterator != end; ++iterator) {
+      functor(*iterator);
+    }
+  });
+}
+
+// Calls functor(begin, end) with iterators over the value ids of an attribute vector, e.g., of a DictionarySegment or
+// a FrontCodedDictionarySegment. The positions hold the value ids as values.
+template <typename Functor>
+void attribute_vector_with_iterators(const AbstractAttributeVector& attribute_vector, const Functor& functor) {
+  resolve_attribute_vector_type(attribute_vector, [&](const auto& typed_attribute_vector) {
+    using Iterator = AttributeVectorIterator<std::decay_t<decltype(typed_attribute_vector)>>;
+    const auto size = static_cast<ChunkOffset>(typed_attribute_vector.size());
+    functor(Iterator{typed_attribute_vector, ChunkOffset{0}}, Iterator{typed_attribute_vector, size});
+  });
+}
+
+}  // namespace opossum
@@ -0,0 +1,133 @@
+#include "segment_statistics.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <boost/hana/for_each.hpp>
+
+#include "abstract_segment.hpp"
+#include "dictionary_segment.hpp"
+#include "frame_of_reference_segment.hpp"
+#include "front_coded_dictionary_segment.hpp"
+#include "run_length_segment.hpp"
+#include "type_cast.hpp"
+#include "utils/assert.hpp"
+#include "value_segment.hpp"
+
+namespace opossum {
+
+namespace {
+
+// Returns the statistics of unsorted values, or nullptr if there are no values or one of them is NaN.
+template <typename T>
+std::shared_ptr<const AbstractSegmentStatistics> statistics_of_values(const std::vector<T>& values,
+                                                                      const ChunkOffset row_count) {
+  if (values.empty()) return nullptr;
+  if constexpr (std::is_floating_point_v<T>) {
+    if (std::any_of(values.cbegin(), values.cend(), [](const T value) { return std::isnan(value); })) return nullptr;
+  }
+  const auto [minimum, maximum] = std::minmax_element(values.cbegin(), values.cend());
+  return std::make_shared<MinMaxStatistics<T>>(*minimum, *maximum, row_count);
+}
+
+template <typename T>
+std::shared_ptr<const AbstractSegmentStatistics> create_typed_segment_statistics(
+    const std::shared_ptr<const AbstractSegment>& segment) {
+  if (const auto value_segment = std::dynamic_pointer_cast<const ValueSegment<T>>(segment)) {
+    return statistics_of_values(value_segment->values(), value_segment->size());
+  }
+
+  // The dictionary is sorted, so its first and last entries are the minimum and maximum.
+  if (const auto dictionary_segment = std::dynamic_pointer_cast<const DictionarySegment<T>>(segment)) {
+    const auto& dictionary = dictionary_segment->dictionary();
+    if (dictionary.empty()) return nullptr;
+    if constexpr (std::is_floating_point_v<T>) {
+      if (std::isnan(dictionary.front()) || std::isnan(dictionary.back())) return nullptr;
+    }
+    return std::make_shared<MinMaxStatistics<T>>(dictionary.front(), dictionary.back(), dictionary_segment->size());
+  }
+
+  if constexpr (std::is_same_v<T, std::string>) {
+    if (const auto front_coded_segment = std::dynamic_pointer_cast<const FrontCodedDictionarySegment<T>>(segment)) {
+      const auto unique_values_count = front_coded_segment->unique_values_count();
+      if (unique_values_count == 0) return nullptr;
+      const auto max_value_id = ValueID{static_cast<ValueID::base_type>(unique_values_count - 1)};
+      return std::make_shared<MinMaxStatistics<T>>(front_coded_segment->value_of_value_id(ValueID{0}),
+                                                   front_coded_segment->value_of_value_id(max_value_id),
+                                                   front_coded_segment->size());
+    }
+  }
+
+  if (const auto run_length_segment = std::dynamic_pointer_cast<const RunLengthSegment<T>>(segment)) {
+    return statistics_of_values(run_length_segment->values(), run_length_segment->size());
+  }
+
+  // The block headers of a frame-of-reference segment already hold the minimum and maximum of each block.
+  if constexpr (std::is_integral_v<T>) {
+    if (const auto for_segment = std::dynamic_pointer_cast<const FrameOfReferenceSegment<T>>(segment)) {
+      const auto block_count = for_segment->block_count();
+      if (block_count == 0) return nullptr;
+      auto minimum = for_segment->block_minimum(0);
+      auto maximum = for_segment->block_maximum(0);
+      for (auto block_index = size_t{1}; block_index < block_count; ++block_index) {
+        minimum = std::min(minimum, for_segment->block_minimum(block_index));
+        maximum = std::max(maximum, for_segment->block_maximum(block_index));
+      }
+      return std::make_shared<MinMaxStatistics<T>>(minimum, maximum, for_segment->size());
+    }
+  }
+
+  return nullptr;
+}
+
+}  // namespace
+
+AbstractSegmentStatistics::AbstractSegmentStatistics(const ChunkOffset row_count) : _row_count{row_count} {}
+
+bool AbstractSegmentStatistics::can_prune(const ScanType scan_type, const AllTypeVariant& search_value) const {
+  return classify(scan_type, search_value) == RangeOutcome::NoRows;
+}
+
+ChunkOffset AbstractSegmentStatistics::row_count() const { return _row_count; }
+
+template <typename T>
+MinMaxStatistics<T>::MinMaxStatistics(const T& minimum, const T& maximum, const ChunkOffset row_count)
+    : AbstractSegmentStatistics{row_count}, _minimum{minimum}, _maximum{maximum} {
+  DebugAssert(!(maximum < minimum), "minimum must not be larger than maximum");
+}
+
+template <typename T>
+RangeOutcome MinMaxStatistics<T>::classify(const ScanType scan_type, const AllTypeVariant& search_value) const {
+  return classify_range(scan_type, type_cast<T>(search_value), _minimum, _maximum);
+}
+
+template <typename T>
+const T& MinMaxStatistics<T>::minimum() const {
+  return _minimum;
+}
+
+template <typename T>
+const T& MinMaxStatistics<T>::maximum() const {
+  return _maximum;
+}
+
+std::shared_ptr<const AbstractSegmentStatistics> create_segment_statistics(
+    const std::shared_ptr<const AbstractSegment>& segment) {
+  // Segments do not know their data type, so each type is tried in turn. This only happens when the statistics of a
+  // segment are computed, not per scan.
+  auto statistics = std::shared_ptr<const AbstractSegmentStatistics>{};
+  if (!segment || segment->size() == 0) return statistics;
+  hana::for_each(types, [&](const auto data_type_t) {
+    using ColumnDataType = typename decltype(data_type_t)::type;
+    if (!statistics) statistics = create_typed_segment_statistics<ColumnDataType>(segment);
+  });
+  return statistics;
+}
+
+EXPLICITLY_INSTANTIATE_DATA_TYPES(MinMaxStatistics);
+
+}  // namespace opossum
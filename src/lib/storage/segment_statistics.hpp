@@ -0,0 +1,56 @@
+#pragma once
+
+#include <memory>
+
+#include "all_type_variant.hpp"
+#include "type_comparison.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class AbstractSegment;
+
+// Statistics about the values of a single segment, also known as a zone map. Operators use them to skip whole chunks
+// that cannot contain a matching row. As there are no NULL values yet, the statistics do not hold a null count.
+class AbstractSegmentStatistics : private Noncopyable {
+ public:
+  explicit AbstractSegmentStatistics(const ChunkOffset row_count);
+  virtual ~AbstractSegmentStatistics() = default;
+
+  // Decides whether all, none, or some of the values satisfy value <scan_type> search_value.
+  virtual RangeOutcome classify(const ScanType scan_type, const AllTypeVariant& search_value) const = 0;
+
+  // Returns true if no value of the segment can satisfy the predicate.
+  bool can_prune(const ScanType scan_type, const AllTypeVariant& search_value) const;
+
+  // Returns the number of rows that the segment had when the statistics were computed.
+  ChunkOffset row_count() const;
+
+ protected:
+  const ChunkOffset _row_count;
+};
+
+// Stores the smallest and the largest value of a segment.
+template <typename T>
+class MinMaxStatistics : public AbstractSegmentStatistics {
+ public:
+  MinMaxStatistics(const T& minimum, const T& maximum, const ChunkOffset row_count);
+
+  RangeOutcome classify(const ScanType scan_type, const AllTypeVariant& search_value) const override;
+
+  const T& minimum() const;
+  const T& maximum() const;
+
+ protected:
+  const T _minimum;
+  const T _maximum;
+};
+
+// Computes the statistics of a segment. For dictionary segments, the minimum and maximum are read from the sorted
+// dictionary. Run-length and frame-of-reference segments only look at their runs or block headers, and value segments
+// are scanned once. Returns nullptr for empty segments, reference segments, and floating-point segments that contain
+// NaN, which is not ordered.
+std::shared_ptr<const AbstractSegmentStatistics> create_segment_statistics(
+    const std::shared_ptr<const AbstractSegment>& segment);
+
+}  // namespace opossum
@@ -6,19 +6,65 @@
 #include <memory>
 #include <numeric>
 #include <string>
-#include <thread>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
 #include "dictionary_segment.hpp"
+#include "frame_of_reference_segment.hpp"
+#include "front_coded_dictionary_segment.hpp"
+#include "run_length_segment.hpp"
+#include "segment_statistics.hpp"
 #include "value_segment.hpp"
 
 #include "resolve_type.hpp"
+#include "scheduler/worker_pool.hpp"
 #include "types.hpp"
 #include "utils/assert.hpp"
 
 namespace opossum {
 
+namespace {
+
+std::shared_ptr<AbstractSegment> encode_segment(const std::string& type,
+                                                const std::shared_ptr<AbstractSegment>& segment,
+                                                const SegmentEncodingSpec& segment_encoding_spec) {
+  auto encoded_segment = std::shared_ptr<AbstractSegment>{};
+  resolve_data_type(type, [&](const auto data_type_t) {
+    using ColumnDataType = typename decltype(data_type_t)::type;
+    switch (segment_encoding_spec.encoding_type) {
+      case EncodingType::Dictionary:
+        encoded_segment = std::make_shared<DictionarySegment<ColumnDataType>>(
+            segment, segment_encoding_spec.vector_compression_type);
+        return;
+      case EncodingType::RunLength:
+        encoded_segment = std::make_shared<RunLengthSegment<ColumnDataType>>(segment);
+        return;
+      case EncodingType::FrameOfReference:
+      case EncodingType::FrameOfReferenceDelta:
+        if constexpr (std::is_integral_v<ColumnDataType>) {
+          const auto use_delta_encoding = segment_encoding_spec.encoding_type == EncodingType::FrameOfReferenceDelta;
+          encoded_segment = std::make_shared<FrameOfReferenceSegment<ColumnDataType>>(segment, use_delta_encoding);
+          return;
+        } else {
+          Fail("Frame-of-reference encoding is not supported for columns of type " + type);
+        }
+      case EncodingType::FrontCodedDictionary:
+        if constexpr (std::is_same_v<ColumnDataType, std::string>) {
+          encoded_segment = std::make_shared<FrontCodedDictionarySegment<ColumnDataType>>(
+              segment, segment_encoding_spec.vector_compression_type);
+          return;
+        } else {
+          Fail("Front-coded dictionary encoding is not supported for columns of type " + type);
+        }
+    }
+    Fail("Unknown encoding type");
+  });
+  return encoded_segment;
+}
+
+}  // namespace
+
 Table::Table(const ChunkOffset target_chunk_size) : _target_chunk_size{target_chunk_size} { create_new_chunk(); }
 
 Table::Table(const std::shared_ptr<const Table> table_config, const ChunkOffset target_chunk_size)
@@ -49,7 +95,8 @@ void Table::add_column(const std::string& name, const std::string& type) {
 }
 
 void Table::add_column_definition(const std::string& name, const std::string& type) {
-  // Implementation goes here
+  _column_names.push_back(name);
+  _column_types.push_back(type);
 }
 
 void Table::append(const std::vector<AllTypeVariant>& values) {
@@ -90,36 +137,73 @@ const std::string& Table::column_name(const ColumnID column_id) const { return _
 
 const std::string& Table::column_type(const ColumnID column_id) const { return _column_types.at(column_id); }
 
+std::optional<std::pair<AllTypeVariant, AllTypeVariant>> Table::column_min_max(const ColumnID column_id) const {
+  auto min_max = std::optional<std::pair<AllTypeVariant, AllTypeVariant>>{};
+  resolve_data_type(column_type(column_id), [&](const auto data_type_t) {
+    using ColumnDataType = typename decltype(data_type_t)::type;
+    auto chunk_statistics = std::vector<std::shared_ptr<const MinMaxStatistics<ColumnDataType>>>{};
+    for (const auto& chunk : _chunks) {
+      if (chunk->size() == 0) continue;
+      chunk_statistics.push_back(
+          std::dynamic_pointer_cast<const MinMaxStatistics<ColumnDataType>>(chunk->get_statistics(column_id)));
+      if (!chunk_statistics.back()) return;
+    }
+    if (chunk_statistics.empty()) return;
+
+    auto minimum = chunk_statistics.front()->minimum();
+    auto maximum = chunk_statistics.front()->maximum();
+    for (const auto& statistics : chunk_statistics) {
+      if (statistics->minimum() < minimum) minimum = statistics->minimum();
+      if (maximum < statistics->maximum()) maximum = statistics->maximum();
+    }
+    min_max.emplace(minimum, maximum);
+  });
+  return min_max;
+}
+
 std::shared_ptr<Chunk> Table::get_chunk(ChunkID chunk_id) { return _chunks.at(chunk_id); }
 
 std::shared_ptr<const Chunk> Table::get_chunk(ChunkID chunk_id) const { return _chunks.at(chunk_id); }
 
-void Table::compress_chunk(const ChunkID chunk_id) {
+void Table::compress_chunk(const ChunkID chunk_id, const ChunkEncodingSpec& chunk_encoding_spec) {
   DebugAssert(chunk_id < chunk_count(), "invalid chunk id " + std::to_string(chunk_id) + ". table only has " +
                                             std::to_string(chunk_count()) + " chunks");
 
   auto old_chunk = get_chunk(chunk_id);
   auto n_segments = old_chunk->column_count();
+  Assert(chunk_encoding_spec.empty() || chunk_encoding_spec.size() == n_segments,
+         "chunk encoding spec has " + std::to_string(chunk_encoding_spec.size()) + " entries, but the table has " +
+             std::to_string(n_segments) + " columns");
+  // the segments are encoded in parallel on the worker pool, so invalid encodings are rejected here.
+  for (auto column_id = ColumnID{0}; column_id < chunk_encoding_spec.size(); ++column_id) {
+    const auto encoding_type = chunk_encoding_spec[column_id].encoding_type;
+    resolve_data_type(column_type(column_id), [&](const auto data_type_t) {
+      using ColumnDataType = typename decltype(data_type_t)::type;
+      if (encoding_type == EncodingType::FrameOfReference || encoding_type == EncodingType::FrameOfReferenceDelta) {
+        Assert(std::is_integral_v<ColumnDataType>,
+               "Frame-of-reference encoding is not supported for columns of type " + column_type(column_id));
+      }
+      if (encoding_type == EncodingType::FrontCodedDictionary) {
+        Assert((std::is_same_v<ColumnDataType, std::string>),
+               "Front-coded dictionary encoding is not supported for columns of type " + column_type(column_id));
+      }
+    });
+  }
   auto new_chunk = std::make_shared<Chunk>(ColumnID{n_segments});
 
-  auto compression_worker_lambda = [this, &old_chunk, &new_chunk](const ColumnID column_id) {
+  auto compression_worker_lambda = [this, &old_chunk, &new_chunk, &chunk_encoding_spec](const ColumnID column_id) {
     const auto& segment = old_chunk->get_segment(column_id);
     const auto& type = this->column_type(column_id);
-    resolve_data_type(type, [&](const auto data_type_t) {
-      using ColumnDataType = typename decltype(data_type_t)::type;
-      const auto dictionary_segment = std::make_shared<DictionarySegment<ColumnDataType>>(segment);
-      new_chunk->insert_segment_at(dictionary_segment, column_id);
-    });
+    const auto segment_encoding_spec =
+        chunk_encoding_spec.empty() ? SegmentEncodingSpec{} : chunk_encoding_spec[column_id];
+    new_chunk->insert_segment_at(encode_segment(type, segment, segment_encoding_spec), column_id);
+    // the zone map is cheap to derive from the encoded segment, e.g., from the sorted dictionary.
+    new_chunk->get_statistics(column_id);
   };
 
-  auto threads = std::vector<std::thread>();
-  for (auto column_index = ColumnID{0}; column_index < n_segments; ++column_index) {
-    auto worker = std::thread(compression_worker_lambda, column_index);
-    threads.emplace_back(std::move(worker));
-  }
-  for (auto& thread : threads) {
-    thread.join();
-  }
+  WorkerPool::get().parallel_for(n_segments, [&](const size_t column_index) {
+    compression_worker_lambda(static_cast<ColumnID>(column_index));
+  });
 
   // swap in new dict encoded chunk
   // TODO(all): consider concurrent accesses when exchanging the chunk?
@@ -4,6 +4,7 @@
 #include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -57,6 +58,12 @@ class Table : private Noncopyable {
   // Returns the column type of the nth column.
   const std::string& column_type(const ColumnID column_id) const;
 
+  // Returns the smallest and the largest value of a column. The values are combined from the statistics of the chunks
+  // (see Chunk::get_statistics), so only dictionary and other encoded chunks are answered without scanning their rows.
+  // Value segments are scanned on first use and again whenever they have grown. Returns std::nullopt if the table is
+  // empty or a chunk has no statistics, e.g., for reference segments.
+  std::optional<std::pair<AllTypeVariant, AllTypeVariant>> column_min_max(const ColumnID column_id) const;
+
   // Returns the column with the given name. This method is intended for debugging purposes only. It does not verify
   // whether a column name is unambiguous.
   ColumnID column_id_by_name(const std::string& column_name) const;
@@ -79,8 +86,9 @@ class Table : private Noncopyable {
   // Creates a new chunk and appends it.
   void create_new_chunk();
 
-  // Compresses a ValueColumn into a DictionaryColumn.
-  void compress_chunk(const ChunkID chunk_id);
+  // Compresses the segments of a chunk. By default, all segments are dictionary-encoded. Otherwise, the encoding
+  // spec must contain one entry per column.
+  void compress_chunk(const ChunkID chunk_id, const ChunkEncodingSpec& chunk_encoding_spec = {});
 
  protected:
   ChunkOffset _target_chunk_size = 60000;
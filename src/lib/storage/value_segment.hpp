@@ -13,6 +13,11 @@ namespace opossum {
 template <typename T>
 class ValueSegment : public AbstractSegment {
  public:
+  ValueSegment() = default;
+
+  // Creates a segment that holds the given values.
+  explicit ValueSegment(std::vector<T>&& values);
+
   // Return the value at a certain position. If you want to write efficient operators, back off!
   AllTypeVariant operator[](const ChunkOffset chunk_offset) const final;
 
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <functional>
+
+#include "types.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+/**
+ * Resolves a ScanType into the matching comparator functor and passes it on to a generic lambda. The comparator is
+ * called as comparator(value, search_value), e.g., std::less<> for OpLessThan.
+ *
+ * Use this to dispatch once per segment (or chunk) so that the actual comparison loop is instantiated for the concrete
+ * comparator. Compared to switching over the ScanType for every value, this allows the compiler to inline and
+ * vectorize the comparison.
+ *
+ * Example:
+ *
+ *   with_comparator(scan_type, [&](auto comparator) {
+ *     for (const auto& value : values) {
+ *       if (comparator(value, search_value)) ...
+ *     }
+ *   });
+ */
+template <typename Functor>
+void with_comparator(const ScanType scan_type, const Functor& func) {
+  switch (scan_type) {
+    case ScanType::OpEquals:
+      func(std::equal_to<>{});
+      return;
+    case ScanType::OpNotEquals:
+      func(std::not_equal_to<>{});
+      return;
+    case ScanType::OpLessThan:
+      func(std::less<>{});
+      return;
+    case ScanType::OpLessThanEquals:
+      func(std::less_equal<>{});
+      return;
+    case ScanType::OpGreaterThan:
+      func(std::greater<>{});
+      return;
+    case ScanType::OpGreaterThanEquals:
+      func(std::greater_equal<>{});
+      return;
+  }
+  Fail("Unknown scan type");
+}
+
+// The result of comparing a predicate against the value range [minimum, maximum] of a block, segment, or chunk.
+enum class RangeOutcome { AllRows, NoRows, SomeRows };
+
+// Decides whether all or none of the values in [minimum, maximum] satisfy value <scan_type> search_value. For
+// SomeRows, the search value is always within [minimum, maximum] unless it is NaN.
+template <typename T>
+RangeOutcome classify_range(const ScanType scan_type, const T& search_value, const T& minimum, const T& maximum) {
+  const auto no_rows_if = [](const bool condition) {
+    return condition ? RangeOutcome::NoRows : RangeOutcome::SomeRows;
+  };
+  const auto all_rows_if = [](const bool condition) {
+    return condition ? RangeOutcome::AllRows : RangeOutcome::SomeRows;
+  };
+  switch (scan_type) {
+    case ScanType::OpEquals:
+      if (search_value < minimum || search_value > maximum) return RangeOutcome::NoRows;
+      return all_rows_if(minimum == maximum && search_value == minimum);
+    case ScanType::OpNotEquals:
+      if (search_value < minimum || search_value > maximum) return RangeOutcome::AllRows;
+      return no_rows_if(minimum == maximum && search_value == minimum);
+    case ScanType::OpLessThan:
+      if (search_value <= minimum) return RangeOutcome::NoRows;
+      return all_rows_if(search_value > maximum);
+    case ScanType::OpLessThanEquals:
+      if (search_value < minimum) return RangeOutcome::NoRows;
+      return all_rows_if(search_value >= maximum);
+    case ScanType::OpGreaterThan:
+      if (search_value >= maximum) return RangeOutcome::NoRows;
+      return all_rows_if(search_value < minimum);
+    case ScanType::OpGreaterThanEquals:
+      if (search_value > maximum) return RangeOutcome::NoRows;
+      return all_rows_if(search_value <= minimum);
+  }
+  Fail("Unknown scan type");
+}
+
+}  // namespace opossum
@@ -37,6 +37,8 @@ namespace opossum {
 
 using ChunkOffset = uint32_t;
 using AttributeVectorWidth = uint8_t;
+using WorkerID = uint32_t;
+using TaskID = uint32_t;
 
 struct RowID {
   ChunkID chunk_id;
@@ -54,7 +56,22 @@ struct RowID {
 
 enum class ScanType { OpEquals, OpNotEquals, OpLessThan, OpLessThanEquals, OpGreaterThan, OpGreaterThanEquals };
 
-using PosList = std::vector<RowID>;
+// Determines how the value ids of a dictionary-encoded segment are stored (FixedWidthIntegerVector or BitPackedVector).
+enum class VectorCompressionType { FixedWidthInteger, BitPacking };
+
+// Determines the segment type that Table::compress_chunk creates for a column (DictionarySegment, RunLengthSegment,
+// FrameOfReferenceSegment, optionally in delta mode, or FrontCodedDictionarySegment). Frame-of-reference encoding only
+// supports integral types, front-coded dictionaries only support strings.
+enum class EncodingType { Dictionary, RunLength, FrameOfReference, FrameOfReferenceDelta, FrontCodedDictionary };
+
+// Describes how a single segment is encoded. The vector compression type only applies to the dictionary encodings.
+struct SegmentEncodingSpec {
+  EncodingType encoding_type = EncodingType::Dictionary;
+  VectorCompressionType vector_compression_type = VectorCompressionType::FixedWidthInteger;
+};
+
+// Describes how the segments of a chunk are encoded, one entry per column.
+using ChunkEncodingSpec = std::vector<SegmentEncodingSpec>;
 
 // Prevents unnecessary, potentially expensive, copies by deleting copy constructor and copy assignment operator.
 class Noncopyable {
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+
+namespace opossum {
+
+// Hashes a value for hash tables that use the lowest bits of the hash, e.g., for radix partitioning or as the slot
+// of an open-addressing table. Integers are hashed to themselves by std::hash, so all hashes are mixed with the
+// finalizer of MurmurHash3 to spread consecutive values across all bits.
+template <typename T>
+size_t hash_value(const T& value) {
+  auto hash = uint64_t{0};
+  if constexpr (std::is_floating_point_v<T>) {
+    // -0.0 equals 0.0 and must have the same hash.
+    hash = std::hash<T>{}(value == T{0} ? T{0} : value);
+  } else {
+    hash = std::hash<T>{}(value);
+  }
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccdULL;
+  hash ^= hash >> 33;
+  hash *= 0xc4ceb9fe1a85ec53ULL;
+  hash ^= hash >> 33;
+  return static_cast<size_t>(hash);
+}
+
+}  // namespace opossum
@@ -37,4 +37,14 @@ std::string trim_source_file_path(const std::string& path) {
   return path.substr(src_pos + 1);
 }
 
+size_t string_heap_size(const std::string& string) {
+  // With the small string optimization, the characters are stored in a buffer within the string object.
+  const auto* object_begin = reinterpret_cast<const char*>(&string);
+  const auto* object_end = object_begin + sizeof(std::string);
+  if (string.data() >= object_begin && string.data() < object_end) return 0;
+
+  // the allocation includes the terminating null character.
+  return string.capacity() + 1;
+}
+
 }  // namespace opossum
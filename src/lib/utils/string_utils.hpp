@@ -16,4 +16,8 @@ std::vector<std::string> split_string_by_delimiter(const std::string& str, char
 // "/long/very/long/path/1234/src/lib/file.cpp" to "src/lib/file.cpp"
 std::string trim_source_file_path(const std::string& path);
 
+// Returns the number of bytes that a string has allocated on the heap. This is 0 for short strings that are stored
+// within the string object itself (small string optimization).
+size_t string_heap_size(const std::string& string);
+
 }  // namespace opossum
@@ -30,7 +30,35 @@ void BaseTest::ASSERT_TABLE_EQ(std::shared_ptr<const Table> tleft, std::shared_p
   ASSERT_TABLE_EQ(*tleft, *tright, order_sensitive, strict_types);
 }
 
-BaseTest::Matrix BaseTest::_table_to_matrix(const Table& table) {
+std::shared_ptr<TableWrapper> BaseTest::wrap(const std::shared_ptr<const Table>& table) {
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+  return table_wrapper;
+}
+
+Matrix BaseTest::rows_of(const Table& table) { return _table_to_matrix(table); }
+
+TableColumnDefinitions BaseTest::column_definitions_of(const Table& table) {
+  auto column_definitions = TableColumnDefinitions{};
+  for (auto column_id = ColumnID{0}; column_id < table.column_count(); ++column_id) {
+    column_definitions.emplace_back(table.column_name(column_id), table.column_type(column_id));
+  }
+  return column_definitions;
+}
+
+std::shared_ptr<Table> BaseTest::table_from_rows(const TableColumnDefinitions& column_definitions,
+                                                 const Matrix& rows) {
+  auto table = std::make_shared<Table>();
+  for (const auto& [name, type] : column_definitions) {
+    table->add_column(name, type);
+  }
+  for (const auto& row : rows) {
+    table->append(row);
+  }
+  return table;
+}
+
+Matrix BaseTest::_table_to_matrix(const Table& table) {
   // initialize matrix with table sizes
   Matrix matrix(table.row_count(), std::vector<AllTypeVariant>(table.column_count()));
 
@@ -55,7 +83,7 @@ BaseTest::Matrix BaseTest::_table_to_matrix(const Table& table) {
   return matrix;
 }
 
-void BaseTest::_print_matrix(const BaseTest::Matrix& matrix) {
+void BaseTest::_print_matrix(const Matrix& matrix) {
   std::cout << "-------------" << std::endl;
   for (unsigned row = 0; row < matrix.size(); row++) {
     for (ColumnID col{0}; col < matrix[row].size(); col++) {
@@ -5,6 +5,7 @@
 #include <utility>
 #include <vector>
 
+#include "../lib/operators/table_wrapper.hpp"
 #include "../lib/storage/table.hpp"
 #include "../lib/storage/value_segment.hpp"
 #include "../lib/types.hpp"
@@ -17,13 +18,12 @@ class AbstractASTNode;
 class Table;
 
 using Matrix = std::vector<std::vector<AllTypeVariant>>;
+using TableColumnDefinitions = std::vector<std::pair<std::string, std::string>>;
 
 class BaseTest : public ::testing::Test {
-  using Matrix = std::vector<std::vector<AllTypeVariant>>;
-
   // helper functions for _table_equal
-  static BaseTest::Matrix _table_to_matrix(const Table& table);
-  static void _print_matrix(const BaseTest::Matrix& matrix);
+  static Matrix _table_to_matrix(const Table& table);
+  static void _print_matrix(const Matrix& matrix);
 
   // helper function for load_table
   template <typename T>
@@ -46,6 +46,18 @@ class BaseTest : public ::testing::Test {
   static void ASSERT_TABLE_EQ(std::shared_ptr<const Table> tleft, std::shared_ptr<const Table> tright,
                               bool order_sensitive = false, bool strict_types = true);
 
+  // returns an executed TableWrapper around the table, e.g., as the input of an operator
+  static std::shared_ptr<TableWrapper> wrap(const std::shared_ptr<const Table>& table);
+
+  // returns the values of the table row by row, in the order of the chunks
+  static Matrix rows_of(const Table& table);
+
+  // returns the names and types of the columns of the table
+  static TableColumnDefinitions column_definitions_of(const Table& table);
+
+  // creates a table with the given columns and rows, e.g., as the expected output of an operator
+  static std::shared_ptr<Table> table_from_rows(const TableColumnDefinitions& column_definitions, const Matrix& rows);
+
  public:
   virtual ~BaseTest();
 };
@@ -0,0 +1,253 @@
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "operators/aggregate.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "storage/table.hpp"
+#include "types.hpp"
+#include "utils/load_table.hpp"
+
+namespace opossum {
+
+class OperatorsAggregateTest : public BaseTest {
+ protected:
+  // Creates a table with an int column "a" (index % a_modulo), a string column "b" (index % b_modulo), a long column
+  // "c", and a double column "d". Each chunk of chunk_size rows has a different encoding.
+  static std::shared_ptr<Table> create_table(const int32_t row_count, const int32_t a_modulo, const int32_t b_modulo,
+                                            const ChunkOffset chunk_size) {
+    auto table = std::make_shared<Table>(chunk_size);
+    table->add_column("a", "int");
+    table->add_column("b", "string");
+    table->add_column("c", "long");
+    table->add_column("d", "double");
+    for (auto index = int32_t{0}; index < row_count; ++index) {
+      table->append({index % a_modulo, "b" + std::to_string(index % b_modulo), int64_t{index} * 3 - 500,
+                     static_cast<double>(index % 7) / 2});
+    }
+
+    const auto encodings = std::vector<EncodingType>{EncodingType::Dictionary, EncodingType::RunLength,
+                                                     EncodingType::FrameOfReference};
+    for (auto chunk_id = ChunkID{0}; chunk_id + 1 < table->chunk_count(); ++chunk_id) {
+      const auto encoding = encodings[chunk_id % encodings.size()];
+      table->compress_chunk(chunk_id, {SegmentEncodingSpec{encoding},
+                                       SegmentEncodingSpec{encoding == EncodingType::FrameOfReference
+                                                               ? EncodingType::FrontCodedDictionary
+                                                               : encoding},
+                                       SegmentEncodingSpec{encoding}, SegmentEncodingSpec{EncodingType::Dictionary}});
+    }
+    return table;
+  }
+
+  // Computes MIN(c), MAX(b), SUM(c), AVG(d), COUNT(*) grouped by the given columns (a subset of a and b) row by row.
+  static std::shared_ptr<Table> aggregate_rows(const std::shared_ptr<const Table>& table,
+                                               const std::vector<ColumnID>& group_by_column_ids) {
+    struct Accumulator {
+      int64_t min_c;
+      std::string max_b;
+      int64_t sum_c = 0;
+      double sum_d = 0;
+      int64_t count = 0;
+    };
+
+    auto groups = std::map<std::vector<AllTypeVariant>, Accumulator>{};
+    for (const auto& row : rows_of(*table)) {
+      auto group_key = std::vector<AllTypeVariant>{};
+      for (const auto column_id : group_by_column_ids) {
+        group_key.push_back(row[column_id]);
+      }
+      const auto b = type_cast<std::string>(row[1]);
+      const auto c = type_cast<int64_t>(row[2]);
+      auto& accumulator = groups[group_key];
+      if (accumulator.count++ == 0) {
+        accumulator.min_c = c;
+        accumulator.max_b = b;
+      }
+      accumulator.min_c = std::min(accumulator.min_c, c);
+      accumulator.max_b = std::max(accumulator.max_b, b);
+      accumulator.sum_c += c;
+      accumulator.sum_d += type_cast<double>(row[3]);
+    }
+
+    const auto input_column_definitions = column_definitions_of(*table);
+    auto column_definitions = TableColumnDefinitions{};
+    for (const auto column_id : group_by_column_ids) {
+      column_definitions.push_back(input_column_definitions[column_id]);
+    }
+    column_definitions.insert(column_definitions.end(), {{"MIN(c)", "long"},
+                                                         {"MAX(b)", "string"},
+                                                         {"SUM(c)", "long"},
+                                                         {"AVG(d)", "double"},
+                                                         {"COUNT(*)", "long"}});
+
+    auto rows = Matrix{};
+    for (const auto& [group_key, accumulator] : groups) {
+      auto& row = rows.emplace_back(group_key);
+      row.insert(row.end(), {accumulator.min_c, accumulator.max_b, accumulator.sum_c,
+                             accumulator.sum_d / static_cast<double>(accumulator.count), accumulator.count});
+    }
+    return table_from_rows(column_definitions, rows);
+  }
+
+  static std::vector<AggregateColumnDefinition> aggregates() {
+    return {{AggregateFunction::Min, ColumnID{2}},
+            {AggregateFunction::Max, ColumnID{1}},
+            {AggregateFunction::Sum, ColumnID{2}},
+            {AggregateFunction::Avg, ColumnID{3}},
+            {AggregateFunction::Count, std::nullopt}};
+  }
+};
+
+TEST_F(OperatorsAggregateTest, GroupBySingleColumn) {
+  const auto table = create_table(1'000, 17, 11, 150);
+  for (const auto column_id : {ColumnID{0}, ColumnID{1}}) {
+    const auto group_by_column_ids = std::vector<ColumnID>{column_id};
+    const auto aggregate = std::make_shared<Aggregate>(wrap(table), aggregates(), group_by_column_ids);
+    aggregate->execute();
+    EXPECT_TABLE_EQ(aggregate->get_output(), aggregate_rows(table, group_by_column_ids));
+  }
+}
+
+TEST_F(OperatorsAggregateTest, GroupByMultipleColumns) {
+  // with few distinct values, the combinations of both columns are used as
+  // group ids directly. Otherwise, they are hashed. The group by columns are
+  // in the order given.
+  for (const auto& [a_modulo, b_modulo] : {std::pair{5, 4}, std::pair{97, 89}}) {
+    const auto table = create_table(1'000, a_modulo, b_modulo, 150);
+    const auto group_by_column_ids = std::vector<ColumnID>{ColumnID{1}, ColumnID{0}};
+    const auto aggregate = std::make_shared<Aggregate>(wrap(table), aggregates(), group_by_column_ids);
+    aggregate->execute();
+    EXPECT_TABLE_EQ(aggregate->get_output(), aggregate_rows(table, group_by_column_ids));
+  }
+}
+
+TEST_F(OperatorsAggregateTest, WithoutGroupBy) {
+  const auto table = create_table(1'000, 17, 11, 150);
+  const auto aggregate = std::make_shared<Aggregate>(wrap(table), aggregates(), std::vector<ColumnID>{});
+  aggregate->execute();
+  EXPECT_TABLE_EQ(aggregate->get_output(), aggregate_rows(table, {}));
+  EXPECT_EQ(aggregate->get_output()->row_count(), 1u);
+}
+
+TEST_F(OperatorsAggregateTest, WithoutGroupByFromMetadata) {
+  // the aggregates of dictionary and run-length segments are computed from
+  // their dictionaries and runs, those of value segments by scanning them.
+  const auto encoded_table = create_table(1'000, 17, 11, 150);
+  const auto dictionary_table = create_table(1'000, 17, 11, 150);
+  for (auto chunk_id = ChunkID{0}; chunk_id < dictionary_table->chunk_count(); ++chunk_id) {
+    dictionary_table->compress_chunk(chunk_id);
+  }
+  const auto value_table = create_table(1'000, 17, 11, 1'000);
+
+  for (const auto& table : {encoded_table, dictionary_table, value_table}) {
+    const auto aggregate = std::make_shared<Aggregate>(wrap(table), aggregates(), std::vector<ColumnID>{});
+    aggregate->execute();
+    EXPECT_TABLE_EQ(aggregate->get_output(), aggregate_rows(table, {}));
+  }
+}
+
+TEST_F(OperatorsAggregateTest, CountDistinct) {
+  const auto table = create_table(1'000, 17, 11, 150);
+  const auto count_distinct = std::vector<AggregateColumnDefinition>{{AggregateFunction::CountDistinct, ColumnID{0}},
+                                                                     {AggregateFunction::CountDistinct, ColumnID{1}},
+                                                                     {AggregateFunction::CountDistinct, ColumnID{3}}};
+
+  const auto aggregate = std::make_shared<Aggregate>(wrap(table), count_distinct, std::vector<ColumnID>{});
+  aggregate->execute();
+  EXPECT_TABLE_EQ(aggregate->get_output(), load_table("src/test/tables/aggregate_count_distinct.tbl", 1));
+
+  // as 17, 11, and 7 are coprime, each b appears together with all values of
+  // a and d.
+  const auto grouped = std::make_shared<Aggregate>(wrap(table), count_distinct, std::vector<ColumnID>{ColumnID{1}});
+  grouped->execute();
+  EXPECT_TABLE_EQ(grouped->get_output(), load_table("src/test/tables/aggregate_count_distinct_by_b.tbl", 4));
+}
+
+TEST_F(OperatorsAggregateTest, ReferenceInput) {
+  const auto table = create_table(1'000, 17, 11, 150);
+  const auto table_scan = std::make_shared<TableScan>(wrap(table), ColumnID{2}, ScanType::OpGreaterThan, 1'000);
+  table_scan->execute();
+
+  const auto aggregate =
+      std::make_shared<Aggregate>(table_scan, aggregates(), std::vector<ColumnID>{ColumnID{0}, ColumnID{1}});
+  aggregate->execute();
+  EXPECT_TABLE_EQ(aggregate->get_output(), aggregate_rows(table_scan->get_output(), {ColumnID{0}, ColumnID{1}}));
+}
+
+TEST_F(OperatorsAggregateTest, EmptyInput) {
+  // the scan filters out all rows.
+  const auto table = load_table("src/test/tables/int_string_long_double.tbl", 4);
+  const auto table_scan = std::make_shared<TableScan>(wrap(table), ColumnID{0}, ScanType::OpGreaterThan, 100);
+  table_scan->execute();
+  const auto counts = std::vector<AggregateColumnDefinition>{{AggregateFunction::Count, std::nullopt},
+                                                             {AggregateFunction::CountDistinct, ColumnID{1}}};
+
+  for (const auto& input :
+       std::vector<std::shared_ptr<const AbstractOperator>>{wrap(std::make_shared<Table>(table)), table_scan}) {
+    // without group by columns, there is a single row in which the counts are
+    // zero.
+    const auto ungrouped = std::make_shared<Aggregate>(input, counts, std::vector<ColumnID>{});
+    ungrouped->execute();
+    EXPECT_TABLE_EQ(ungrouped->get_output(), load_table("src/test/tables/aggregate_empty_counts.tbl", 1));
+
+    const auto grouped = std::make_shared<Aggregate>(input, counts, std::vector<ColumnID>{ColumnID{0}});
+    grouped->execute();
+    EXPECT_EQ(grouped->get_output()->row_count(), 0u);
+    EXPECT_EQ(grouped->get_output()->column_count(), 3u);
+
+    // MIN, MAX, SUM, and AVG would be NULL.
+    const auto not_only_counts = std::make_shared<Aggregate>(input, aggregates(), std::vector<ColumnID>{});
+    not_only_counts->execute();
+    EXPECT_EQ(not_only_counts->get_output()->row_count(), 0u);
+    EXPECT_EQ(not_only_counts->get_output()->column_count(), 5u);
+  }
+}
+
+TEST_F(OperatorsAggregateTest, OutputColumns) {
+  // the expected table also checks the names and types of the output columns.
+  const auto table = load_table("src/test/tables/int_string_long_double.tbl", 4);
+  table->compress_chunk(ChunkID{0});
+  const auto aggregate = std::make_shared<Aggregate>(
+      wrap(table),
+      std::vector<AggregateColumnDefinition>{{AggregateFunction::Sum, ColumnID{0}},
+                                             {AggregateFunction::Sum, ColumnID{3}},
+                                             {AggregateFunction::Min, ColumnID{3}},
+                                             {AggregateFunction::Count, ColumnID{1}}},
+      std::vector<ColumnID>{ColumnID{1}});
+  aggregate->execute();
+  EXPECT_TABLE_EQ(aggregate->get_output(), load_table("src/test/tables/aggregate_sums_by_b.tbl", 2));
+}
+
+TEST_F(OperatorsAggregateTest, FloatingPointZeros) {
+  // 0.0 and -0.0 form a single group.
+  const auto table = load_table("src/test/tables/double_signed_zeros.tbl", 2);
+
+  const auto aggregate = std::make_shared<Aggregate>(
+      wrap(table), std::vector<AggregateColumnDefinition>{{AggregateFunction::Count, std::nullopt}},
+      std::vector<ColumnID>{ColumnID{0}});
+  aggregate->execute();
+  EXPECT_EQ(aggregate->get_output()->row_count(), 2u);
+}
+
+TEST_F(OperatorsAggregateTest, InvalidAggregates) {
+  const auto table = wrap(load_table("src/test/tables/int_string_long_double.tbl", 4));
+  EXPECT_THROW(Aggregate(table, {{AggregateFunction::Min, std::nullopt}}, {}), std::logic_error);
+
+  for (const auto function : {AggregateFunction::Sum, AggregateFunction::Avg}) {
+    const auto aggregate = std::make_shared<Aggregate>(
+        table, std::vector<AggregateColumnDefinition>{{function, ColumnID{1}}}, std::vector<ColumnID>{});
+    EXPECT_THROW(aggregate->execute(), std::logic_error);
+  }
+  const auto aggregate = std::make_shared<Aggregate>(table, std::vector<AggregateColumnDefinition>{},
+                                                     std::vector<ColumnID>{ColumnID{4}});
+  EXPECT_THROW(aggregate->execute(), std::logic_error);
+}
+
+}  // namespace opossum
@@ -0,0 +1,115 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "operators/batch.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "storage/table.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class OperatorsBatchTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    // chunk 0 stays unencoded, the other chunks use the different encodings.
+    _table = std::make_shared<Table>(5000);
+    _table->add_column("a", "int");
+    _table->add_column("b", "string");
+    for (auto index = int32_t{0}; index < 20'000; ++index) {
+      _table->append({(index / 3) % 101, "s" + std::to_string(index % 17)});
+    }
+    _table->compress_chunk(ChunkID{1});
+    _table->compress_chunk(ChunkID{2}, {SegmentEncodingSpec{EncodingType::RunLength},
+                                        SegmentEncodingSpec{EncodingType::FrontCodedDictionary}});
+    _table->compress_chunk(ChunkID{3}, {SegmentEncodingSpec{EncodingType::FrameOfReferenceDelta},
+                                        SegmentEncodingSpec{EncodingType::RunLength}});
+  }
+
+  static int32_t a_of(const size_t row) { return static_cast<int32_t>((row / 3) % 101); }
+  static std::string b_of(const size_t row) { return "s" + std::to_string(row % 17); }
+
+  std::shared_ptr<Table> _table;
+};
+
+TEST_F(OperatorsBatchTest, ValuesOfAllEncodings) {
+  for (auto chunk_id = ChunkID{0}; chunk_id < _table->chunk_count(); ++chunk_id) {
+    auto batch = Batch{_table, chunk_id, ChunkOffset{64}, ChunkOffset{64} + Batch::MAX_SIZE};
+    EXPECT_EQ(batch.size(), Batch::MAX_SIZE);
+    EXPECT_EQ(batch.selection().size(), Batch::MAX_SIZE);
+
+    const auto* a_values = batch.values<int32_t>(ColumnID{0});
+    const auto* b_values = batch.values<std::string>(ColumnID{1});
+    for (auto offset = size_t{0}; offset < Batch::MAX_SIZE; ++offset) {
+      const auto row = chunk_id * 5000 + 64 + offset;
+      EXPECT_EQ(a_values[offset], a_of(row));
+      EXPECT_EQ(b_values[offset], b_of(row));
+    }
+    // the values are only materialized once.
+    EXPECT_EQ(batch.values<int32_t>(ColumnID{0}), a_values);
+  }
+}
+
+TEST_F(OperatorsBatchTest, OnlySelectedRowsAreMaterialized) {
+  // chunk 0 is unencoded, so its values are not materialized at all.
+  for (auto chunk_id = ChunkID{1}; chunk_id < _table->chunk_count(); ++chunk_id) {
+    auto batch = Batch{_table, chunk_id, ChunkOffset{128}, ChunkOffset{256}};
+    batch.selection() = {3, 40, 41, 127};
+
+    const auto* a_values = batch.values<int32_t>(ColumnID{0});
+    for (const auto offset : batch.selection()) {
+      EXPECT_EQ(a_values[offset], a_of(chunk_id * 5000 + 128 + offset));
+    }
+    EXPECT_EQ(a_values[0], 0);
+  }
+}
+
+TEST_F(OperatorsBatchTest, ReferenceSegments) {
+  const auto table_wrapper = std::make_shared<TableWrapper>(_table);
+  table_wrapper->execute();
+  // a broad scan returns bitmaps, a narrow one chunk offsets.
+  for (const auto search_value : {90, 10}) {
+    const auto table_scan = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, ScanType::OpLessThan, search_value);
+    table_scan->execute();
+    const auto scan_output = table_scan->get_output();
+
+    for (auto chunk_id = ChunkID{0}; chunk_id < scan_output->chunk_count(); ++chunk_id) {
+      const auto chunk = scan_output->get_chunk(chunk_id);
+      const auto end = std::min(chunk->size(), Batch::MAX_SIZE);
+      auto batch = Batch{scan_output, chunk_id, ChunkOffset{0}, end};
+      const auto* a_values = batch.values<int32_t>(ColumnID{0});
+      const auto* b_values = batch.values<std::string>(ColumnID{1});
+      for (auto offset = ChunkOffset{0}; offset < end; ++offset) {
+        EXPECT_EQ(AllTypeVariant{a_values[offset]}, (*chunk->get_segment(ColumnID{0}))[offset]);
+        EXPECT_EQ(AllTypeVariant{b_values[offset]}, (*chunk->get_segment(ColumnID{1}))[offset]);
+      }
+    }
+  }
+}
+
+TEST_F(OperatorsBatchTest, TableScanFiltersSelection) {
+  auto batch = Batch{_table, ChunkID{1}, ChunkOffset{0}, ChunkOffset{300}};
+  const auto table_wrapper = std::make_shared<TableWrapper>(_table);
+  TableScan{table_wrapper, ColumnID{0}, ScanType::OpGreaterThanEquals, 50}.process_batch(batch);
+  TableScan{table_wrapper, ColumnID{1}, ScanType::OpEquals, "s3"}.process_batch(batch);
+  // few rows remain, so their values are decoded into the batch.
+  TableScan{table_wrapper, ColumnID{0}, ScanType::OpLessThan, 80}.process_batch(batch);
+
+  auto expected_selection = std::vector<uint16_t>{};
+  for (auto offset = uint16_t{0}; offset < 300; ++offset) {
+    const auto row = 5000 + offset;
+    if (a_of(row) >= 50 && b_of(row) == "s3" && a_of(row) < 80) expected_selection.push_back(offset);
+  }
+  EXPECT_FALSE(expected_selection.empty());
+  EXPECT_EQ(batch.selection(), expected_selection);
+}
+
+TEST_F(OperatorsBatchTest, TooManyRows) {
+  EXPECT_THROW((Batch{_table, ChunkID{0}, ChunkOffset{0}, Batch::MAX_SIZE + 1}), std::logic_error);
+}
+
+}  // namespace opossum
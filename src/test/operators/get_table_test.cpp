@@ -1,4 +1,6 @@
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "base_test.hpp"
 #include "gtest/gtest.h"
@@ -36,4 +38,44 @@ TEST_F(OperatorsGetTableTest, GetTableName) {
 
   EXPECT_EQ(get_table_oper->table_name(), "TableA");
 }
+
+TEST_F(OperatorsGetTableTest, PruneChunks) {
+  _test_table->add_column("a", "int");
+  _test_table->add_column("b", "string");
+  for (auto value = int32_t{0}; value < 6; ++value) {
+    _test_table->append({value, std::to_string(value)});
+  }
+  _test_table->compress_chunk(ChunkID{0});
+
+  // a >= 2 prunes the first chunk with the values 0 and 1.
+  auto get_table_oper = std::make_shared<GetTable>(
+      "TableA", std::vector<ChunkPruningPredicate>{{ColumnID{0}, ScanType::OpGreaterThanEquals, 2}});
+  get_table_oper->execute();
+  auto output = get_table_oper->get_output();
+  EXPECT_EQ(output->chunk_count(), 2u);
+  EXPECT_EQ(output->row_count(), 4u);
+  EXPECT_EQ(output->get_chunk(ChunkID{0}), _test_table->get_chunk(ChunkID{1}));
+  EXPECT_EQ(output->column_names(), _test_table->column_names());
+
+  // All predicates have to hold, so each of them can prune chunks.
+  get_table_oper = std::make_shared<GetTable>(
+      "TableA", std::vector<ChunkPruningPredicate>{{ColumnID{0}, ScanType::OpGreaterThanEquals, 2},
+                                                   {ColumnID{1}, ScanType::OpLessThan, std::string{"4"}}});
+  get_table_oper->execute();
+  output = get_table_oper->get_output();
+  EXPECT_EQ(output->chunk_count(), 1u);
+  EXPECT_EQ(output->get_chunk(ChunkID{0}), _test_table->get_chunk(ChunkID{1}));
+
+  // Without a prunable chunk, the stored table is returned.
+  get_table_oper = std::make_shared<GetTable>(
+      "TableA", std::vector<ChunkPruningPredicate>{{ColumnID{0}, ScanType::OpNotEquals, 3}});
+  get_table_oper->execute();
+  EXPECT_EQ(get_table_oper->get_output(), _test_table);
+
+  get_table_oper = std::make_shared<GetTable>(
+      "TableA", std::vector<ChunkPruningPredicate>{{ColumnID{0}, ScanType::OpGreaterThan, 5}});
+  get_table_oper->execute();
+  EXPECT_EQ(get_table_oper->get_output()->row_count(), 0u);
+  EXPECT_EQ(get_table_oper->get_output()->column_count(), 2u);
+}
 }  // namespace opossum
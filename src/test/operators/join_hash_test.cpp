@@ -0,0 +1,146 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "operators/join_hash.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "storage/reference_segment.hpp"
+#include "storage/table.hpp"
+#include "types.hpp"
+#include "utils/load_table.hpp"
+
+namespace opossum {
+
+class OperatorsJoinHashTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    // the columns of both tables hold the same keys in all data types, so joining on any of them gives the same result.
+    _left = load_table("src/test/tables/join_keys_left.tbl", 4);
+    _right = load_table("src/test/tables/join_keys_right.tbl", 3);
+    _right->compress_chunk(ChunkID{1});
+  }
+
+  // Creates a table with an int column "<prefix>_key" (index % key_modulo) and an int column "<prefix>_index".
+  static std::shared_ptr<Table> create_table(const std::string& prefix, const int32_t row_count,
+                                            const int32_t key_modulo, const ChunkOffset chunk_size) {
+    auto table = std::make_shared<Table>(chunk_size);
+    table->add_column(prefix + "_key", "int");
+    table->add_column(prefix + "_index", "int");
+    for (auto index = int32_t{0}; index < row_count; ++index) {
+      table->append({index % key_modulo, index});
+    }
+    return table;
+  }
+
+  // Joins the tables with a nested loop, comparing the values of the join columns as AllTypeVariants.
+  static std::shared_ptr<Table> nested_loop_join(const std::shared_ptr<const Table>& left,
+                                                 const std::shared_ptr<const Table>& right,
+                                                 const ColumnID left_column_id, const ColumnID right_column_id) {
+    auto column_definitions = column_definitions_of(*left);
+    const auto right_column_definitions = column_definitions_of(*right);
+    column_definitions.insert(column_definitions.end(), right_column_definitions.cbegin(),
+                              right_column_definitions.cend());
+
+    auto rows = Matrix{};
+    const auto right_rows = rows_of(*right);
+    for (const auto& left_row : rows_of(*left)) {
+      for (const auto& right_row : right_rows) {
+        if (left_row[left_column_id] != right_row[right_column_id]) continue;
+        auto& row = rows.emplace_back(left_row);
+        row.insert(row.end(), right_row.cbegin(), right_row.cend());
+      }
+    }
+    return table_from_rows(column_definitions, rows);
+  }
+
+  std::shared_ptr<Table> _left = nullptr;
+  std::shared_ptr<Table> _right = nullptr;
+};
+
+TEST_F(OperatorsJoinHashTest, AllDataTypes) {
+  const auto expected = load_table("src/test/tables/join_keys_equals.tbl", 3);
+  for (auto column_id = ColumnID{0}; column_id < 5; ++column_id) {
+    const auto join = std::make_shared<JoinHash>(wrap(_left), wrap(_right), column_id, column_id);
+    join->execute();
+    EXPECT_TABLE_EQ(join->get_output(), expected);
+  }
+}
+
+TEST_F(OperatorsJoinHashTest, RadixBits) {
+  // the larger input is on the left, so the hash table is built on the right.
+  const auto left = create_table("l", 400, 97, 100);
+  const auto right = create_table("r", 200, 150, 1'000);
+  const auto expected = nested_loop_join(left, right, ColumnID{0}, ColumnID{0});
+  EXPECT_GT(expected->row_count(), 0u);
+
+  for (const auto radix_bits : {uint8_t{0}, uint8_t{1}, uint8_t{5}, JoinHash::MAX_RADIX_BITS}) {
+    const auto join = std::make_shared<JoinHash>(wrap(left), wrap(right), ColumnID{0}, ColumnID{0}, radix_bits);
+    join->execute();
+    EXPECT_TABLE_EQ(join->get_output(), expected);
+  }
+  EXPECT_THROW(JoinHash(wrap(left), wrap(right), ColumnID{0}, ColumnID{0}, uint8_t{JoinHash::MAX_RADIX_BITS + 1}),
+               std::logic_error);
+}
+
+TEST_F(OperatorsJoinHashTest, ReferenceInputs) {
+  _left->compress_chunk(ChunkID{0});
+  const auto left_scan = std::make_shared<TableScan>(wrap(_left), ColumnID{5}, ScanType::OpGreaterThanEquals, 4);
+  left_scan->execute();
+  const auto right_scan = std::make_shared<TableScan>(wrap(_right), ColumnID{5}, ScanType::OpLessThan, 6);
+  right_scan->execute();
+
+  const auto join = std::make_shared<JoinHash>(left_scan, right_scan, ColumnID{4}, ColumnID{4});
+  join->execute();
+  const auto output = join->get_output();
+  EXPECT_TABLE_EQ(output, load_table("src/test/tables/join_keys_equals_filtered.tbl", 3));
+
+  // the output references the base tables, not the scan outputs.
+  const auto chunk = output->get_chunk(ChunkID{0});
+  EXPECT_EQ(std::dynamic_pointer_cast<const ReferenceSegment>(chunk->get_segment(ColumnID{0}))->referenced_table(),
+            _left);
+  EXPECT_EQ(std::dynamic_pointer_cast<const ReferenceSegment>(chunk->get_segment(ColumnID{6}))->referenced_table(),
+            _right);
+}
+
+TEST_F(OperatorsJoinHashTest, NoMatches) {
+  // none of the left keys is 0, the only right index below 1.
+  const auto right_scan = std::make_shared<TableScan>(wrap(_right), ColumnID{5}, ScanType::OpLessThan, 1);
+  right_scan->execute();
+
+  const auto join = std::make_shared<JoinHash>(wrap(_left), right_scan, ColumnID{0}, ColumnID{5});
+  join->execute();
+  EXPECT_EQ(join->get_output()->row_count(), 0u);
+  EXPECT_EQ(join->get_output()->column_count(), 12u);
+}
+
+TEST_F(OperatorsJoinHashTest, EmptyInput) {
+  const auto empty = std::make_shared<Table>(_right);
+
+  const auto join = std::make_shared<JoinHash>(wrap(_left), wrap(empty), ColumnID{0}, ColumnID{0});
+  join->execute();
+  EXPECT_EQ(join->get_output()->row_count(), 0u);
+  EXPECT_EQ(join->get_output()->column_count(), 12u);
+  EXPECT_EQ(join->get_output()->column_name(ColumnID{6}), "r_key");
+}
+
+TEST_F(OperatorsJoinHashTest, DifferentDataTypes) {
+  const auto table = wrap(load_table("src/test/tables/int_float.tbl", 2));
+  const auto join = std::make_shared<JoinHash>(table, table, ColumnID{0}, ColumnID{1});
+  EXPECT_THROW(join->execute(), std::logic_error);
+}
+
+TEST_F(OperatorsJoinHashTest, FloatingPointZeros) {
+  // 0.0 on the left is equal to -0.0 on the right.
+  const auto left = load_table("src/test/tables/double_zero.tbl", 2);
+  const auto right = load_table("src/test/tables/double_negative_zero.tbl", 2);
+
+  const auto join = std::make_shared<JoinHash>(wrap(left), wrap(right), ColumnID{0}, ColumnID{0});
+  join->execute();
+  EXPECT_EQ(join->get_output()->row_count(), 2u);
+}
+
+}  // namespace opossum
@@ -0,0 +1,171 @@
+#include <array>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "operators/join_sort_merge.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "storage/reference_segment.hpp"
+#include "storage/table.hpp"
+#include "type_comparison.hpp"
+#include "types.hpp"
+#include "utils/load_table.hpp"
+
+namespace opossum {
+
+class OperatorsJoinSortMergeTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    // the columns of both tables hold the same keys in all data types, and their order is the same in all of them.
+    _left = load_table("src/test/tables/join_keys_left.tbl", 4);
+    _right = load_table("src/test/tables/join_keys_right.tbl", 3);
+    _left->compress_chunk(ChunkID{1});
+    _right->compress_chunk(ChunkID{0});
+  }
+
+  // Creates a table with an int column "<prefix>_key" (index * key_factor % key_modulo) and an int column
+  // "<prefix>_index".
+  static std::shared_ptr<Table> create_table(const std::string& prefix, const int32_t row_count,
+                                            const int32_t key_factor, const int32_t key_modulo,
+                                            const ChunkOffset chunk_size) {
+    auto table = std::make_shared<Table>(chunk_size);
+    table->add_column(prefix + "_key", "int");
+    table->add_column(prefix + "_index", "int");
+    for (auto index = int32_t{0}; index < row_count; ++index) {
+      table->append({index * key_factor % key_modulo, index});
+    }
+    return table;
+  }
+
+  // Joins the tables with a nested loop, comparing the values of the join columns as AllTypeVariants.
+  static std::shared_ptr<Table> nested_loop_join(const std::shared_ptr<const Table>& left,
+                                                 const std::shared_ptr<const Table>& right,
+                                                 const ColumnID left_column_id, const ColumnID right_column_id,
+                                                 const ScanType scan_type) {
+    auto column_definitions = column_definitions_of(*left);
+    const auto right_column_definitions = column_definitions_of(*right);
+    column_definitions.insert(column_definitions.end(), right_column_definitions.cbegin(),
+                              right_column_definitions.cend());
+
+    auto rows = Matrix{};
+    const auto right_rows = rows_of(*right);
+    with_comparator(scan_type, [&](auto comparator) {
+      for (const auto& left_row : rows_of(*left)) {
+        for (const auto& right_row : right_rows) {
+          if (!comparator(left_row[left_column_id], right_row[right_column_id])) continue;
+          auto& row = rows.emplace_back(left_row);
+          row.insert(row.end(), right_row.cbegin(), right_row.cend());
+        }
+      }
+    });
+    return table_from_rows(column_definitions, rows);
+  }
+
+  static constexpr auto SCAN_TYPES =
+      std::array{ScanType::OpEquals,      ScanType::OpNotEquals,     ScanType::OpLessThan,
+                 ScanType::OpLessThanEquals, ScanType::OpGreaterThan, ScanType::OpGreaterThanEquals};
+
+  std::shared_ptr<Table> _left = nullptr;
+  std::shared_ptr<Table> _right = nullptr;
+};
+
+TEST_F(OperatorsJoinSortMergeTest, AllScanTypes) {
+  // the keys of the first left input are unsorted and partly dictionary
+  // encoded, those of the second one are clustered.
+  const auto unsorted = create_table("l", 60, 7, 23, 20);
+  unsorted->compress_chunk(ChunkID{0});
+  const auto clustered = create_table("l", 60, 1, 40, 25);
+  const auto right = create_table("r", 50, 11, 29, 15);
+  right->compress_chunk(ChunkID{1});
+
+  for (const auto& left : {unsorted, clustered}) {
+    for (const auto scan_type : SCAN_TYPES) {
+      const auto expected = nested_loop_join(left, right, ColumnID{0}, ColumnID{0}, scan_type);
+      for (const auto partition_count : {size_t{1}, size_t{3}, size_t{16}}) {
+        const auto join = std::make_shared<JoinSortMerge>(wrap(left), wrap(right), ColumnID{0}, ColumnID{0},
+                                                          scan_type, partition_count);
+        join->execute();
+        EXPECT_TABLE_EQ(join->get_output(), expected);
+      }
+    }
+  }
+}
+
+TEST_F(OperatorsJoinSortMergeTest, AllDataTypes) {
+  const auto expected_equals = load_table("src/test/tables/join_keys_equals.tbl", 3);
+  const auto expected_greater = load_table("src/test/tables/join_keys_greater.tbl", 3);
+  for (auto column_id = ColumnID{0}; column_id < 5; ++column_id) {
+    for (const auto& [scan_type, expected] :
+         {std::pair{ScanType::OpEquals, expected_equals}, std::pair{ScanType::OpGreaterThan, expected_greater}}) {
+      const auto join =
+          std::make_shared<JoinSortMerge>(wrap(_left), wrap(_right), column_id, column_id, scan_type, size_t{4});
+      join->execute();
+      EXPECT_TABLE_EQ(join->get_output(), expected);
+    }
+  }
+}
+
+TEST_F(OperatorsJoinSortMergeTest, OutputIsOrderedByLeftValue) {
+  const auto left = create_table("l", 200, 37, 101, 64);
+  const auto right = create_table("r", 100, 13, 50, 64);
+  const auto join = std::make_shared<JoinSortMerge>(wrap(left), wrap(right), ColumnID{0}, ColumnID{0},
+                                                    ScanType::OpLessThanEquals, size_t{8});
+  join->execute();
+  const auto output = join->get_output();
+  EXPECT_GT(output->row_count(), 0u);
+
+  auto previous_value = int32_t{0};
+  for (const auto& row : rows_of(*output)) {
+    const auto value = type_cast<int32_t>(row[0]);
+    EXPECT_LE(previous_value, value);
+    previous_value = value;
+  }
+}
+
+TEST_F(OperatorsJoinSortMergeTest, ReferenceInputs) {
+  const auto left_scan = std::make_shared<TableScan>(wrap(_left), ColumnID{5}, ScanType::OpGreaterThanEquals, 4);
+  left_scan->execute();
+  const auto right_scan = std::make_shared<TableScan>(wrap(_right), ColumnID{5}, ScanType::OpLessThan, 6);
+  right_scan->execute();
+
+  const auto join = std::make_shared<JoinSortMerge>(left_scan, right_scan, ColumnID{4}, ColumnID{4},
+                                                    ScanType::OpLessThan);
+  join->execute();
+  const auto output = join->get_output();
+  EXPECT_TABLE_EQ(output, load_table("src/test/tables/join_keys_less_filtered.tbl", 3));
+
+  // the output references the base tables, not the scan outputs.
+  const auto chunk = output->get_chunk(ChunkID{0});
+  EXPECT_EQ(std::dynamic_pointer_cast<const ReferenceSegment>(chunk->get_segment(ColumnID{0}))->referenced_table(),
+            _left);
+  EXPECT_EQ(std::dynamic_pointer_cast<const ReferenceSegment>(chunk->get_segment(ColumnID{6}))->referenced_table(),
+            _right);
+}
+
+TEST_F(OperatorsJoinSortMergeTest, EmptyInput) {
+  const auto empty = std::make_shared<Table>(_right);
+
+  for (const auto scan_type : SCAN_TYPES) {
+    for (const auto& [left_input, right_input] : {std::pair{_left, empty}, std::pair{empty, _left}}) {
+      const auto join =
+          std::make_shared<JoinSortMerge>(wrap(left_input), wrap(right_input), ColumnID{0}, ColumnID{0}, scan_type);
+      join->execute();
+      EXPECT_EQ(join->get_output()->row_count(), 0u);
+      EXPECT_EQ(join->get_output()->column_count(), 12u);
+    }
+  }
+}
+
+TEST_F(OperatorsJoinSortMergeTest, InvalidArguments) {
+  const auto table = wrap(load_table("src/test/tables/int_float.tbl", 2));
+  const auto join = std::make_shared<JoinSortMerge>(table, table, ColumnID{0}, ColumnID{1}, ScanType::OpEquals);
+  EXPECT_THROW(join->execute(), std::logic_error);
+  EXPECT_THROW(JoinSortMerge(table, table, ColumnID{0}, ColumnID{0}, ScanType::OpEquals, size_t{0}), std::logic_error);
+}
+
+}  // namespace opossum
@@ -0,0 +1,127 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "operators/pipeline.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "scheduler/operator_task.hpp"
+#include "scheduler/worker_pool.hpp"
+#include "storage/table.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class OperatorsPipelineTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    // chunks of 300 rows with different encodings and a partial last chunk.
+    auto table = std::make_shared<Table>(300);
+    table->add_column("a", "int");
+    table->add_column("b", "int");
+    table->add_column("c", "string");
+    for (auto index = int32_t{0}; index < 1000; ++index) {
+      table->append({index % 97, index / 10, "s" + std::to_string(index % 13)});
+    }
+    table->compress_chunk(ChunkID{1});
+    table->compress_chunk(ChunkID{2}, {SegmentEncodingSpec{EncodingType::RunLength},
+                                       SegmentEncodingSpec{EncodingType::FrameOfReference},
+                                       SegmentEncodingSpec{EncodingType::FrontCodedDictionary}});
+    _table_wrapper = std::make_shared<TableWrapper>(table);
+    _table_wrapper->execute();
+  }
+
+  // Creates a chain of three scans on top of the given input.
+  static std::vector<std::shared_ptr<AbstractPipelineOperator>> create_scans(
+      const std::shared_ptr<const AbstractOperator>& input) {
+    const auto scan_a = std::make_shared<TableScan>(input, ColumnID{0}, ScanType::OpLessThan, 60);
+    const auto scan_b = std::make_shared<TableScan>(scan_a, ColumnID{1}, ScanType::OpGreaterThanEquals, 15);
+    const auto scan_c = std::make_shared<TableScan>(scan_b, ColumnID{2}, ScanType::OpNotEquals, "s4");
+    return {scan_a, scan_b, scan_c};
+  }
+
+  static std::shared_ptr<const Table> execute_operator_at_a_time(
+      const std::vector<std::shared_ptr<AbstractPipelineOperator>>& scans) {
+    for (const auto& scan : scans) {
+      scan->execute();
+    }
+    return scans.back()->get_output();
+  }
+
+  std::shared_ptr<TableWrapper> _table_wrapper;
+};
+
+TEST_F(OperatorsPipelineTest, MatchesOperatorAtATime) {
+  const auto expected = execute_operator_at_a_time(create_scans(_table_wrapper));
+
+  for (const auto mode : {Pipeline::Mode::Morsels, Pipeline::Mode::Batches}) {
+    for (const auto morsel_size : {ChunkOffset{64}, ChunkOffset{128}, Pipeline::DEFAULT_MORSEL_SIZE}) {
+      const auto scans = create_scans(_table_wrapper);
+      const auto pipeline = std::make_shared<Pipeline>(scans, morsel_size, mode);
+      pipeline->execute();
+      EXPECT_TABLE_EQ(pipeline->get_output(), expected, true);
+      EXPECT_EQ(pipeline->get_output()->chunk_count(), expected->chunk_count());
+      EXPECT_EQ(scans.back()->get_output(), pipeline->get_output());
+    }
+  }
+}
+
+TEST_F(OperatorsPipelineTest, ReferenceInput) {
+  // the first scan keeps most rows as a bitmap, the second one few rows as offsets.
+  for (const auto search_value : {900, 100}) {
+    const auto input_scan =
+        std::make_shared<TableScan>(_table_wrapper, ColumnID{1}, ScanType::OpLessThan, search_value);
+    input_scan->execute();
+
+    const auto expected = execute_operator_at_a_time(create_scans(input_scan));
+    for (const auto mode : {Pipeline::Mode::Morsels, Pipeline::Mode::Batches}) {
+      const auto pipeline = std::make_shared<Pipeline>(create_scans(input_scan), ChunkOffset{64}, mode);
+      pipeline->execute();
+      EXPECT_TABLE_EQ(pipeline->get_output(), expected, true);
+    }
+  }
+}
+
+TEST_F(OperatorsPipelineTest, NoMatches) {
+  const auto scan_a = std::make_shared<TableScan>(_table_wrapper, ColumnID{0}, ScanType::OpLessThan, 60);
+  const auto scan_b = std::make_shared<TableScan>(scan_a, ColumnID{0}, ScanType::OpGreaterThan, 60);
+  const auto pipeline =
+      std::make_shared<Pipeline>(std::vector<std::shared_ptr<AbstractPipelineOperator>>{scan_a, scan_b});
+  pipeline->execute();
+  EXPECT_EQ(pipeline->get_output()->row_count(), 0u);
+  EXPECT_EQ(pipeline->get_output()->column_count(), 3u);
+}
+
+TEST_F(OperatorsPipelineTest, InvalidChain) {
+  const auto scans = create_scans(_table_wrapper);
+  EXPECT_THROW(Pipeline({scans[0], scans[2]}), std::logic_error);
+  EXPECT_THROW(Pipeline({}), std::logic_error);
+  EXPECT_THROW(Pipeline(create_scans(_table_wrapper), ChunkOffset{50}), std::logic_error);
+}
+
+TEST_F(OperatorsPipelineTest, OperatorTasksCreatePipelines) {
+  const auto scans = create_scans(_table_wrapper);
+  const auto expected = execute_operator_at_a_time(create_scans(_table_wrapper));
+
+  const auto tasks = OperatorTask::make_tasks_from_operator(scans.back(), OperatorTask::ExecutionMode::Pipelined);
+  ASSERT_EQ(tasks.size(), 2u);
+  const auto pipeline =
+      std::dynamic_pointer_cast<Pipeline>(std::static_pointer_cast<OperatorTask>(tasks[1])->get_operator());
+  ASSERT_TRUE(pipeline);
+  EXPECT_EQ(pipeline->operators(), scans);
+
+  WorkerPool::get().schedule_and_wait_for_tasks(tasks);
+  EXPECT_TABLE_EQ(scans.back()->get_output(), expected, true);
+}
+
+TEST_F(OperatorsPipelineTest, SingleOperatorIsNotPipelined) {
+  const auto scan = std::make_shared<TableScan>(_table_wrapper, ColumnID{0}, ScanType::OpLessThan, 60);
+  const auto tasks = OperatorTask::make_tasks_from_operator(scan, OperatorTask::ExecutionMode::Pipelined);
+  ASSERT_EQ(tasks.size(), 2u);
+  EXPECT_EQ(std::static_pointer_cast<OperatorTask>(tasks[1])->get_operator(), scan);
+}
+
+}  // namespace opossum
@@ -0,0 +1,131 @@
+#include <memory>
+#include <vector>
+
+#include "base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "operators/expression.hpp"
+#include "operators/projection.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "storage/reference_segment.hpp"
+#include "storage/table.hpp"
+#include "storage/value_segment.hpp"
+#include "types.hpp"
+#include "utils/load_table.hpp"
+
+namespace opossum {
+
+class OperatorsProjectionTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    // all chunks but the last one are dictionary-encoded.
+    _table = load_table("src/test/tables/int_long_double_string.tbl", 3);
+    for (auto chunk_id = ChunkID{0}; chunk_id + 1 < _table->chunk_count(); ++chunk_id) {
+      _table->compress_chunk(chunk_id);
+    }
+  }
+
+  static std::shared_ptr<const Table> project(const std::shared_ptr<const AbstractOperator>& input,
+                                              const std::vector<std::shared_ptr<const Expression>>& expressions) {
+    const auto projection = std::make_shared<Projection>(input, expressions);
+    projection->execute();
+    return projection->get_output();
+  }
+
+  const std::shared_ptr<const Expression> _a = Expression::column(ColumnID{0});
+  const std::shared_ptr<const Expression> _b = Expression::column(ColumnID{1});
+  const std::shared_ptr<const Expression> _c = Expression::column(ColumnID{2});
+  const std::shared_ptr<const Expression> _d = Expression::column(ColumnID{3});
+
+  std::shared_ptr<Table> _table = nullptr;
+};
+
+TEST_F(OperatorsProjectionTest, ComputedColumns) {
+  // the scan removes the row with a = 0, which the division by a would fail for.
+  const auto scan = std::make_shared<TableScan>(wrap(_table), ColumnID{0}, ScanType::OpGreaterThan, 0);
+  scan->execute();
+  const auto output =
+      project(scan, {Expression::arithmetic(ArithmeticOperator::Addition, _a, Expression::value(1)),
+                     Expression::arithmetic(ArithmeticOperator::Multiplication, _a, _b),
+                     Expression::arithmetic(ArithmeticOperator::Division, _c, Expression::value(2)),
+                     Expression::arithmetic(ArithmeticOperator::Division, Expression::value(1'000), _a),
+                     Expression::arithmetic(ArithmeticOperator::Subtraction, Expression::value(10),
+                                            Expression::value(4)),
+                     Expression::comparison(ScanType::OpLessThanEquals, _c, _a),
+                     Expression::comparison(ScanType::OpEquals, _d, Expression::value("d3")),
+                     Expression::case_when(Expression::comparison(ScanType::OpGreaterThan, _a, Expression::value(5)),
+                                           _c, Expression::arithmetic(ArithmeticOperator::Subtraction, _a, _c))});
+  EXPECT_TABLE_EQ(output, load_table("src/test/tables/projection_computed_columns.tbl", 3), true);
+
+  const auto value_segment =
+      std::dynamic_pointer_cast<const ValueSegment<int64_t>>(output->get_chunk(ChunkID{0})->get_segment(ColumnID{1}));
+  EXPECT_TRUE(value_segment);
+}
+
+TEST_F(OperatorsProjectionTest, ForwardsColumnsWithoutCopying) {
+  const auto output = project(wrap(_table), {_d, Expression::arithmetic(ArithmeticOperator::Addition, _a, _b), _a});
+  EXPECT_EQ(output->column_name(ColumnID{0}), "d");
+  EXPECT_EQ(output->column_type(ColumnID{0}), "string");
+  EXPECT_EQ(output->chunk_count(), 4u);
+  for (auto chunk_id = ChunkID{0}; chunk_id < output->chunk_count(); ++chunk_id) {
+    const auto chunk = output->get_chunk(chunk_id);
+    const auto d_segment = std::dynamic_pointer_cast<const ReferenceSegment>(chunk->get_segment(ColumnID{0}));
+    const auto a_segment = std::dynamic_pointer_cast<const ReferenceSegment>(chunk->get_segment(ColumnID{2}));
+    ASSERT_TRUE(d_segment && a_segment);
+    EXPECT_EQ(d_segment->referenced_table(), _table);
+    EXPECT_EQ(d_segment->referenced_column_id(), ColumnID{3});
+    EXPECT_EQ(a_segment->referenced_column_id(), ColumnID{0});
+    EXPECT_EQ(d_segment->pos_list(), a_segment->pos_list());
+    EXPECT_EQ(d_segment->size(), _table->get_chunk(chunk_id)->size());
+  }
+  EXPECT_EQ(rows_of(*output).back(), (std::vector<AllTypeVariant>{"d2", int64_t{4'000'000'009}, 9}));
+
+  // reference segments of the input are passed on as they are.
+  const auto scan = std::make_shared<TableScan>(wrap(_table), ColumnID{0}, ScanType::OpLessThan, 4);
+  scan->execute();
+  const auto scan_output = project(scan, {_c});
+  for (auto chunk_id = ChunkID{0}; chunk_id < scan_output->chunk_count(); ++chunk_id) {
+    EXPECT_EQ(scan_output->get_chunk(chunk_id)->get_segment(ColumnID{0}),
+              scan->get_output()->get_chunk(chunk_id)->get_segment(ColumnID{2}));
+  }
+  EXPECT_EQ(scan_output->row_count(), 4u);
+}
+
+TEST_F(OperatorsProjectionTest, CaseGuardsDivisionByZero) {
+  const auto table = wrap(_table);
+  const auto division = Expression::arithmetic(ArithmeticOperator::Division, _a, _b);
+  EXPECT_THROW(project(table, {division}), std::logic_error);
+
+  const auto guarded_division =
+      Expression::case_when(Expression::comparison(ScanType::OpNotEquals, _b, Expression::value(int64_t{0})), division,
+                            Expression::value(-1));
+  EXPECT_TABLE_EQ(project(table, {guarded_division}), load_table("src/test/tables/projection_guarded_division.tbl", 3),
+                  true);
+
+  // floating-point division by zero does not fail.
+  EXPECT_NO_THROW(project(table, {Expression::arithmetic(ArithmeticOperator::Division, _c, _b)}));
+}
+
+TEST_F(OperatorsProjectionTest, EmptyInput) {
+  const auto output = project(wrap(std::make_shared<Table>(_table)),
+                              {_a, Expression::arithmetic(ArithmeticOperator::Addition, _a, _c)});
+  EXPECT_EQ(output->row_count(), 0u);
+  EXPECT_EQ(output->column_count(), 2u);
+  EXPECT_EQ(output->column_type(ColumnID{1}), "double");
+}
+
+TEST_F(OperatorsProjectionTest, InvalidExpressions) {
+  const auto table = wrap(_table);
+  EXPECT_THROW(Projection(table, {}), std::logic_error);
+  for (const auto& expression :
+       {Expression::column(ColumnID{4}), Expression::arithmetic(ArithmeticOperator::Addition, _d, _a),
+        Expression::comparison(ScanType::OpEquals, _d, _a), Expression::case_when(_c, _a, _b),
+        Expression::case_when(_a, _a, _d)}) {
+    const auto projection =
+        std::make_shared<Projection>(table, std::vector<std::shared_ptr<const Expression>>{expression});
+    EXPECT_THROW(projection->execute(), std::logic_error);
+  }
+}
+
+}  // namespace opossum
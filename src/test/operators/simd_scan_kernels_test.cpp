@@ -0,0 +1,125 @@
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "operators/simd_scan_kernels.hpp"
+#include "type_comparison.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class OperatorsSimdScanKernelsTest : public BaseTest {
+ protected:
+  // Compares the result of each supported SIMD level against a straightforward scalar evaluation for all scan types.
+  template <typename T>
+  void test_all_levels(const std::vector<T>& values, const T search_value) {
+    auto simd_levels = std::vector<SimdLevel>{SimdLevel::Scalar};
+    if (detected_simd_level() >= SimdLevel::AVX2) simd_levels.push_back(SimdLevel::AVX2);
+    if (detected_simd_level() >= SimdLevel::AVX512) simd_levels.push_back(SimdLevel::AVX512);
+
+    for (const auto scan_type : {ScanType::OpEquals, ScanType::OpNotEquals, ScanType::OpLessThan,
+                                 ScanType::OpLessThanEquals, ScanType::OpGreaterThan, ScanType::OpGreaterThanEquals}) {
+      auto expected_offsets = std::vector<ChunkOffset>{};
+      with_comparator(scan_type, [&](const auto& comparator) {
+        for (auto offset = ChunkOffset{0}; offset < values.size(); ++offset) {
+          if (comparator(values[offset], search_value)) expected_offsets.push_back(offset);
+        }
+      });
+
+      for (const auto simd_level : simd_levels) {
+        // Fill the bitmask with garbage to check that the kernels overwrite all words.
+        auto bitmask = std::vector<uint64_t>(bitmask_word_count(values.size()), ~uint64_t{0});
+        compare_to_bitmask(values.data(), values.size(), scan_type, search_value, bitmask.data(), simd_level);
+
+        auto offsets = std::vector<ChunkOffset>{};
+        append_matching_offsets(bitmask.data(), values.size(), offsets);
+        EXPECT_EQ(offsets, expected_offsets) << "scan type " << static_cast<int>(scan_type) << ", SIMD level "
+                                             << static_cast<int>(simd_level);
+      }
+    }
+  }
+
+  // Creates a sequence of values that does not fill the last bitmask word so that the scalar tail is tested as well.
+  template <typename T>
+  std::vector<T> create_values(const size_t value_count, const T modulo) {
+    auto values = std::vector<T>(value_count);
+    for (auto index = size_t{0}; index < value_count; ++index) {
+      values[index] = static_cast<T>(static_cast<T>(index * 7) % modulo);
+    }
+    return values;
+  }
+};
+
+TEST_F(OperatorsSimdScanKernelsTest, SignedIntegers) {
+  auto int_values = create_values<int32_t>(1000, 100);
+  int_values[3] = std::numeric_limits<int32_t>::min();
+  int_values[4] = std::numeric_limits<int32_t>::max();
+  test_all_levels<int32_t>(int_values, 42);
+  test_all_levels<int32_t>(int_values, -1);
+
+  auto long_values = create_values<int64_t>(1000, 100);
+  long_values[5] = std::numeric_limits<int64_t>::min();
+  long_values[6] = std::numeric_limits<int64_t>::max();
+  test_all_levels<int64_t>(long_values, 42);
+  test_all_levels<int64_t>(long_values, 1'000'000'000'000);
+}
+
+TEST_F(OperatorsSimdScanKernelsTest, FloatingPoint) {
+  auto float_values = std::vector<float>{};
+  auto double_values = std::vector<double>{};
+  for (auto index = 0; index < 999; ++index) {
+    float_values.push_back(static_cast<float>(index % 50) - 10.5f);
+    double_values.push_back(static_cast<double>(index % 50) - 10.5);
+  }
+  // NaN only satisfies OpNotEquals, just like the scalar comparison.
+  float_values[17] = std::nanf("");
+  double_values[17] = std::nan("");
+
+  test_all_levels<float>(float_values, 3.5f);
+  test_all_levels<double>(double_values, 3.5);
+}
+
+TEST_F(OperatorsSimdScanKernelsTest, UnsignedCodes) {
+  // The values cover the full range of each type to check that the kernels do not compare as signed integers.
+  test_all_levels<uint8_t>(create_values<uint8_t>(1001, 255), 200);
+  test_all_levels<uint8_t>(create_values<uint8_t>(1001, 255), 3);
+  test_all_levels<uint16_t>(create_values<uint16_t>(1001, 65535), 40000);
+  test_all_levels<uint16_t>(create_values<uint16_t>(1001, 65535), 3);
+
+  auto code_values = create_values<uint32_t>(1001, 1000);
+  code_values[8] = std::numeric_limits<uint32_t>::max();
+  test_all_levels<uint32_t>(code_values, 3'000'000'000);
+  test_all_levels<uint32_t>(code_values, 3);
+}
+
+TEST_F(OperatorsSimdScanKernelsTest, EmptyAndShortInput) {
+  test_all_levels<int32_t>({}, 1);
+  test_all_levels<int32_t>({1, 2, 3}, 2);
+  test_all_levels<uint8_t>(create_values<uint8_t>(64, 10), 5);
+}
+
+TEST_F(OperatorsSimdScanKernelsTest, BitmaskToSelection) {
+  // with search value 13, all rows match, so the last byte writes the last entries of the selection buffer.
+  for (const auto value_count : {size_t{4'000}, size_t{1'001}, size_t{3}}) {
+    const auto values = create_values<int32_t>(value_count, 13);
+    for (const auto search_value : {0, 6, 13}) {
+      auto bitmask = std::vector<uint64_t>(bitmask_word_count(values.size()));
+      compare_to_bitmask(values.data(), values.size(), ScanType::OpLessThan, search_value, bitmask.data());
+      auto offsets = std::vector<ChunkOffset>{};
+      append_matching_offsets(bitmask.data(), values.size(), offsets);
+
+      auto selection = std::vector<uint16_t>(selection_buffer_size(values.size()));
+      selection.resize(bitmask_to_selection(bitmask.data(), values.size(), selection.data(), selection.size()));
+      EXPECT_EQ(std::vector<ChunkOffset>(selection.cbegin(), selection.cend()), offsets);
+    }
+  }
+  EXPECT_EQ(selection_buffer_size(3), 11u);
+  EXPECT_EQ(selection_buffer_size(64), 64u);
+  EXPECT_EQ(selection_buffer_size(1'001), 1'009u);
+}
+
+}  // namespace opossum
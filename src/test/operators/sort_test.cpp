@@ -0,0 +1,137 @@
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "operators/sort.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "storage/reference_segment.hpp"
+#include "storage/table.hpp"
+#include "types.hpp"
+#include "utils/load_table.hpp"
+
+namespace opossum {
+
+class OperatorsSortTest : public BaseTest {
+ protected:
+  void SetUp() override { _table = load_table("src/test/tables/sort_input.tbl", 5); }
+
+  // Creates a table with an int column "a" with few distinct values, a string column "b" whose values are prefixes of
+  // each other or contain zero bytes, a long column "c", a float column "d" with negative numbers and zeros of both
+  // signs, and a double column "e" that holds the row index. Unlike sort_input.tbl, it has enough rows to fill several
+  // output chunks and values that a .tbl file cannot hold.
+  static std::shared_ptr<Table> create_table(const int32_t row_count, const ChunkOffset chunk_size) {
+    auto table = std::make_shared<Table>(chunk_size);
+    table->add_column("a", "int");
+    table->add_column("b", "string");
+    table->add_column("c", "long");
+    table->add_column("d", "float");
+    table->add_column("e", "double");
+    const auto strings = std::vector<std::string>{"", "a", "ab", std::string{"a\0b", 3}, std::string{"a\0", 2}, "b",
+                                                  "B", "abc"};
+    for (auto index = int32_t{0}; index < row_count; ++index) {
+      const auto zero = index % 2 == 0 ? 0.0f : -0.0f;
+      table->append({index % 5 - 2, strings[index * 7 % strings.size()], int64_t{index * 7919 % 101} - 50,
+                     index % 3 == 0 ? zero : static_cast<float>(index % 13) - 6.5f, static_cast<double>(index)});
+    }
+    return table;
+  }
+
+  // Sorts the rows of the table with a stable sort that compares the values as AllTypeVariants.
+  static std::shared_ptr<Table> sort_rows(const std::shared_ptr<const Table>& table,
+                                          const std::vector<SortColumnDefinition>& definitions) {
+    auto rows = rows_of(*table);
+    std::stable_sort(rows.begin(), rows.end(), [&](const auto& lhs, const auto& rhs) {
+      for (const auto& definition : definitions) {
+        const auto& left_value = lhs[definition.column_id];
+        const auto& right_value = rhs[definition.column_id];
+        if (left_value == right_value) continue;
+        return (left_value < right_value) == (definition.sort_mode == SortMode::Ascending);
+      }
+      return false;
+    });
+
+    return table_from_rows(column_definitions_of(*table), rows);
+  }
+
+  std::shared_ptr<Table> _table = nullptr;
+};
+
+TEST_F(OperatorsSortTest, SingleColumn) {
+  const auto table = create_table(200, 64);
+  table->compress_chunk(ChunkID{1});
+  for (auto column_id = ColumnID{0}; column_id < table->column_count(); ++column_id) {
+    for (const auto sort_mode : {SortMode::Ascending, SortMode::Descending}) {
+      const auto definitions = std::vector<SortColumnDefinition>{{column_id, sort_mode}};
+      const auto sort = std::make_shared<Sort>(wrap(table), definitions);
+      sort->execute();
+      EXPECT_TABLE_EQ(sort->get_output(), sort_rows(table, definitions), true);
+    }
+  }
+}
+
+TEST_F(OperatorsSortTest, MultipleColumns) {
+  const auto table = create_table(300, 100);
+  table->compress_chunk(ChunkID{0});
+  const auto definition_lists = std::vector<std::vector<SortColumnDefinition>>{
+      {{ColumnID{0}}, {ColumnID{1}}},
+      {{ColumnID{1}, SortMode::Descending}, {ColumnID{0}}, {ColumnID{3}, SortMode::Descending}},
+      {{ColumnID{3}}, {ColumnID{2}, SortMode::Descending}},
+      {{ColumnID{0}, SortMode::Descending}, {ColumnID{1}}, {ColumnID{2}}, {ColumnID{4}, SortMode::Descending}}};
+  for (const auto& definitions : definition_lists) {
+    const auto sort = std::make_shared<Sort>(wrap(table), definitions, ChunkOffset{70});
+    sort->execute();
+    const auto output = sort->get_output();
+    EXPECT_TABLE_EQ(output, sort_rows(table, definitions), true);
+    EXPECT_EQ(output->chunk_count(), 5u);
+    EXPECT_EQ(output->get_chunk(ChunkID{4})->size(), 20u);
+  }
+}
+
+TEST_F(OperatorsSortTest, ReferenceInput) {
+  _table->compress_chunk(ChunkID{0});
+  const auto table_scan = std::make_shared<TableScan>(wrap(_table), ColumnID{2}, ScanType::OpGreaterThan, 0);
+  table_scan->execute();
+
+  const auto definitions = std::vector<SortColumnDefinition>{{ColumnID{1}}, {ColumnID{2}, SortMode::Descending}};
+  const auto sort = std::make_shared<Sort>(table_scan, definitions);
+  sort->execute();
+  const auto output = sort->get_output();
+  EXPECT_TABLE_EQ(output, load_table("src/test/tables/sort_input_filtered_sorted_by_b_c_desc.tbl", 5), true);
+
+  // the output references the base table, not the scan output.
+  const auto reference_segment =
+      std::dynamic_pointer_cast<const ReferenceSegment>(output->get_chunk(ChunkID{0})->get_segment(ColumnID{0}));
+  ASSERT_TRUE(reference_segment);
+  EXPECT_EQ(reference_segment->referenced_table(), _table);
+}
+
+TEST_F(OperatorsSortTest, IsStable) {
+  // rows with equal values in a keep the order of e, i.e., of the input.
+  _table->compress_chunk(ChunkID{1});
+  const auto sort = std::make_shared<Sort>(wrap(_table), std::vector<SortColumnDefinition>{{ColumnID{0}}});
+  sort->execute();
+  EXPECT_TABLE_EQ(sort->get_output(), load_table("src/test/tables/sort_input_sorted_by_a.tbl", 5), true);
+}
+
+TEST_F(OperatorsSortTest, EmptyInput) {
+  const auto sort = std::make_shared<Sort>(wrap(std::make_shared<Table>(_table)),
+                                           std::vector<SortColumnDefinition>{{ColumnID{1}}});
+  sort->execute();
+  EXPECT_EQ(sort->get_output()->row_count(), 0u);
+  EXPECT_EQ(sort->get_output()->column_count(), 5u);
+}
+
+TEST_F(OperatorsSortTest, InvalidArguments) {
+  const auto table = wrap(_table);
+  EXPECT_THROW(Sort(table, {}), std::logic_error);
+  EXPECT_THROW(Sort(table, {{ColumnID{0}}}, ChunkOffset{0}), std::logic_error);
+  const auto sort = std::make_shared<Sort>(table, std::vector<SortColumnDefinition>{{ColumnID{5}}});
+  EXPECT_THROW(sort->execute(), std::logic_error);
+}
+
+}  // namespace opossum
@@ -2,7 +2,9 @@
 #include <iostream>
 #include <map>
 #include <memory>
+#include <numeric>
 #include <optional>
+#include <random>
 #include <string>
 #include <utility>
 #include <vector>
@@ -14,7 +16,10 @@
 #include "operators/table_scan.hpp"
 #include "operators/table_wrapper.hpp"
 #include "storage/reference_segment.hpp"
+#include "storage/run_length_segment.hpp"
 #include "storage/table.hpp"
+#include "type_cast.hpp"
+#include "type_comparison.hpp"
 #include "types.hpp"
 #include "utils/load_table.hpp"
 
@@ -240,6 +245,69 @@ TEST_F(OperatorsTableScanTest, ScanOnDictColumnAroundBounds) {
   }
 }
 
+TEST_F(OperatorsTableScanTest, ScanOnDictColumnWithSingleValue) {
+  // All rows of the chunk share the same value id, so the scan decides on the whole chunk at once.
+  auto table = std::make_shared<Table>(5);
+  table->add_column("a", "int");
+  table->add_column("b", "int");
+  for (auto index = int32_t{0}; index < 5; ++index) {
+    table->append({7, index});
+  }
+  table->compress_chunk(ChunkID{0});
+
+  auto table_wrapper = std::make_shared<TableWrapper>(std::move(table));
+  table_wrapper->execute();
+
+  const auto all_rows = std::vector<AllTypeVariant>{0, 1, 2, 3, 4};
+  const auto no_rows = std::vector<AllTypeVariant>{};
+
+  auto tests = std::map<ScanType, std::vector<AllTypeVariant>>{};
+  tests[ScanType::OpEquals] = all_rows;
+  tests[ScanType::OpNotEquals] = no_rows;
+  tests[ScanType::OpLessThan] = no_rows;
+  tests[ScanType::OpLessThanEquals] = all_rows;
+  tests[ScanType::OpGreaterThan] = no_rows;
+  tests[ScanType::OpGreaterThanEquals] = all_rows;
+
+  for (const auto& test : tests) {
+    auto scan = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, test.first, 7);
+    scan->execute();
+
+    ASSERT_COLUMN_EQ(scan->get_output(), ColumnID{1}, test.second);
+  }
+}
+
+TEST_F(OperatorsTableScanTest, ScanOnBitPackedDictColumn) {
+  // 300 distinct values are stored with 9 bits per value id. 1000 rows span several blocks of the BitPackedVector.
+  auto table = std::make_shared<Table>(1000);
+  table->add_column("a", "int");
+  for (auto index = int32_t{0}; index < 1000; ++index) {
+    table->append({index % 300});
+  }
+  const auto chunk = table->get_chunk(ChunkID{0});
+  chunk->insert_segment_at(std::make_shared<DictionarySegment<int32_t>>(chunk->get_segment(ColumnID{0}),
+                                                                        VectorCompressionType::BitPacking),
+                           ColumnID{0});
+
+  auto table_wrapper = std::make_shared<TableWrapper>(std::move(table));
+  table_wrapper->execute();
+
+  // Values 0 to 99 occur four times, all others three times.
+  auto tests = std::map<ScanType, size_t>{};
+  tests[ScanType::OpEquals] = 3;
+  tests[ScanType::OpNotEquals] = 997;
+  tests[ScanType::OpLessThan] = 100 * 4 + 50 * 3;
+  tests[ScanType::OpLessThanEquals] = 100 * 4 + 51 * 3;
+  tests[ScanType::OpGreaterThan] = 149 * 3;
+  tests[ScanType::OpGreaterThanEquals] = 150 * 3;
+
+  for (const auto& [scan_type, expected_row_count] : tests) {
+    auto scan = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, scan_type, 150);
+    scan->execute();
+    EXPECT_EQ(scan->get_output()->row_count(), expected_row_count);
+  }
+}
+
 TEST_F(OperatorsTableScanTest, ScanWithEmptyInput) {
   auto scan_1 = std::make_shared<opossum::TableScan>(_table_wrapper, ColumnID{0}, ScanType::OpGreaterThan, 12345);
   scan_1->execute();
@@ -269,4 +337,408 @@ TEST_F(OperatorsTableScanTest, ScanOnWideDictionarySegment) {
   EXPECT_EQ(scan_2->get_output()->row_count(), static_cast<size_t>(37));
 }
 
+TEST_F(OperatorsTableScanTest, ScanOutputSharesSingleChunkPosLists) {
+  auto scan_1 = std::make_shared<TableScan>(_table_wrapper, ColumnID{0}, ScanType::OpGreaterThanEquals, 1234);
+  scan_1->execute();
+  auto scan_2 = std::make_shared<TableScan>(scan_1, ColumnID{1}, ScanType::OpLessThan, 457.9);
+  scan_2->execute();
+
+  // The segments of each output chunk share one position list, which only stores the offsets in the input chunk.
+  for (const auto& output : {scan_1->get_output(), scan_2->get_output()}) {
+    for (auto chunk_id = ChunkID{0}; chunk_id < output->chunk_count(); ++chunk_id) {
+      const auto chunk = output->get_chunk(chunk_id);
+      const auto pos_list =
+          std::dynamic_pointer_cast<const ReferenceSegment>(chunk->get_segment(ColumnID{0}))->pos_list();
+      EXPECT_TRUE(pos_list->references_single_chunk());
+      EXPECT_EQ(std::dynamic_pointer_cast<const ReferenceSegment>(chunk->get_segment(ColumnID{1}))->pos_list(),
+                pos_list);
+    }
+  }
+}
+
+TEST_F(OperatorsTableScanTest, ScanWithBitmaps) {
+  // Scans with many matches produce bitmaps, which later scans combine with the matches in the referenced chunks.
+  // Column c numbers the rows. The first chunk is dictionary-encoded.
+  constexpr auto CHUNK_SIZE = 1000;
+  auto table = std::make_shared<Table>(CHUNK_SIZE);
+  table->add_column("a", "int");
+  table->add_column("b", "int");
+  table->add_column("c", "int");
+  for (auto index = int32_t{0}; index < 2 * CHUNK_SIZE; ++index) {
+    table->append({index % 10, index % 7, index});
+  }
+  table->compress_chunk(ChunkID{0});
+
+  auto table_wrapper = std::make_shared<TableWrapper>(std::move(table));
+  table_wrapper->execute();
+
+  const auto row_numbers = [](const std::shared_ptr<const Table>& output) {
+    auto values = std::vector<int32_t>{};
+    for (auto chunk_id = ChunkID{0}; chunk_id < output->chunk_count(); ++chunk_id) {
+      const auto segment = output->get_chunk(chunk_id)->get_segment(ColumnID{2});
+      for (auto chunk_offset = ChunkOffset{0}; chunk_offset < segment->size(); ++chunk_offset) {
+        values.push_back(type_cast<int32_t>((*segment)[chunk_offset]));
+      }
+    }
+    return values;
+  };
+  const auto expected_row_numbers = [](const auto& predicate) {
+    auto values = std::vector<int32_t>{};
+    for (auto index = int32_t{0}; index < 2 * CHUNK_SIZE; ++index) {
+      if (predicate(index)) values.push_back(index);
+    }
+    return values;
+  };
+  const auto pos_list_of = [](const std::shared_ptr<const Table>& output, const ChunkID chunk_id) {
+    return std::dynamic_pointer_cast<const ReferenceSegment>(output->get_chunk(chunk_id)->get_segment(ColumnID{0}))
+        ->pos_list();
+  };
+
+  auto scan_1 = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, ScanType::OpGreaterThanEquals, 2);
+  scan_1->execute();
+  EXPECT_EQ(row_numbers(scan_1->get_output()), expected_row_numbers([](const auto row) { return row % 10 >= 2; }));
+  EXPECT_TRUE(pos_list_of(scan_1->get_output(), ChunkID{0})->is_bitmap());
+  EXPECT_TRUE(pos_list_of(scan_1->get_output(), ChunkID{1})->is_bitmap());
+
+  auto scan_2 = std::make_shared<TableScan>(scan_1, ColumnID{1}, ScanType::OpLessThan, 4);
+  scan_2->execute();
+  EXPECT_EQ(row_numbers(scan_2->get_output()),
+            expected_row_numbers([](const auto row) { return row % 10 >= 2 && row % 7 < 4; }));
+  EXPECT_TRUE(pos_list_of(scan_2->get_output(), ChunkID{1})->is_bitmap());
+
+  // Few rows match, so the output stores offsets.
+  auto scan_3 = std::make_shared<TableScan>(scan_2, ColumnID{2}, ScanType::OpLessThan, 100);
+  scan_3->execute();
+  EXPECT_EQ(row_numbers(scan_3->get_output()),
+            expected_row_numbers([](const auto row) { return row % 10 >= 2 && row % 7 < 4 && row < 100; }));
+  EXPECT_FALSE(pos_list_of(scan_3->get_output(), ChunkID{0})->is_bitmap());
+
+  // The statistics of the referenced chunks decide the following scans without looking at the rows.
+  auto scan_4 = std::make_shared<TableScan>(scan_2, ColumnID{2}, ScanType::OpGreaterThanEquals, 0);
+  scan_4->execute();
+  EXPECT_EQ(pos_list_of(scan_4->get_output(), ChunkID{0}), pos_list_of(scan_2->get_output(), ChunkID{0}));
+  auto scan_5 = std::make_shared<TableScan>(scan_2, ColumnID{2}, ScanType::OpGreaterThanEquals, 1000);
+  scan_5->execute();
+  EXPECT_EQ(scan_5->get_output()->chunk_count(), 1u);
+
+  // Scans on offsets of a bitmap, i.e., on reference segments with different position lists, read the bitmap.
+  auto scan_6 = std::make_shared<TableScan>(scan_3, ColumnID{0}, ScanType::OpEquals, 5);
+  scan_6->execute();
+  EXPECT_EQ(row_numbers(scan_6->get_output()),
+            expected_row_numbers([](const auto row) { return row % 10 == 5 && row % 7 < 4 && row < 100; }));
+}
+
+TEST_F(OperatorsTableScanTest, ScanPrunesChunksByStatistics) {
+  // Column a is ordered like a timestamp, so each chunk covers a distinct range. Odd chunks stay uncompressed, so
+  // their statistics are computed from the value segments.
+  auto table = std::make_shared<Table>(10);
+  table->add_column("a", "int");
+  table->add_column("b", "int");
+  for (auto index = int32_t{0}; index < 100; ++index) {
+    table->append({index, index % 7});
+  }
+  for (auto chunk_id = ChunkID{0}; chunk_id < table->chunk_count(); chunk_id += 2) {
+    table->compress_chunk(chunk_id);
+  }
+
+  auto table_wrapper = std::make_shared<TableWrapper>(std::move(table));
+  table_wrapper->execute();
+
+  // Only the chunks from 73 on can contain matches. The chunks from 80 on match completely.
+  auto scan = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, ScanType::OpGreaterThanEquals, 73);
+  scan->execute();
+  const auto output = scan->get_output();
+  ASSERT_EQ(output->chunk_count(), 3u);
+  EXPECT_EQ(output->get_chunk(ChunkID{0})->size(), 7u);
+  EXPECT_EQ(output->get_chunk(ChunkID{1})->size(), 10u);
+  EXPECT_EQ(output->get_chunk(ChunkID{2})->size(), 10u);
+
+  auto row_numbers = std::vector<int32_t>{};
+  for (auto chunk_id = ChunkID{0}; chunk_id < output->chunk_count(); ++chunk_id) {
+    const auto segment = output->get_chunk(chunk_id)->get_segment(ColumnID{0});
+    for (auto offset = ChunkOffset{0}; offset < segment->size(); ++offset) {
+      row_numbers.push_back(type_cast<int32_t>((*segment)[offset]));
+    }
+  }
+  auto expected_row_numbers = std::vector<int32_t>(27);
+  std::iota(expected_row_numbers.begin(), expected_row_numbers.end(), 73);
+  EXPECT_EQ(row_numbers, expected_row_numbers);
+
+  // Reference segments have no statistics, so a scan on the output scans all of its chunks.
+  auto scan_on_reference = std::make_shared<TableScan>(scan, ColumnID{0}, ScanType::OpLessThan, 75);
+  scan_on_reference->execute();
+  EXPECT_EQ(scan_on_reference->get_output()->row_count(), 2u);
+
+  auto empty_scan = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, ScanType::OpEquals, 100);
+  empty_scan->execute();
+  EXPECT_EQ(empty_scan->get_output()->row_count(), 0u);
+}
+
+TEST_F(OperatorsTableScanTest, ScanOnRunLengthColumn) {
+  // Column a consists of runs of different lengths, column b numbers the rows. The first chunk is run-length encoded,
+  // the second one is not encoded, so both have to yield the same results for their rows.
+  auto table = std::make_shared<Table>(20);
+  table->add_column("a", "int");
+  table->add_column("b", "int");
+  const auto run_values = std::vector<int32_t>{5, 5, 5, 1, 9, 9, 5, 5, 2, 2, 2, 2, 2, 7, 7, 7, 1, 1, 1, 3};
+  for (auto repetition = 0; repetition < 2; ++repetition) {
+    for (auto index = int32_t{0}; index < 20; ++index) {
+      table->append({run_values[index], index});
+    }
+  }
+  table->compress_chunk(ChunkID{0}, {SegmentEncodingSpec{EncodingType::RunLength}, SegmentEncodingSpec{}});
+  ASSERT_TRUE(std::dynamic_pointer_cast<RunLengthSegment<int32_t>>(
+      table->get_chunk(ChunkID{0})->get_segment(ColumnID{0})));
+
+  auto table_wrapper = std::make_shared<TableWrapper>(std::move(table));
+  table_wrapper->execute();
+
+  for (const auto scan_type : {ScanType::OpEquals, ScanType::OpNotEquals, ScanType::OpLessThan,
+                               ScanType::OpLessThanEquals, ScanType::OpGreaterThan, ScanType::OpGreaterThanEquals}) {
+    auto expected = std::vector<AllTypeVariant>{};
+    with_comparator(scan_type, [&](const auto& comparator) {
+      for (auto index = int32_t{0}; index < 20; ++index) {
+        if (comparator(run_values[index], 5)) {
+          expected.emplace_back(index);
+          expected.emplace_back(index);
+        }
+      }
+    });
+
+    auto scan = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, scan_type, 5);
+    scan->execute();
+    ASSERT_COLUMN_EQ(scan->get_output(), ColumnID{1}, expected);
+
+    // The second scan reads the run-length segment through reference segments.
+    auto scan_on_reference = std::make_shared<TableScan>(scan, ColumnID{0}, scan_type, 5);
+    scan_on_reference->execute();
+    ASSERT_COLUMN_EQ(scan_on_reference->get_output(), ColumnID{1}, expected);
+  }
+}
+
+TEST_F(OperatorsTableScanTest, ScanOnFrameOfReferenceColumn) {
+  // Column a holds increasing keys in the first half of each chunk and random values in the second half, column b
+  // numbers the rows. The first chunk is encoded, the second one is not, so both yield the same results.
+  constexpr auto CHUNK_SIZE = 5000;
+  auto generator = std::mt19937{42};
+  auto distribution = std::uniform_int_distribution<int64_t>{0, 3000};
+  auto values = std::vector<int64_t>(CHUNK_SIZE);
+  for (auto index = 0; index < CHUNK_SIZE; ++index) {
+    values[index] = index < CHUNK_SIZE / 2 ? index / 2 : distribution(generator);
+  }
+
+  for (const auto encoding_type : {EncodingType::FrameOfReference, EncodingType::FrameOfReferenceDelta}) {
+    auto table = std::make_shared<Table>(CHUNK_SIZE);
+    table->add_column("a", "long");
+    table->add_column("b", "int");
+    for (auto repetition = 0; repetition < 2; ++repetition) {
+      for (auto index = int32_t{0}; index < CHUNK_SIZE; ++index) {
+        table->append({values[index], index});
+      }
+    }
+    table->compress_chunk(ChunkID{0}, {SegmentEncodingSpec{encoding_type}, SegmentEncodingSpec{}});
+
+    auto table_wrapper = std::make_shared<TableWrapper>(std::move(table));
+    table_wrapper->execute();
+
+    // The search values are below, within, and above the values of the blocks.
+    for (const auto search_value :
+         {int64_t{-1}, int64_t{0}, int64_t{700}, int64_t{1500}, int64_t{2999}, int64_t{4000}}) {
+      for (const auto scan_type : {ScanType::OpEquals, ScanType::OpNotEquals, ScanType::OpLessThan,
+                                   ScanType::OpLessThanEquals, ScanType::OpGreaterThan,
+                                   ScanType::OpGreaterThanEquals}) {
+        auto expected = std::vector<int32_t>{};
+        with_comparator(scan_type, [&](const auto& comparator) {
+          for (auto index = int32_t{0}; index < CHUNK_SIZE; ++index) {
+            if (comparator(values[index], search_value)) {
+              expected.push_back(index);
+              expected.push_back(index);
+            }
+          }
+        });
+        std::sort(expected.begin(), expected.end());
+
+        // ASSERT_COLUMN_EQ is quadratic in the number of rows, so the sorted row numbers are compared instead.
+        auto scan = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, scan_type, search_value);
+        scan->execute();
+        const auto output = scan->get_output();
+        auto row_numbers = std::vector<int32_t>{};
+        for (auto chunk_id = ChunkID{0}; chunk_id < output->chunk_count(); ++chunk_id) {
+          const auto segment = output->get_chunk(chunk_id)->get_segment(ColumnID{1});
+          for (auto chunk_offset = ChunkOffset{0}; chunk_offset < segment->size(); ++chunk_offset) {
+            row_numbers.push_back(type_cast<int32_t>((*segment)[chunk_offset]));
+          }
+        }
+        std::sort(row_numbers.begin(), row_numbers.end());
+        ASSERT_EQ(row_numbers, expected);
+      }
+    }
+
+    // Scans over reference segments read the frame-of-reference segment value by value.
+    auto scan_1 = std::make_shared<TableScan>(table_wrapper, ColumnID{1}, ScanType::OpLessThan, 4);
+    scan_1->execute();
+    auto scan_2 = std::make_shared<TableScan>(scan_1, ColumnID{0}, ScanType::OpEquals, 1);
+    scan_2->execute();
+    ASSERT_COLUMN_EQ(scan_2->get_output(), ColumnID{1}, {2, 2, 3, 3});
+  }
+}
+
+TEST_F(OperatorsTableScanTest, ScanOnReferenceSegmentsWithMixedRuns) {
+  // The positions alternate between short runs, which are read through accessors, and long runs, which are scanned
+  // with the kernel of the referenced segment. Column b numbers the rows of the referenced table.
+  constexpr auto CHUNK_SIZE = 3000;
+  auto table = std::make_shared<Table>(CHUNK_SIZE);
+  table->add_column("a", "int");
+  table->add_column("b", "int");
+  auto values = std::vector<int32_t>{};
+  for (auto index = int32_t{0}; index < 5 * CHUNK_SIZE; ++index) {
+    values.push_back((index / 3) % 100);
+    table->append({values.back(), index});
+  }
+  table->compress_chunk(ChunkID{0}, {SegmentEncodingSpec{EncodingType::Dictionary}, SegmentEncodingSpec{}});
+  table->compress_chunk(ChunkID{1}, {SegmentEncodingSpec{EncodingType::RunLength}, SegmentEncodingSpec{}});
+  table->compress_chunk(ChunkID{2}, {SegmentEncodingSpec{EncodingType::FrameOfReference}, SegmentEncodingSpec{}});
+  table->compress_chunk(ChunkID{3}, {SegmentEncodingSpec{EncodingType::FrameOfReferenceDelta}, SegmentEncodingSpec{}});
+
+  auto generator = std::mt19937{42};
+  auto chunk_distribution = std::uniform_int_distribution<uint32_t>{0, 4};
+  auto offset_distribution = std::uniform_int_distribution<ChunkOffset>{0, CHUNK_SIZE - 1};
+  const auto pos_list = std::make_shared<PosList>();
+  for (auto run_index = 0; run_index < 40; ++run_index) {
+    const auto chunk_id = ChunkID{chunk_distribution(generator)};
+    const auto run_length = run_index % 2 == 0 ? 3 : 500;
+    for (auto index = 0; index < run_length; ++index) {
+      pos_list->emplace_back(RowID{chunk_id, offset_distribution(generator)});
+    }
+  }
+
+  const auto chunk = std::make_shared<Chunk>();
+  chunk->add_segment(std::make_shared<ReferenceSegment>(table, ColumnID{0}, pos_list));
+  chunk->add_segment(std::make_shared<ReferenceSegment>(table, ColumnID{1}, pos_list));
+  auto table_wrapper =
+      std::make_shared<TableWrapper>(std::make_shared<Table>(std::vector<std::shared_ptr<Chunk>>{chunk}, table));
+  table_wrapper->execute();
+
+  for (const auto search_value : {-1, 0, 17, 99, 100}) {
+    for (const auto scan_type : {ScanType::OpEquals, ScanType::OpNotEquals, ScanType::OpLessThan,
+                                 ScanType::OpLessThanEquals, ScanType::OpGreaterThan, ScanType::OpGreaterThanEquals}) {
+      auto expected = std::vector<int32_t>{};
+      with_comparator(scan_type, [&](const auto& comparator) {
+        for (const auto& row_id : *pos_list) {
+          const auto row_number = static_cast<int32_t>(row_id.chunk_id * CHUNK_SIZE + row_id.chunk_offset);
+          if (comparator(values[row_number], search_value)) expected.push_back(row_number);
+        }
+      });
+
+      // The scan keeps the order of the positions, so the row numbers can be compared directly.
+      auto scan = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, scan_type, search_value);
+      scan->execute();
+      const auto output = scan->get_output();
+      auto row_numbers = std::vector<int32_t>{};
+      for (auto chunk_id = ChunkID{0}; chunk_id < output->chunk_count(); ++chunk_id) {
+        const auto segment = output->get_chunk(chunk_id)->get_segment(ColumnID{1});
+        for (auto chunk_offset = ChunkOffset{0}; chunk_offset < segment->size(); ++chunk_offset) {
+          row_numbers.push_back(type_cast<int32_t>((*segment)[chunk_offset]));
+        }
+      }
+      ASSERT_EQ(row_numbers, expected);
+    }
+  }
+}
+
+TEST_F(OperatorsTableScanTest, FrameOfReferenceRequiresIntegers) {
+  auto table = std::make_shared<Table>(5);
+  table->add_column("a", "float");
+  table->append({1.5f});
+  EXPECT_THROW(table->compress_chunk(ChunkID{0}, {SegmentEncodingSpec{EncodingType::FrameOfReference}}),
+               std::logic_error);
+}
+
+TEST_F(OperatorsTableScanTest, ScanOnFrontCodedDictColumn) {
+  // The first chunk is front-coded, the second one is not encoded, so both yield the same results.
+  auto table = std::make_shared<Table>(100);
+  table->add_column("a", "string");
+  table->add_column("b", "int");
+  auto values = std::vector<std::string>{};
+  for (auto index = int32_t{0}; index < 100; ++index) {
+    values.push_back("prefix/" + std::to_string(index % 40));
+  }
+  for (auto repetition = 0; repetition < 2; ++repetition) {
+    for (auto index = int32_t{0}; index < 100; ++index) {
+      table->append({values[index], index});
+    }
+  }
+  table->compress_chunk(ChunkID{0}, {SegmentEncodingSpec{EncodingType::FrontCodedDictionary}, SegmentEncodingSpec{}});
+
+  auto table_wrapper = std::make_shared<TableWrapper>(std::move(table));
+  table_wrapper->execute();
+
+  for (const auto& search_value : {std::string{"a"}, std::string{"prefix/17"}, std::string{"prefix/170"},
+                                   std::string{"prefix/9"}, std::string{"z"}}) {
+    for (const auto scan_type : {ScanType::OpEquals, ScanType::OpNotEquals, ScanType::OpLessThan,
+                                 ScanType::OpLessThanEquals, ScanType::OpGreaterThan, ScanType::OpGreaterThanEquals}) {
+      auto expected = std::vector<AllTypeVariant>{};
+      with_comparator(scan_type, [&](const auto& comparator) {
+        for (auto index = int32_t{0}; index < 100; ++index) {
+          if (comparator(values[index], search_value)) {
+            expected.emplace_back(index);
+            expected.emplace_back(index);
+          }
+        }
+      });
+
+      auto scan = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, scan_type, search_value);
+      scan->execute();
+      ASSERT_COLUMN_EQ(scan->get_output(), ColumnID{1}, expected);
+
+      // The second scan reads the front-coded segment through reference segments.
+      auto scan_on_reference = std::make_shared<TableScan>(scan, ColumnID{0}, scan_type, search_value);
+      scan_on_reference->execute();
+      ASSERT_COLUMN_EQ(scan_on_reference->get_output(), ColumnID{1}, expected);
+    }
+  }
+
+  auto int_table = std::make_shared<Table>(5);
+  int_table->add_column("a", "int");
+  int_table->append({1});
+  EXPECT_THROW(int_table->compress_chunk(ChunkID{0}, {SegmentEncodingSpec{EncodingType::FrontCodedDictionary}}),
+               std::logic_error);
+}
+
+TEST_F(OperatorsTableScanTest, ChunkParallelScanKeepsChunkOrder) {
+  // Many small chunks with different encodings, some of which are skipped or fully included, are scanned on the
+  // workers. Column b numbers the rows, so the output of both modes has to be identical, including the chunk order.
+  auto table = std::make_shared<Table>(100);
+  table->add_column("a", "int");
+  table->add_column("b", "int");
+  for (auto index = int32_t{0}; index < 100 * 64; ++index) {
+    table->append({(index * 7) % 1000, index});
+  }
+  for (auto chunk_id = ChunkID{0}; chunk_id < table->chunk_count(); chunk_id += 2) {
+    table->compress_chunk(chunk_id);
+  }
+  auto table_wrapper = std::make_shared<TableWrapper>(std::move(table));
+  table_wrapper->execute();
+
+  for (const auto search_value : {-1, 350, 1000}) {
+    auto sequential_scan = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, ScanType::OpLessThan, search_value,
+                                                       TableScan::ExecutionMode::Sequential);
+    sequential_scan->execute();
+    auto parallel_scan = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, ScanType::OpLessThan, search_value,
+                                                     TableScan::ExecutionMode::ChunkParallel);
+    parallel_scan->execute();
+    EXPECT_EQ(parallel_scan->get_output()->chunk_count(), sequential_scan->get_output()->chunk_count());
+    EXPECT_TABLE_EQ(parallel_scan->get_output(), sequential_scan->get_output(), true);
+
+    // The second scan runs on the bitmaps and offsets that the first one produced.
+    auto parallel_scan_on_reference = std::make_shared<TableScan>(parallel_scan, ColumnID{0}, ScanType::OpGreaterThan,
+                                                                  100, TableScan::ExecutionMode::ChunkParallel);
+    parallel_scan_on_reference->execute();
+    auto sequential_scan_on_reference = std::make_shared<TableScan>(
+        sequential_scan, ColumnID{0}, ScanType::OpGreaterThan, 100, TableScan::ExecutionMode::Sequential);
+    sequential_scan_on_reference->execute();
+    EXPECT_TABLE_EQ(parallel_scan_on_reference->get_output(), sequential_scan_on_reference->get_output(), true);
+  }
+}
+
 }  // namespace opossum
@@ -0,0 +1,113 @@
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "operators/sort.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "operators/top_k.hpp"
+#include "storage/reference_segment.hpp"
+#include "storage/table.hpp"
+#include "types.hpp"
+#include "utils/load_table.hpp"
+
+namespace opossum {
+
+class OperatorsTopKTest : public BaseTest {
+ protected:
+  void SetUp() override { _table = load_table("src/test/tables/sort_input.tbl", 5); }
+
+  // Creates a table with an int column "a" that grows from chunk to chunk, a string column "b", a double column "c"
+  // with few distinct values, and a long column "d" that holds the row index. All chunks but the last one are
+  // dictionary-encoded, so that k can cover both encoded and unencoded chunks.
+  static std::shared_ptr<Table> create_table(const int32_t row_count, const ChunkOffset chunk_size) {
+    auto table = std::make_shared<Table>(chunk_size);
+    table->add_column("a", "int");
+    table->add_column("b", "string");
+    table->add_column("c", "double");
+    table->add_column("d", "long");
+    for (auto index = int32_t{0}; index < row_count; ++index) {
+      table->append({index / 3 + index * 37 % 11, "b" + std::to_string(index * 7 % 23),
+                     static_cast<double>(index % 4) - 1.5, int64_t{index}});
+    }
+    for (auto chunk_id = ChunkID{0}; chunk_id + 1 < table->chunk_count(); ++chunk_id) {
+      table->compress_chunk(chunk_id);
+    }
+    return table;
+  }
+
+  // Returns the first k rows of the output of Sort.
+  static std::shared_ptr<Table> sort_and_limit(const std::shared_ptr<const AbstractOperator>& input,
+                                               const std::vector<SortColumnDefinition>& definitions, const size_t k) {
+    const auto sort = std::make_shared<Sort>(input, definitions);
+    sort->execute();
+    const auto sorted_table = sort->get_output();
+
+    auto rows = rows_of(*sorted_table);
+    rows.resize(std::min(k, rows.size()));
+    return table_from_rows(column_definitions_of(*sorted_table), rows);
+  }
+
+  std::shared_ptr<Table> _table = nullptr;
+};
+
+TEST_F(OperatorsTopKTest, MatchesSort) {
+  const auto table = wrap(create_table(500, 40));
+  const auto definition_lists = std::vector<std::vector<SortColumnDefinition>>{
+      {{ColumnID{0}}},
+      {{ColumnID{0}, SortMode::Descending}},
+      {{ColumnID{2}}, {ColumnID{1}, SortMode::Descending}},
+      {{ColumnID{1}}, {ColumnID{0}}},
+      {{ColumnID{2}, SortMode::Descending}}};
+  for (const auto& definitions : definition_lists) {
+    for (const auto k : {size_t{1}, size_t{7}, size_t{40}, size_t{123}, size_t{500}, size_t{1'000}}) {
+      const auto top_k = std::make_shared<TopK>(table, definitions, k);
+      top_k->execute();
+      EXPECT_EQ(top_k->get_output()->chunk_count(), 1u);
+      EXPECT_TABLE_EQ(top_k->get_output(), sort_and_limit(table, definitions, k), true);
+    }
+  }
+}
+
+TEST_F(OperatorsTopKTest, ReferenceInput) {
+  _table->compress_chunk(ChunkID{0});
+  const auto table_scan = std::make_shared<TableScan>(wrap(_table), ColumnID{4}, ScanType::OpGreaterThanEquals, 3.0);
+  table_scan->execute();
+
+  const auto definitions = std::vector<SortColumnDefinition>{{ColumnID{1}}, {ColumnID{0}, SortMode::Descending}};
+  const auto top_k = std::make_shared<TopK>(table_scan, definitions, 5);
+  top_k->execute();
+  const auto output = top_k->get_output();
+  EXPECT_TABLE_EQ(output, load_table("src/test/tables/sort_input_filtered_top_5_by_b_a_desc.tbl", 5), true);
+
+  // the output references the base table, not the scan output.
+  const auto reference_segment =
+      std::dynamic_pointer_cast<const ReferenceSegment>(output->get_chunk(ChunkID{0})->get_segment(ColumnID{0}));
+  ASSERT_TRUE(reference_segment);
+  EXPECT_EQ(reference_segment->referenced_table(), _table);
+}
+
+TEST_F(OperatorsTopKTest, EmptyOutput) {
+  const auto empty_table = wrap(std::make_shared<Table>(_table));
+  const auto table = wrap(_table);
+  for (const auto& [input, k] : {std::pair{empty_table, size_t{5}}, std::pair{table, size_t{0}}}) {
+    const auto top_k = std::make_shared<TopK>(input, std::vector<SortColumnDefinition>{{ColumnID{0}}}, k);
+    top_k->execute();
+    EXPECT_EQ(top_k->get_output()->row_count(), 0u);
+    EXPECT_EQ(top_k->get_output()->column_count(), 5u);
+  }
+}
+
+TEST_F(OperatorsTopKTest, InvalidArguments) {
+  const auto table = wrap(_table);
+  EXPECT_THROW(TopK(table, {}, 3), std::logic_error);
+  const auto top_k = std::make_shared<TopK>(table, std::vector<SortColumnDefinition>{{ColumnID{5}}}, 3);
+  EXPECT_THROW(top_k->execute(), std::logic_error);
+}
+
+}  // namespace opossum
@@ -0,0 +1,59 @@
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "../lib/operators/table_scan.hpp"
+#include "../lib/operators/table_wrapper.hpp"
+#include "../lib/scheduler/operator_task.hpp"
+#include "../lib/scheduler/worker_pool.hpp"
+#include "../lib/storage/table.hpp"
+#include "../lib/utils/load_table.hpp"
+
+namespace opossum {
+
+class SchedulerOperatorTaskTest : public BaseTest {};
+
+TEST_F(SchedulerOperatorTaskTest, ScheduleOperatorTree) {
+  const auto table_wrapper = std::make_shared<TableWrapper>(load_table("src/test/tables/int_float.tbl", 2));
+  const auto scan_a = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, ScanType::OpGreaterThanEquals, 1234);
+  const auto scan_b = std::make_shared<TableScan>(scan_a, ColumnID{1}, ScanType::OpLessThan, 457.9);
+
+  const auto tasks = OperatorTask::make_tasks_from_operator(scan_b);
+  ASSERT_EQ(tasks.size(), 3u);
+  EXPECT_EQ(std::static_pointer_cast<OperatorTask>(tasks[0])->get_operator(), table_wrapper);
+  EXPECT_EQ(std::static_pointer_cast<OperatorTask>(tasks[2])->get_operator(), scan_b);
+  EXPECT_EQ(tasks[0]->successors(), (std::vector<std::shared_ptr<AbstractTask>>{tasks[1]}));
+
+  WorkerPool::get().schedule_and_wait_for_tasks(tasks);
+  EXPECT_TABLE_EQ(scan_b->get_output(), load_table("src/test/tables/int_float_filtered.tbl", 2));
+}
+
+TEST_F(SchedulerOperatorTaskTest, SharedInput) {
+  // The table wrapper is the input of two scans, whose tasks can run concurrently once it is done. It is executed once.
+  const auto table_wrapper = std::make_shared<TableWrapper>(load_table("src/test/tables/int_float.tbl", 2));
+  const auto scan_a = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, ScanType::OpGreaterThanEquals, 1234);
+  const auto scan_b = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, ScanType::OpLessThan, 1234);
+  const auto wrapper_task = std::make_shared<OperatorTask>(table_wrapper);
+  const auto task_a = std::make_shared<OperatorTask>(scan_a);
+  const auto task_b = std::make_shared<OperatorTask>(scan_b);
+  wrapper_task->set_as_predecessor_of(task_a);
+  wrapper_task->set_as_predecessor_of(task_b);
+
+  WorkerPool::get().schedule_and_wait_for_tasks({task_b, task_a, wrapper_task});
+  EXPECT_EQ(scan_a->get_output()->row_count(), 2u);
+  EXPECT_EQ(scan_b->get_output()->row_count(), 1u);
+}
+
+TEST_F(SchedulerOperatorTaskTest, FailingOperator) {
+  // The first scan fails because the column does not exist. Its successor is not executed, and the exception is
+  // rethrown when waiting for the plan.
+  const auto table_wrapper = std::make_shared<TableWrapper>(load_table("src/test/tables/int_float.tbl", 2));
+  const auto scan_a = std::make_shared<TableScan>(table_wrapper, ColumnID{7}, ScanType::OpEquals, 1234);
+  const auto scan_b = std::make_shared<TableScan>(scan_a, ColumnID{1}, ScanType::OpLessThan, 457.9);
+  EXPECT_ANY_THROW(WorkerPool::get().schedule_and_wait_for_tasks(OperatorTask::make_tasks_from_operator(scan_b)));
+}
+
+}  // namespace opossum
@@ -0,0 +1,164 @@
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "../lib/scheduler/job_task.hpp"
+#include "../lib/scheduler/work_stealing_deque.hpp"
+#include "../lib/scheduler/worker_pool.hpp"
+
+namespace opossum {
+
+class SchedulerWorkerPoolTest : public BaseTest {};
+
+TEST_F(SchedulerWorkerPoolTest, ParallelFor) {
+  auto& worker_pool = WorkerPool::get();
+  EXPECT_GE(worker_pool.worker_count(), 1u);
+
+  auto results = std::vector<size_t>(1000);
+  worker_pool.parallel_for(results.size(), [&](const size_t index) { results[index] = index * index; });
+  for (auto index = size_t{0}; index < results.size(); ++index) {
+    ASSERT_EQ(results[index], index * index);
+  }
+
+  auto called = false;
+  worker_pool.parallel_for(0, [&](const size_t) { called = true; });
+  EXPECT_FALSE(called);
+}
+
+TEST_F(SchedulerWorkerPoolTest, NestedParallelFor) {
+  // The calling thread processes jobs while it waits, so nested calls cannot block each other even if all workers are
+  // busy with outer jobs.
+  auto sum = std::atomic<size_t>{0};
+  WorkerPool::get().parallel_for(16, [&](const size_t outer_index) {
+    WorkerPool::get().parallel_for(16, [&](const size_t inner_index) { sum += outer_index * 16 + inner_index; });
+  });
+  EXPECT_EQ(sum, 256u * 255u / 2u);
+}
+
+TEST_F(SchedulerWorkerPoolTest, RethrowsExceptions) {
+  auto finished_count = std::atomic<size_t>{0};
+  EXPECT_THROW(WorkerPool::get().parallel_for(100,
+                                               [&](const size_t index) {
+                                                 if (index == 42) throw std::logic_error("job failed");
+                                                 ++finished_count;
+                                               }),
+               std::logic_error);
+  EXPECT_EQ(finished_count, 99u);
+}
+
+TEST_F(SchedulerWorkerPoolTest, TaskDependencies) {
+  // A diamond: b and c depend on a, d depends on b and c.
+  auto order_mutex = std::mutex{};
+  auto order = std::vector<char>{};
+  const auto make_task = [&](const char name) {
+    return std::make_shared<JobTask>([&, name] {
+      const auto lock = std::lock_guard{order_mutex};
+      order.push_back(name);
+    });
+  };
+  const auto a = make_task('a');
+  const auto b = make_task('b');
+  const auto c = make_task('c');
+  const auto d = make_task('d');
+  a->set_as_predecessor_of(b);
+  a->set_as_predecessor_of(c);
+  b->set_as_predecessor_of(d);
+  c->set_as_predecessor_of(d);
+
+  // The order of scheduling does not matter.
+  WorkerPool::get().schedule_and_wait_for_tasks({d, c, b, a});
+  ASSERT_EQ(order.size(), 4u);
+  EXPECT_EQ(order.front(), 'a');
+  EXPECT_EQ(order.back(), 'd');
+  EXPECT_TRUE(d->is_done());
+
+  EXPECT_THROW(a->schedule(), std::logic_error);
+  EXPECT_THROW(a->set_as_predecessor_of(make_task('e')), std::logic_error);
+}
+
+TEST_F(SchedulerWorkerPoolTest, ExceptionsArePassedToSuccessors) {
+  auto successor_executed = false;
+  const auto failing_task = std::make_shared<JobTask>([] { throw std::logic_error("task failed"); });
+  const auto successor = std::make_shared<JobTask>([&] { successor_executed = true; });
+  failing_task->set_as_predecessor_of(successor);
+  failing_task->schedule();
+  successor->schedule();
+  EXPECT_THROW(successor->join(), std::logic_error);
+  EXPECT_FALSE(successor_executed);
+}
+
+TEST_F(SchedulerWorkerPoolTest, ExceptionsOutliveFailedPredecessors) {
+  auto failing_task = std::make_shared<JobTask>([] { throw std::runtime_error("task failed"); });
+  const auto successor = std::make_shared<JobTask>([] {});
+  failing_task->set_as_predecessor_of(successor);
+  successor->schedule();
+  failing_task->schedule();
+  // the successor still gets the original exception once nobody holds the
+  // failed task anymore.
+  failing_task.reset();
+  EXPECT_THROW(successor->join(), std::runtime_error);
+}
+
+TEST_F(SchedulerWorkerPoolTest, ManyTasks) {
+  // Tasks that schedule further tasks from the workers end up in their deques and are stolen by other workers.
+  auto sum = std::atomic<size_t>{0};
+  auto tasks = std::vector<std::shared_ptr<AbstractTask>>{};
+  for (auto outer_index = size_t{0}; outer_index < 64; ++outer_index) {
+    tasks.emplace_back(std::make_shared<JobTask>([&, outer_index] {
+      auto inner_tasks = std::vector<std::shared_ptr<AbstractTask>>{};
+      for (auto inner_index = size_t{0}; inner_index < 64; ++inner_index) {
+        inner_tasks.emplace_back(std::make_shared<JobTask>([&, outer_index, inner_index] {
+          sum += outer_index * 64 + inner_index;
+        }));
+      }
+      WorkerPool::get().schedule_and_wait_for_tasks(inner_tasks);
+    }));
+  }
+  WorkerPool::get().schedule_and_wait_for_tasks(tasks);
+  EXPECT_EQ(sum, 4096u * 4095u / 2u);
+}
+
+TEST_F(SchedulerWorkerPoolTest, WorkStealingDeque) {
+  auto values = std::vector<int>(1000);
+  auto deque = WorkStealingDeque<int>{2};
+  EXPECT_EQ(deque.take(), nullptr);
+  EXPECT_EQ(deque.steal(), nullptr);
+
+  // The owner takes the newest element, thieves get the oldest one. The deque grows beyond its initial capacity.
+  for (auto& value : values) {
+    deque.push(&value);
+  }
+  EXPECT_EQ(deque.take(), &values[999]);
+  EXPECT_EQ(deque.steal(), &values[0]);
+
+  // Concurrent thieves and the owner remove each element exactly once.
+  auto removed_counts = std::vector<std::atomic<int>>(values.size());
+  const auto count_removed = [&](const int* element) { ++removed_counts[element - values.data()]; };
+  auto thieves = std::vector<std::thread>{};
+  for (auto thief_index = 0; thief_index < 3; ++thief_index) {
+    thieves.emplace_back([&] {
+      while (!deque.empty()) {
+        if (const auto* element = deque.steal()) count_removed(element);
+      }
+    });
+  }
+  while (const auto* element = deque.take()) {
+    count_removed(element);
+  }
+  for (auto& thief : thieves) {
+    thief.join();
+  }
+  EXPECT_EQ(removed_counts[0], 0);
+  EXPECT_EQ(removed_counts[999], 0);
+  for (auto index = size_t{1}; index < 999; ++index) {
+    ASSERT_EQ(removed_counts[index], 1);
+  }
+}
+
+}  // namespace opossum
@@ -0,0 +1,110 @@
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "../lib/storage/bit_packed_vector.hpp"
+#include "../lib/storage/dictionary_segment.hpp"
+#include "../lib/storage/value_segment.hpp"
+
+namespace opossum {
+
+class StorageBitPackedVectorTest : public BaseTest {};
+
+TEST_F(StorageBitPackedVectorTest, RequiredBitWidth) {
+  EXPECT_EQ(BitPackedVector::required_bit_width(0), 1u);
+  EXPECT_EQ(BitPackedVector::required_bit_width(1), 1u);
+  EXPECT_EQ(BitPackedVector::required_bit_width(2), 2u);
+  EXPECT_EQ(BitPackedVector::required_bit_width(299), 9u);
+  EXPECT_EQ(BitPackedVector::required_bit_width(std::numeric_limits<uint32_t>::max()), 32u);
+}
+
+TEST_F(StorageBitPackedVectorTest, SetGetAndDecodeAllBitWidths) {
+  // 300 values fill two blocks completely and a third one partially.
+  const auto size = size_t{300};
+  for (auto bit_width = uint8_t{1}; bit_width <= 32; ++bit_width) {
+    const auto max_value = static_cast<uint32_t>((uint64_t{1} << bit_width) - 1);
+    auto vector = BitPackedVector{size, bit_width};
+
+    auto expected_values = std::vector<uint32_t>(size);
+    for (auto index = size_t{0}; index < size; ++index) {
+      // Alternate between the maximum value and a varying pattern to catch overlapping writes.
+      expected_values[index] = index % 3 == 0 ? max_value : static_cast<uint32_t>(index * 2654435761u) & max_value;
+      vector.set(index, ValueID{expected_values[index]});
+    }
+
+    // Overwrite a value to check that set clears the previous bits.
+    vector.set(5, ValueID{0});
+    expected_values[5] = 0;
+
+    EXPECT_EQ(vector.size(), size);
+    EXPECT_EQ(vector.bit_width(), bit_width);
+    EXPECT_EQ(vector.width(), (bit_width + 7) / 8);
+    EXPECT_EQ(vector.block_count(), 3u);
+    EXPECT_EQ(vector.estimate_memory_usage(), 3 * BitPackedVector::BLOCK_SIZE * bit_width / 8);
+
+    auto decoded_values = std::vector<uint32_t>(vector.block_count() * BitPackedVector::BLOCK_SIZE);
+    for (auto block_index = size_t{0}; block_index < vector.block_count(); ++block_index) {
+      vector.decode_block(block_index, decoded_values.data() + block_index * BitPackedVector::BLOCK_SIZE);
+    }
+
+    for (auto index = size_t{0}; index < size; ++index) {
+      ASSERT_EQ(vector.get(index), expected_values[index]) << "bit width " << static_cast<int>(bit_width);
+      ASSERT_EQ(decoded_values[index], expected_values[index]) << "bit width " << static_cast<int>(bit_width);
+    }
+
+    // The padding of the last block is decoded as 0.
+    for (auto index = size; index < decoded_values.size(); ++index) {
+      ASSERT_EQ(decoded_values[index], 0u);
+    }
+  }
+}
+
+TEST_F(StorageBitPackedVectorTest, DecodeRanges) {
+  auto vector = BitPackedVector{500, 11};
+  for (auto index = size_t{0}; index < 500; ++index) {
+    vector.set(index, ValueID{static_cast<ValueID::base_type>(index * 3)});
+  }
+
+  // Ranges within a single block, across block borders, covering full blocks, and ending in the last partial block.
+  for (const auto& [begin, end] : std::vector<std::pair<size_t, size_t>>{
+           {0, 0}, {3, 17}, {100, 300}, {128, 256}, {0, 500}, {257, 500}, {499, 500}}) {
+    auto decoded_values = std::vector<ValueID::base_type>(end - begin);
+    vector.decode(begin, end, decoded_values.data());
+    for (auto index = begin; index < end; ++index) {
+      ASSERT_EQ(decoded_values[index - begin], index * 3) << "range [" << begin << ", " << end << ")";
+    }
+  }
+}
+
+TEST_F(StorageBitPackedVectorTest, InvalidBitWidth) {
+  EXPECT_THROW(BitPackedVector(10, 0), std::logic_error);
+  EXPECT_THROW(BitPackedVector(10, 33), std::logic_error);
+}
+
+TEST_F(StorageBitPackedVectorTest, DictionarySegmentWithBitPacking) {
+  // 300 distinct values need 9 bits per value id instead of the 16 bits of a FixedWidthIntegerVector.
+  auto value_segment = std::make_shared<ValueSegment<int32_t>>();
+  for (auto value = int32_t{0}; value < 600; ++value) {
+    value_segment->append(value % 300);
+  }
+
+  const auto dictionary_segment =
+      std::make_shared<DictionarySegment<int32_t>>(value_segment, VectorCompressionType::BitPacking);
+  const auto attribute_vector =
+      std::dynamic_pointer_cast<const BitPackedVector>(dictionary_segment->attribute_vector());
+  ASSERT_TRUE(attribute_vector);
+  EXPECT_EQ(attribute_vector->bit_width(), 9u);
+
+  for (auto offset = ChunkOffset{0}; offset < 600; ++offset) {
+    EXPECT_EQ(dictionary_segment->get(offset), static_cast<int32_t>(offset % 300));
+  }
+
+  // Five blocks of 128 values with 9 bits each.
+  EXPECT_EQ(dictionary_segment->estimate_memory_usage(), 300 * sizeof(int32_t) + 5 * 128 * 9 / 8);
+}
+
+}  // namespace opossum
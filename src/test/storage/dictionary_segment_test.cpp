@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <memory>
 #include <string>
 
@@ -6,6 +7,7 @@
 #include "resolve_type.hpp"
 #include "storage/abstract_segment.hpp"
 #include "storage/dictionary_segment.hpp"
+#include "storage/resolve_attribute_vector_type.hpp"
 
 namespace opossum {
 
@@ -149,6 +151,63 @@ TEST_F(StorageDictionarySegmentTest, AccessingUnderlyingDataStructures) {
   EXPECT_ANY_THROW(att_vec_str->get(0));
 }
 
+TEST_F(StorageDictionarySegmentTest, DecodeAndResolveAttributeVector) {
+  for (auto value = int32_t{0}; value < 300; ++value) {
+    value_segment_int->append(value % 7);
+  }
+
+  for (const auto vector_compression_type :
+       {VectorCompressionType::FixedWidthInteger, VectorCompressionType::BitPacking}) {
+    const auto dict_segment = std::make_shared<DictionarySegment<int32_t>>(value_segment_int, vector_compression_type);
+    const auto attribute_vector = dict_segment->attribute_vector();
+
+    auto decoded_value_ids = std::vector<ValueID::base_type>(290);
+    attribute_vector->decode(5, 295, decoded_value_ids.data());
+    for (auto index = size_t{0}; index < decoded_value_ids.size(); ++index) {
+      EXPECT_EQ(decoded_value_ids[index], (index + 5) % 7);
+    }
+
+    auto resolved_value_ids = std::vector<ValueID>{};
+    auto resolved_bit_packed = false;
+    resolve_attribute_vector_type(*attribute_vector, [&](const auto& typed_attribute_vector) {
+      using AttributeVectorType = std::decay_t<decltype(typed_attribute_vector)>;
+      resolved_bit_packed = std::is_same_v<AttributeVectorType, BitPackedVector>;
+      for (auto index = size_t{0}; index < typed_attribute_vector.size(); ++index) {
+        resolved_value_ids.push_back(typed_attribute_vector[index]);
+      }
+    });
+    EXPECT_EQ(resolved_bit_packed, vector_compression_type == VectorCompressionType::BitPacking);
+    ASSERT_EQ(resolved_value_ids.size(), 300u);
+    for (auto index = size_t{0}; index < resolved_value_ids.size(); ++index) {
+      EXPECT_EQ(resolved_value_ids[index], index % 7);
+    }
+  }
+}
+
+TEST_F(StorageDictionarySegmentTest, CompressManyDistinctValues) {
+  // Enough distinct values to grow the hash table used during construction several times.
+  for (auto index = int32_t{0}; index < 20'000; ++index) {
+    value_segment_int->append((index * 7919) % 10'007 - 5'000);
+  }
+  const auto dict_segment = std::make_shared<DictionarySegment<int32_t>>(value_segment_int);
+
+  auto expected_dictionary = value_segment_int->values();
+  std::sort(expected_dictionary.begin(), expected_dictionary.end());
+  expected_dictionary.erase(std::unique(expected_dictionary.begin(), expected_dictionary.end()),
+                            expected_dictionary.end());
+  EXPECT_EQ(dict_segment->dictionary(), expected_dictionary);
+  for (auto chunk_offset = ChunkOffset{0}; chunk_offset < value_segment_int->size(); ++chunk_offset) {
+    ASSERT_EQ(dict_segment->get(chunk_offset), value_segment_int->values()[chunk_offset]);
+  }
+
+  // Segments other than value segments are read through the generic interface.
+  const auto recompressed_segment = std::make_shared<DictionarySegment<int32_t>>(dict_segment);
+  EXPECT_EQ(recompressed_segment->dictionary(), expected_dictionary);
+  for (auto chunk_offset = ChunkOffset{0}; chunk_offset < value_segment_int->size(); ++chunk_offset) {
+    ASSERT_EQ(recompressed_segment->get(chunk_offset), value_segment_int->values()[chunk_offset]);
+  }
+}
+
 TEST_F(StorageDictionarySegmentTest, ValueOfValueId) {
   value_segment_int->append(1);
   value_segment_int->append(2);
@@ -183,6 +242,19 @@ TEST_F(StorageDictionarySegmentTest, UInt8) {
   EXPECT_EQ(dict_col_str->estimate_memory_usage(), 1 * sizeof(std::string) + 1 * sizeof(uint8_t));
 }
 
+TEST_F(StorageDictionarySegmentTest, MemoryUsageOfLongStrings) {
+  // Strings that do not fit into the string object allocate their characters on the heap.
+  const auto long_string = std::string(100, 'a');
+  value_segment_str->append(long_string);
+  value_segment_str->append("Hello");
+  auto dict_col_str = std::make_shared<DictionarySegment<std::string>>(value_segment_str);
+
+  // "Hello" is sorted before the long string.
+  const auto heap_size = dict_col_str->dictionary()[1].capacity() + 1;
+  EXPECT_GE(heap_size, 101u);
+  EXPECT_EQ(dict_col_str->estimate_memory_usage(), 2 * sizeof(std::string) + heap_size + 2 * sizeof(uint8_t));
+}
+
 TEST_F(StorageDictionarySegmentTest, UInt16) {
   for (int32_t index = 0; index < 256; ++index) {
     value_segment_int->append(index);
@@ -0,0 +1,114 @@
+#include <limits>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "../lib/storage/frame_of_reference_segment.hpp"
+#include "../lib/storage/value_segment.hpp"
+
+namespace opossum {
+
+class StorageFrameOfReferenceSegmentTest : public BaseTest {
+ protected:
+  // Checks random access, decode_block, and decode_block_offsets against the values of the value segment.
+  template <typename T>
+  void check_segment(const std::shared_ptr<ValueSegment<T>>& value_segment, const bool use_delta_encoding) {
+    const auto segment = std::make_shared<FrameOfReferenceSegment<T>>(value_segment, use_delta_encoding);
+    const auto& values = value_segment->values();
+    constexpr auto BLOCK_SIZE = FrameOfReferenceSegment<T>::BLOCK_SIZE;
+
+    ASSERT_EQ(segment->size(), values.size());
+    ASSERT_EQ(segment->block_count(), (values.size() + BLOCK_SIZE - 1) / BLOCK_SIZE);
+    for (auto chunk_offset = ChunkOffset{0}; chunk_offset < values.size(); ++chunk_offset) {
+      ASSERT_EQ(segment->get(chunk_offset), values[chunk_offset]) << "chunk offset " << chunk_offset;
+    }
+    EXPECT_EQ((*segment)[0], AllTypeVariant{values[0]});
+    EXPECT_THROW(segment->get(static_cast<ChunkOffset>(values.size())), std::logic_error);
+
+    auto decoded_values = std::vector<T>(BLOCK_SIZE);
+    auto decoded_offsets = std::vector<uint32_t>(BLOCK_SIZE);
+    for (auto block_index = size_t{0}; block_index < segment->block_count(); ++block_index) {
+      const auto block_begin = values.cbegin() + block_index * BLOCK_SIZE;
+      const auto block_end = values.cbegin() + std::min(values.size(), (block_index + 1) * BLOCK_SIZE);
+      EXPECT_EQ(segment->block_minimum(block_index), *std::min_element(block_begin, block_end));
+      EXPECT_EQ(segment->block_maximum(block_index), *std::max_element(block_begin, block_end));
+
+      segment->decode_block(block_index, decoded_values.data());
+      EXPECT_TRUE(std::equal(block_begin, block_end, decoded_values.cbegin())) << "block " << block_index;
+
+      const auto range = static_cast<uint64_t>(segment->block_maximum(block_index)) -
+                         static_cast<uint64_t>(segment->block_minimum(block_index));
+      if (range > std::numeric_limits<uint32_t>::max()) continue;
+      segment->decode_block_offsets(block_index, decoded_offsets.data());
+      for (auto value_iter = block_begin; value_iter != block_end; ++value_iter) {
+        ASSERT_EQ(decoded_offsets[std::distance(block_begin, value_iter)],
+                  static_cast<uint32_t>(*value_iter - segment->block_minimum(block_index)));
+      }
+    }
+  }
+};
+
+TEST_F(StorageFrameOfReferenceSegmentTest, RandomValues) {
+  auto generator = std::mt19937{42};
+  auto distribution = std::uniform_int_distribution<int32_t>{-100'000, 100'000};
+  auto value_segment = std::make_shared<ValueSegment<int32_t>>();
+  // Two full blocks and a partial one.
+  for (auto index = 0; index < 5000; ++index) {
+    value_segment->append(distribution(generator));
+  }
+  check_segment(value_segment, false);
+  // No block is sorted, so delta mode falls back to offsets to the minimum.
+  check_segment(value_segment, true);
+}
+
+TEST_F(StorageFrameOfReferenceSegmentTest, IncreasingKeys) {
+  // Keys with small gaps, except for one unsorted block in the middle.
+  auto value_segment = std::make_shared<ValueSegment<int64_t>>();
+  auto key = int64_t{1'000'000'000'000};
+  for (auto index = 0; index < 7000; ++index) {
+    key += index % 3;
+    value_segment->append(index >= 2048 && index < 4096 ? key - index % 5 : key);
+  }
+  check_segment(value_segment, false);
+  check_segment(value_segment, true);
+
+  // Differences between consecutive keys need 2 bits, offsets to the block minimum need 12 bits.
+  const auto frame_of_reference_segment = std::make_shared<FrameOfReferenceSegment<int64_t>>(value_segment, false);
+  const auto delta_segment = std::make_shared<FrameOfReferenceSegment<int64_t>>(value_segment, true);
+  EXPECT_TRUE(delta_segment->uses_delta_encoding());
+  EXPECT_LT(delta_segment->estimate_memory_usage(), frame_of_reference_segment->estimate_memory_usage());
+  EXPECT_LT(frame_of_reference_segment->estimate_memory_usage(), value_segment->estimate_memory_usage() / 4);
+}
+
+TEST_F(StorageFrameOfReferenceSegmentTest, ExtremeValues) {
+  // The offsets of the first block need 64 bits, the second block is constant and needs no bits at all.
+  auto value_segment = std::make_shared<ValueSegment<int64_t>>();
+  for (auto index = 0; index < 2048; ++index) {
+    value_segment->append(index % 2 == 0 ? std::numeric_limits<int64_t>::min() + index
+                                         : std::numeric_limits<int64_t>::max() - index);
+  }
+  for (auto index = 0; index < 10; ++index) {
+    value_segment->append(int64_t{-7});
+  }
+  check_segment(value_segment, false);
+  check_segment(value_segment, true);
+
+  auto int_value_segment = std::make_shared<ValueSegment<int32_t>>();
+  int_value_segment->append(std::numeric_limits<int32_t>::min());
+  int_value_segment->append(std::numeric_limits<int32_t>::max());
+  int_value_segment->append(0);
+  check_segment(int_value_segment, false);
+}
+
+TEST_F(StorageFrameOfReferenceSegmentTest, Immutable) {
+  auto value_segment = std::make_shared<ValueSegment<int32_t>>();
+  value_segment->append(1);
+  const auto segment = std::make_shared<FrameOfReferenceSegment<int32_t>>(value_segment);
+  EXPECT_FALSE(segment->uses_delta_encoding());
+  EXPECT_THROW(segment->append(2), std::logic_error);
+}
+
+}  // namespace opossum
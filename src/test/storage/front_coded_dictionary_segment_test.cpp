@@ -0,0 +1,101 @@
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "../lib/storage/bit_packed_vector.hpp"
+#include "../lib/storage/dictionary_segment.hpp"
+#include "../lib/storage/front_coded_dictionary_segment.hpp"
+#include "../lib/storage/value_segment.hpp"
+
+namespace opossum {
+
+class StorageFrontCodedDictionarySegmentTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    // URLs share long prefixes. Each value occurs twice, and the dictionary spans several blocks.
+    for (auto repetition = 0; repetition < 2; ++repetition) {
+      for (auto index = 0; index < 100; ++index) {
+        value_segment->append("https://www.example.com/products/category_" + std::to_string(index % 7) + "/item_" +
+                              std::to_string(index));
+      }
+    }
+    // Long values need more than one byte for their lengths.
+    value_segment->append(std::string(300, 'x'));
+    value_segment->append(std::string(300, 'x') + "y");
+    value_segment->append("");
+
+    sorted_values = value_segment->values();
+    std::sort(sorted_values.begin(), sorted_values.end());
+    sorted_values.erase(std::unique(sorted_values.begin(), sorted_values.end()), sorted_values.end());
+  }
+
+  std::shared_ptr<ValueSegment<std::string>> value_segment = std::make_shared<ValueSegment<std::string>>();
+  std::vector<std::string> sorted_values;
+};
+
+TEST_F(StorageFrontCodedDictionarySegmentTest, Decode) {
+  const auto segment = std::make_shared<FrontCodedDictionarySegment<std::string>>(value_segment);
+  ASSERT_EQ(segment->size(), value_segment->size());
+  ASSERT_EQ(segment->unique_values_count(), sorted_values.size());
+
+  for (auto chunk_offset = ChunkOffset{0}; chunk_offset < segment->size(); ++chunk_offset) {
+    EXPECT_EQ(segment->get(chunk_offset), value_segment->values()[chunk_offset]);
+    EXPECT_EQ((*segment)[chunk_offset], (*value_segment)[chunk_offset]);
+  }
+  for (auto value_id = ValueID{0}; value_id < sorted_values.size(); ++value_id) {
+    EXPECT_EQ(segment->value_of_value_id(value_id), sorted_values[value_id]);
+  }
+  EXPECT_THROW(segment->value_of_value_id(ValueID{segment->unique_values_count()}), std::logic_error);
+  EXPECT_THROW(segment->append("x"), std::logic_error);
+}
+
+TEST_F(StorageFrontCodedDictionarySegmentTest, LowerAndUpperBound) {
+  const auto segment = std::make_shared<FrontCodedDictionarySegment<std::string>>(value_segment);
+
+  // Search for all dictionary values, values between them, and values before and after the dictionary.
+  auto search_values = sorted_values;
+  for (const auto& value : sorted_values) {
+    search_values.push_back(value + "0");
+  }
+  search_values.push_back("a");
+  search_values.push_back("zzz");
+
+  for (const auto& search_value : search_values) {
+    const auto expected_bound = [&](const auto iter) {
+      return iter == sorted_values.cend() ? INVALID_VALUE_ID
+                                          : static_cast<ValueID>(std::distance(sorted_values.cbegin(), iter));
+    };
+    EXPECT_EQ(segment->lower_bound(search_value),
+              expected_bound(std::lower_bound(sorted_values.cbegin(), sorted_values.cend(), search_value)))
+        << search_value;
+    EXPECT_EQ(segment->upper_bound(AllTypeVariant{search_value}),
+              expected_bound(std::upper_bound(sorted_values.cbegin(), sorted_values.cend(), search_value)))
+        << search_value;
+  }
+}
+
+TEST_F(StorageFrontCodedDictionarySegmentTest, MemoryUsage) {
+  const auto segment = std::make_shared<FrontCodedDictionarySegment<std::string>>(value_segment);
+  const auto dictionary_segment = std::make_shared<DictionarySegment<std::string>>(value_segment);
+  EXPECT_LT(segment->estimate_memory_usage() * 3, dictionary_segment->estimate_memory_usage());
+
+  const auto bit_packed_segment = std::make_shared<FrontCodedDictionarySegment<std::string>>(
+      value_segment, VectorCompressionType::BitPacking);
+  EXPECT_TRUE(std::dynamic_pointer_cast<const BitPackedVector>(bit_packed_segment->attribute_vector()));
+  EXPECT_EQ(bit_packed_segment->get(5), value_segment->values()[5]);
+}
+
+TEST_F(StorageFrontCodedDictionarySegmentTest, EmptySegment) {
+  const auto segment =
+      std::make_shared<FrontCodedDictionarySegment<std::string>>(std::make_shared<ValueSegment<std::string>>());
+  EXPECT_EQ(segment->size(), 0u);
+  EXPECT_EQ(segment->unique_values_count(), 0u);
+  EXPECT_EQ(segment->lower_bound(std::string{"a"}), INVALID_VALUE_ID);
+  EXPECT_EQ(segment->upper_bound(std::string{"a"}), INVALID_VALUE_ID);
+}
+
+}  // namespace opossum
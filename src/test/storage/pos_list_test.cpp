@@ -0,0 +1,76 @@
+#include <memory>
+#include <vector>
+
+#include "base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "../lib/storage/pos_list.hpp"
+#include "../lib/types.hpp"
+
+namespace opossum {
+
+class StoragePosListTest : public BaseTest {};
+
+TEST_F(StoragePosListTest, SingleChunk) {
+  auto pos_list = PosList{ChunkID{3}, std::vector<ChunkOffset>{4, 1, 7}};
+  EXPECT_TRUE(pos_list.references_single_chunk());
+  EXPECT_EQ(pos_list.common_chunk_id(), ChunkID{3});
+  EXPECT_EQ(pos_list.chunk_offsets(), (std::vector<ChunkOffset>{4, 1, 7}));
+  ASSERT_EQ(pos_list.size(), 3u);
+  EXPECT_EQ(pos_list[1], (RowID{ChunkID{3}, 1}));
+
+  // Appending to the same chunk keeps the compact representation, which only needs a ChunkOffset per position.
+  pos_list.emplace_back(RowID{ChunkID{3}, 2});
+  EXPECT_TRUE(pos_list.references_single_chunk());
+  EXPECT_EQ(pos_list, (PosList{{ChunkID{3}, 4}, {ChunkID{3}, 1}, {ChunkID{3}, 7}, {ChunkID{3}, 2}}));
+  EXPECT_LT(pos_list.memory_usage(), 4 * sizeof(RowID));
+}
+
+TEST_F(StoragePosListTest, Bitmap) {
+  // Every third row of 1000 rows is set, so the positions span more than one rank sample.
+  auto bitmap = std::vector<uint64_t>(16);
+  auto expected_chunk_offsets = std::vector<ChunkOffset>{};
+  for (auto chunk_offset = ChunkOffset{0}; chunk_offset < 1000; chunk_offset += 3) {
+    bitmap[chunk_offset / 64] |= uint64_t{1} << (chunk_offset % 64);
+    expected_chunk_offsets.push_back(chunk_offset);
+  }
+  auto pos_list = PosList{ChunkID{2}, bitmap};
+  EXPECT_TRUE(pos_list.references_single_chunk());
+  EXPECT_TRUE(pos_list.is_bitmap());
+  EXPECT_EQ(pos_list.common_chunk_id(), ChunkID{2});
+  ASSERT_EQ(pos_list.size(), expected_chunk_offsets.size());
+  EXPECT_EQ(pos_list.materialize_chunk_offsets(), expected_chunk_offsets);
+  for (auto index = size_t{0}; index < expected_chunk_offsets.size(); ++index) {
+    ASSERT_EQ(pos_list[index], (RowID{ChunkID{2}, expected_chunk_offsets[index]}));
+  }
+  EXPECT_LT(pos_list.memory_usage(), expected_chunk_offsets.size() * sizeof(ChunkOffset));
+
+  // Positions after the last set bit are added to the bitmap, other positions turn it into a list of offsets.
+  pos_list.emplace_back(RowID{ChunkID{2}, 1010});
+  EXPECT_TRUE(pos_list.is_bitmap());
+  EXPECT_EQ(pos_list[pos_list.size() - 1], (RowID{ChunkID{2}, 1010}));
+  pos_list.emplace_back(RowID{ChunkID{2}, 1});
+  EXPECT_FALSE(pos_list.is_bitmap());
+  EXPECT_TRUE(pos_list.references_single_chunk());
+  expected_chunk_offsets.push_back(1010);
+  expected_chunk_offsets.push_back(1);
+  EXPECT_EQ(pos_list.chunk_offsets(), expected_chunk_offsets);
+}
+
+TEST_F(StoragePosListTest, AppendToOtherChunk) {
+  auto pos_list = PosList{ChunkID{1}, std::vector<ChunkOffset>{5, 6}};
+  pos_list.emplace_back(RowID{ChunkID{0}, 9});
+  EXPECT_FALSE(pos_list.references_single_chunk());
+  EXPECT_EQ(pos_list.row_ids(), (std::vector<RowID>{{ChunkID{1}, 5}, {ChunkID{1}, 6}, {ChunkID{0}, 9}}));
+}
+
+TEST_F(StoragePosListTest, Iterate) {
+  const auto row_ids = std::vector<RowID>{{ChunkID{0}, 2}, {ChunkID{2}, 0}, {ChunkID{1}, 1}};
+  const auto pos_list = PosList{row_ids};
+  EXPECT_FALSE(pos_list.references_single_chunk());
+  EXPECT_EQ(std::vector<RowID>(pos_list.begin(), pos_list.end()), row_ids);
+  EXPECT_EQ(pos_list.end() - pos_list.begin(), 3);
+  EXPECT_TRUE(PosList{}.empty());
+}
+
+}  // namespace opossum
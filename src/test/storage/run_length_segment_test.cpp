@@ -0,0 +1,63 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "../lib/storage/run_length_segment.hpp"
+#include "../lib/storage/value_segment.hpp"
+
+namespace opossum {
+
+class StorageRunLengthSegmentTest : public BaseTest {
+ protected:
+  std::shared_ptr<ValueSegment<int32_t>> value_segment_int = std::make_shared<ValueSegment<int32_t>>();
+  std::shared_ptr<ValueSegment<std::string>> value_segment_str = std::make_shared<ValueSegment<std::string>>();
+};
+
+TEST_F(StorageRunLengthSegmentTest, CompressSegmentInt) {
+  for (const auto value : {3, 3, 3, 1, 1, 3, 7, 7, 7, 7}) {
+    value_segment_int->append(value);
+  }
+  const auto segment = std::make_shared<RunLengthSegment<int32_t>>(value_segment_int);
+
+  EXPECT_EQ(segment->size(), 10u);
+  EXPECT_EQ(segment->values(), (std::vector<int32_t>{3, 1, 3, 7}));
+  EXPECT_EQ(segment->end_positions(), (std::vector<ChunkOffset>{2, 4, 5, 9}));
+  EXPECT_EQ(segment->estimate_memory_usage(), 4 * sizeof(int32_t) + 4 * sizeof(ChunkOffset));
+
+  for (auto chunk_offset = ChunkOffset{0}; chunk_offset < 10; ++chunk_offset) {
+    EXPECT_EQ(segment->get(chunk_offset), value_segment_int->values()[chunk_offset]);
+    EXPECT_EQ((*segment)[chunk_offset], (*value_segment_int)[chunk_offset]);
+  }
+  EXPECT_THROW(segment->get(10), std::logic_error);
+}
+
+TEST_F(StorageRunLengthSegmentTest, CompressSegmentString) {
+  value_segment_str->append("Bill");
+  value_segment_str->append("Bill");
+  value_segment_str->append("Steve");
+
+  // The segment is passed as AbstractSegment to use the generic path of the constructor.
+  const auto segment = std::make_shared<RunLengthSegment<std::string>>(
+      std::static_pointer_cast<AbstractSegment>(value_segment_str));
+  EXPECT_EQ(segment->values(), (std::vector<std::string>{"Bill", "Steve"}));
+  EXPECT_EQ(segment->end_positions(), (std::vector<ChunkOffset>{1, 2}));
+  EXPECT_EQ(segment->get(1), "Bill");
+  EXPECT_EQ(segment->get(2), "Steve");
+}
+
+TEST_F(StorageRunLengthSegmentTest, EmptySegment) {
+  const auto segment = std::make_shared<RunLengthSegment<int32_t>>(value_segment_int);
+  EXPECT_EQ(segment->size(), 0u);
+  EXPECT_EQ(segment->estimate_memory_usage(), 0u);
+}
+
+TEST_F(StorageRunLengthSegmentTest, Immutable) {
+  value_segment_int->append(1);
+  const auto segment = std::make_shared<RunLengthSegment<int32_t>>(value_segment_int);
+  EXPECT_THROW(segment->append(2), std::logic_error);
+}
+
+}  // namespace opossum
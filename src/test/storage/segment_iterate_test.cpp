@@ -0,0 +1,135 @@
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "../lib/storage/dictionary_segment.hpp"
+#include "../lib/storage/frame_of_reference_segment.hpp"
+#include "../lib/storage/front_coded_dictionary_segment.hpp"
+#include "../lib/storage/reference_segment.hpp"
+#include "../lib/storage/run_length_segment.hpp"
+#include "../lib/storage/segment_accessor.hpp"
+#include "../lib/storage/segment_iterate.hpp"
+#include "../lib/storage/table.hpp"
+#include "../lib/storage/value_segment.hpp"
+
+namespace opossum {
+
+class StorageSegmentIterateTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    // 5000 values span three frame-of-reference blocks and contain runs for the run-length segment.
+    int_value_segment = std::make_shared<ValueSegment<int32_t>>();
+    for (auto index = int32_t{0}; index < 5000; ++index) {
+      expected_int_values.push_back((index / 7) % 100);
+      int_value_segment->append(expected_int_values.back());
+    }
+
+    string_value_segment = std::make_shared<ValueSegment<std::string>>();
+    for (auto index = int32_t{0}; index < 100; ++index) {
+      expected_string_values.push_back("value_" + std::to_string(index % 23));
+      string_value_segment->append(expected_string_values.back());
+    }
+  }
+
+  template <typename T>
+  std::vector<T> iterate_values(const AbstractSegment& segment) {
+    auto values = std::vector<T>{};
+    segment_iterate<T>(segment, [&](const auto& position) {
+      EXPECT_EQ(position.chunk_offset(), values.size());
+      values.push_back(position.value());
+    });
+    return values;
+  }
+
+  std::shared_ptr<ValueSegment<int32_t>> int_value_segment = nullptr;
+  std::shared_ptr<ValueSegment<std::string>> string_value_segment = nullptr;
+  std::vector<int32_t> expected_int_values{};
+  std::vector<std::string> expected_string_values{};
+};
+
+TEST_F(StorageSegmentIterateTest, IterateAllEncodings) {
+  EXPECT_EQ(iterate_values<int32_t>(*int_value_segment), expected_int_values);
+  EXPECT_EQ(iterate_values<int32_t>(DictionarySegment<int32_t>{int_value_segment}), expected_int_values);
+  EXPECT_EQ(iterate_values<int32_t>(DictionarySegment<int32_t>{int_value_segment, VectorCompressionType::BitPacking}),
+            expected_int_values);
+  EXPECT_EQ(iterate_values<int32_t>(RunLengthSegment<int32_t>{int_value_segment}), expected_int_values);
+  EXPECT_EQ(iterate_values<int32_t>(FrameOfReferenceSegment<int32_t>{int_value_segment}), expected_int_values);
+  EXPECT_EQ(iterate_values<int32_t>(FrameOfReferenceSegment<int32_t>{int_value_segment, true}), expected_int_values);
+
+  EXPECT_EQ(iterate_values<std::string>(*string_value_segment), expected_string_values);
+  EXPECT_EQ(iterate_values<std::string>(DictionarySegment<std::string>{string_value_segment}), expected_string_values);
+  EXPECT_EQ(iterate_values<std::string>(FrontCodedDictionarySegment<std::string>{string_value_segment}),
+            expected_string_values);
+}
+
+TEST_F(StorageSegmentIterateTest, RandomAccess) {
+  // Jumping around checks that the run-length iterator finds the right run and that the frame-of-reference iterator
+  // decodes the right block.
+  const auto check_random_access = [&](const auto& segment) {
+    segment_with_iterators<int32_t>(segment, [&](const auto begin, const auto end) {
+      ASSERT_EQ(std::distance(begin, end), 5000);
+      EXPECT_EQ((begin + 4321)->value(), expected_int_values[4321]);
+      EXPECT_EQ((end - 1)->value(), expected_int_values[4999]);
+      EXPECT_EQ((*(begin + 2048)).value(), expected_int_values[2048]);
+
+      auto iterator = begin + 15;
+      --iterator;
+      EXPECT_EQ(iterator->value(), expected_int_values[14]);
+      EXPECT_EQ(iterator->chunk_offset(), 14u);
+      iterator -= 7;
+      EXPECT_EQ(iterator->value(), expected_int_values[7]);
+      --iterator;
+      EXPECT_EQ(iterator->value(), expected_int_values[6]);
+      EXPECT_TRUE(begin < iterator);
+    });
+  };
+
+  check_random_access(*int_value_segment);
+  check_random_access(DictionarySegment<int32_t>{int_value_segment});
+  check_random_access(RunLengthSegment<int32_t>{int_value_segment});
+  check_random_access(FrameOfReferenceSegment<int32_t>{int_value_segment, true});
+}
+
+TEST_F(StorageSegmentIterateTest, IterateReferenceSegment) {
+  // The referenced table has chunks with different encodings.
+  auto table = std::make_shared<Table>(10);
+  table->add_column("a", "int");
+  for (auto index = int32_t{0}; index < 40; ++index) {
+    table->append({index});
+  }
+  table->compress_chunk(ChunkID{0});
+  table->compress_chunk(ChunkID{1}, {SegmentEncodingSpec{EncodingType::RunLength}});
+  table->compress_chunk(ChunkID{2}, {SegmentEncodingSpec{EncodingType::FrameOfReference}});
+
+  const auto pos_list = std::make_shared<PosList>(
+      PosList{{ChunkID{3}, 1}, {ChunkID{0}, 5}, {ChunkID{2}, 9}, {ChunkID{1}, 0}, {ChunkID{0}, 6}, {ChunkID{3}, 1}});
+  const auto reference_segment = ReferenceSegment{table, ColumnID{0}, pos_list};
+  EXPECT_EQ(iterate_values<int32_t>(reference_segment), (std::vector<int32_t>{31, 5, 29, 10, 6, 31}));
+
+  // The referenced segments can also be read through accessors.
+  const auto accessor = create_segment_accessor<int32_t>(*table->get_chunk(ChunkID{1})->get_segment(ColumnID{0}));
+  EXPECT_EQ(accessor->access(3), 13);
+  EXPECT_THROW(create_segment_accessor<int32_t>(reference_segment), std::logic_error);
+}
+
+TEST_F(StorageSegmentIterateTest, IterateValueIDs) {
+  const auto dictionary_segment = FrontCodedDictionarySegment<std::string>{string_value_segment};
+  auto values = std::vector<std::string>{};
+  attribute_vector_with_iterators(*dictionary_segment.attribute_vector(), [&](auto iterator, const auto end) {
+    for (; iterator != end; ++iterator) {
+      values.push_back(dictionary_segment.value_of_value_id(iterator->value()));
+    }
+  });
+  EXPECT_EQ(values, expected_string_values);
+}
+
+TEST_F(StorageSegmentIterateTest, UnknownDataType) {
+  // resolve_segment_type only knows the segment types of the given data type.
+  EXPECT_THROW(iterate_values<int64_t>(*int_value_segment), std::logic_error);
+}
+
+}  // namespace opossum
@@ -0,0 +1,144 @@
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "../lib/storage/chunk.hpp"
+#include "../lib/storage/dictionary_segment.hpp"
+#include "../lib/storage/frame_of_reference_segment.hpp"
+#include "../lib/storage/front_coded_dictionary_segment.hpp"
+#include "../lib/storage/reference_segment.hpp"
+#include "../lib/storage/run_length_segment.hpp"
+#include "../lib/storage/segment_statistics.hpp"
+#include "../lib/storage/table.hpp"
+#include "../lib/storage/value_segment.hpp"
+
+namespace opossum {
+
+class StorageSegmentStatisticsTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    int_value_segment = std::make_shared<ValueSegment<int32_t>>();
+    for (const auto value : {17, 5, 42, 5, 23}) {
+      int_value_segment->append(value);
+    }
+  }
+
+  template <typename T>
+  void expect_min_max(const std::shared_ptr<const AbstractSegmentStatistics>& statistics, const T& minimum,
+                      const T& maximum) {
+    const auto min_max_statistics = std::dynamic_pointer_cast<const MinMaxStatistics<T>>(statistics);
+    ASSERT_TRUE(min_max_statistics);
+    EXPECT_EQ(min_max_statistics->minimum(), minimum);
+    EXPECT_EQ(min_max_statistics->maximum(), maximum);
+  }
+
+  std::shared_ptr<ValueSegment<int32_t>> int_value_segment = nullptr;
+};
+
+TEST_F(StorageSegmentStatisticsTest, MinMaxOfAllSegmentTypes) {
+  expect_min_max<int32_t>(create_segment_statistics(int_value_segment), 5, 42);
+  expect_min_max<int32_t>(create_segment_statistics(std::make_shared<DictionarySegment<int32_t>>(int_value_segment)),
+                          5, 42);
+  expect_min_max<int32_t>(create_segment_statistics(std::make_shared<RunLengthSegment<int32_t>>(int_value_segment)), 5,
+                          42);
+  expect_min_max<int32_t>(
+      create_segment_statistics(std::make_shared<FrameOfReferenceSegment<int32_t>>(int_value_segment)), 5, 42);
+
+  const auto string_value_segment = std::make_shared<ValueSegment<std::string>>();
+  for (const auto& value : {"pear", "apple", "quince", "banana"}) {
+    string_value_segment->append(value);
+  }
+  expect_min_max<std::string>(create_segment_statistics(string_value_segment), "apple", "quince");
+  expect_min_max<std::string>(
+      create_segment_statistics(std::make_shared<FrontCodedDictionarySegment<std::string>>(string_value_segment)),
+      "apple", "quince");
+  EXPECT_EQ(create_segment_statistics(string_value_segment)->row_count(), 4u);
+}
+
+TEST_F(StorageSegmentStatisticsTest, NoStatistics) {
+  EXPECT_FALSE(create_segment_statistics(std::make_shared<ValueSegment<int32_t>>()));
+
+  // NaN cannot be ordered, so the minimum and maximum are meaningless.
+  const auto float_value_segment = std::make_shared<ValueSegment<float>>();
+  float_value_segment->append(1.5f);
+  float_value_segment->append(std::nanf(""));
+  EXPECT_FALSE(create_segment_statistics(float_value_segment));
+
+  const auto table = std::make_shared<Table>();
+  table->add_column("a", "int");
+  table->append({1});
+  const auto pos_list = std::make_shared<PosList>(PosList{RowID{ChunkID{0}, 0}});
+  EXPECT_FALSE(create_segment_statistics(std::make_shared<ReferenceSegment>(table, ColumnID{0}, pos_list)));
+}
+
+TEST_F(StorageSegmentStatisticsTest, Classify) {
+  const auto statistics = create_segment_statistics(int_value_segment);
+
+  EXPECT_TRUE(statistics->can_prune(ScanType::OpEquals, 4));
+  EXPECT_TRUE(statistics->can_prune(ScanType::OpEquals, 43));
+  EXPECT_FALSE(statistics->can_prune(ScanType::OpEquals, 6));
+  EXPECT_TRUE(statistics->can_prune(ScanType::OpLessThan, 5));
+  EXPECT_FALSE(statistics->can_prune(ScanType::OpLessThanEquals, 5));
+  EXPECT_TRUE(statistics->can_prune(ScanType::OpGreaterThan, 42));
+  EXPECT_FALSE(statistics->can_prune(ScanType::OpGreaterThanEquals, 42));
+  EXPECT_FALSE(statistics->can_prune(ScanType::OpNotEquals, 5));
+
+  EXPECT_EQ(statistics->classify(ScanType::OpGreaterThanEquals, 5), RangeOutcome::AllRows);
+  EXPECT_EQ(statistics->classify(ScanType::OpNotEquals, 100), RangeOutcome::AllRows);
+  EXPECT_EQ(statistics->classify(ScanType::OpLessThan, 20), RangeOutcome::SomeRows);
+
+  // NaN is neither equal nor unequal to the minimum and maximum, so not even a constant segment can be classified.
+  const auto constant_segment = std::make_shared<ValueSegment<float>>();
+  constant_segment->append(2.5f);
+  constant_segment->append(2.5f);
+  const auto constant_statistics = create_segment_statistics(constant_segment);
+  EXPECT_EQ(constant_statistics->classify(ScanType::OpEquals, 2.5f), RangeOutcome::AllRows);
+  EXPECT_EQ(constant_statistics->classify(ScanType::OpNotEquals, 2.5f), RangeOutcome::NoRows);
+  EXPECT_EQ(constant_statistics->classify(ScanType::OpEquals, std::nanf("")), RangeOutcome::SomeRows);
+  EXPECT_EQ(constant_statistics->classify(ScanType::OpNotEquals, std::nanf("")), RangeOutcome::SomeRows);
+  EXPECT_FALSE(constant_statistics->can_prune(ScanType::OpNotEquals, std::nanf("")));
+
+  // The search value is converted to the column type, just like in the TableScan.
+  EXPECT_TRUE(statistics->can_prune(ScanType::OpGreaterThan, int64_t{42}));
+  EXPECT_FALSE(statistics->can_prune(ScanType::OpLessThan, std::string{"6"}));
+}
+
+TEST_F(StorageSegmentStatisticsTest, ChunkStatisticsFollowAppends) {
+  auto chunk = Chunk{};
+  chunk.add_segment(int_value_segment);
+  expect_min_max<int32_t>(chunk.get_statistics(ColumnID{0}), 5, 42);
+  EXPECT_TRUE(chunk.can_prune(ColumnID{0}, ScanType::OpGreaterThan, 50));
+
+  chunk.append({100});
+  expect_min_max<int32_t>(chunk.get_statistics(ColumnID{0}), 5, 100);
+  EXPECT_FALSE(chunk.can_prune(ColumnID{0}, ScanType::OpGreaterThan, 50));
+
+  // Replacing the segment invalidates the cached statistics, even if the size stays the same.
+  const auto other_segment = std::make_shared<ValueSegment<int32_t>>();
+  for (auto value = int32_t{0}; value < 6; ++value) {
+    other_segment->append(value);
+  }
+  chunk.insert_segment_at(other_segment, ColumnID{0});
+  expect_min_max<int32_t>(chunk.get_statistics(ColumnID{0}), 0, 5);
+}
+
+TEST_F(StorageSegmentStatisticsTest, CompressedChunkStatistics) {
+  const auto table = std::make_shared<Table>(3);
+  table->add_column("a", "int");
+  table->add_column("b", "string");
+  for (auto value = int32_t{0}; value < 6; ++value) {
+    table->append({value, std::to_string(value)});
+  }
+  table->compress_chunk(ChunkID{1});
+
+  const auto chunk = table->get_chunk(ChunkID{1});
+  expect_min_max<int32_t>(chunk->get_statistics(ColumnID{0}), 3, 5);
+  expect_min_max<std::string>(chunk->get_statistics(ColumnID{1}), "3", "5");
+  EXPECT_TRUE(chunk->can_prune(ColumnID{0}, ScanType::OpLessThan, 3));
+}
+
+}  // namespace opossum
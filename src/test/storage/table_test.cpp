@@ -8,7 +8,9 @@
 #include "gtest/gtest.h"
 
 #include "../lib/resolve_type.hpp"
+#include "../lib/storage/bit_packed_vector.hpp"
 #include "../lib/storage/dictionary_segment.hpp"
+#include "../lib/storage/run_length_segment.hpp"
 #include "../lib/storage/table.hpp"
 
 namespace opossum {
@@ -76,6 +78,35 @@ TEST_F(StorageTableTest, GetColumnIdByName) {
   EXPECT_THROW(table.column_id_by_name("no_column_name"), std::exception);
 }
 
+TEST_F(StorageTableTest, AddColumnDefinition) {
+  auto definitions = Table{};
+  definitions.add_column_definition("a", "long");
+  definitions.add_column_definition("b", "double");
+  EXPECT_EQ(definitions.column_count(), 2u);
+  EXPECT_EQ(definitions.column_name(ColumnID{1}), "b");
+  EXPECT_EQ(definitions.column_type(ColumnID{0}), "long");
+  // no segments are created.
+  EXPECT_EQ(definitions.get_chunk(ChunkID{0})->column_count(), 0u);
+}
+
+TEST_F(StorageTableTest, ColumnMinMax) {
+  EXPECT_EQ(table.column_min_max(ColumnID{0}), std::nullopt);
+
+  table.append({4, "Hello"});
+  table.append({9, "world"});
+  table.append({-3, "!"});
+  table.compress_chunk(ChunkID{0});
+  const auto min_max = table.column_min_max(ColumnID{0});
+  ASSERT_TRUE(min_max);
+  EXPECT_EQ(type_cast<int32_t>(min_max->first), -3);
+  EXPECT_EQ(type_cast<int32_t>(min_max->second), 9);
+  EXPECT_EQ(table.column_min_max(ColumnID{1}), (std::pair{AllTypeVariant{"!"}, AllTypeVariant{"world"}}));
+
+  // the statistics of the last chunk follow its appends.
+  table.append({11, "a"});
+  EXPECT_EQ(type_cast<int32_t>(table.column_min_max(ColumnID{0})->second), 11);
+}
+
 TEST_F(StorageTableTest, GetChunkSize) { EXPECT_EQ(table.target_chunk_size(), 2u); }
 
 TEST_F(StorageTableTest, CompressChunk) {
@@ -109,4 +140,26 @@ TEST_F(StorageTableTest, CompressChunk) {
   EXPECT_EQ(table.chunk_count(), 2u);
 }
 
+TEST_F(StorageTableTest, CompressChunkWithEncodingSpec) {
+  table.append({4, "Hello"});
+  table.append({6, "Hello"});
+
+  EXPECT_THROW(table.compress_chunk(ChunkID{0}, {SegmentEncodingSpec{}}), std::logic_error);
+
+  table.compress_chunk(ChunkID{0}, {SegmentEncodingSpec{EncodingType::Dictionary, VectorCompressionType::BitPacking},
+                                    SegmentEncodingSpec{EncodingType::RunLength}});
+
+  const auto encoded_chunk = table.get_chunk(ChunkID{0});
+  const auto dict_segment =
+      std::dynamic_pointer_cast<DictionarySegment<int32_t>>(encoded_chunk->get_segment(ColumnID{0}));
+  ASSERT_TRUE(dict_segment);
+  EXPECT_TRUE(std::dynamic_pointer_cast<const BitPackedVector>(dict_segment->attribute_vector()));
+
+  const auto run_length_segment =
+      std::dynamic_pointer_cast<RunLengthSegment<std::string>>(encoded_chunk->get_segment(ColumnID{1}));
+  ASSERT_TRUE(run_length_segment);
+  EXPECT_EQ(run_length_segment->values(), (std::vector<std::string>{"Hello"}));
+  EXPECT_EQ(run_length_segment->size(), 2u);
+}
+
 }  // namespace opossum
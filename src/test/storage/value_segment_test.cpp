@@ -33,6 +33,12 @@ TEST_F(StorageValueSegmentTest, AddValueOfSameType) {
   EXPECT_EQ(double_value_segment.size(), 1u);
 }
 
+TEST_F(StorageValueSegmentTest, CreateFromValues) {
+  const auto segment = ValueSegment<std::string>{std::vector<std::string>{"a", "b", "c"}};
+  EXPECT_EQ(segment.size(), 3u);
+  EXPECT_EQ(segment.values()[1], "b");
+}
+
 TEST_F(StorageValueSegmentTest, AddValueOfDifferentType) {
   int_value_segment.append(3.14);
   EXPECT_EQ(int_value_segment.size(), 1u);